@@ -19,12 +19,28 @@
 #pragma once
 
 /* Includes ------------------------------------------------------------------*/
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 /* Exported types ------------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
+/**
+ * Maximum number of bytes of a variable length uint32_t, see
+ * BitConverter_putVarUint32()
+ */
+#define BitConverter_VARUINT32_MAX_SIZE 5
+/**
+ * Maximum number of bytes of a variable length uint64_t, see
+ * BitConverter_putVarUint64()
+ */
+#define BitConverter_VARUINT64_MAX_SIZE 9
 /* Exported macros -----------------------------------------------------------*/
-#define BitConverter_IS_BIG_ENDIAN() (*(uint16_t *)"\0\xff" < 0x100)
+#if defined(__BYTE_ORDER__)
+#   define BitConverter_IS_BIG_ENDIAN() (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#else
+#   define BitConverter_IS_BIG_ENDIAN() (*(uint16_t *)"\0\xff" < 0x100)
+#endif
 
 /* Exported functions ------------------------------------------------------- */
 /**
@@ -117,8 +133,659 @@ BitConverter_getUint16BE(const void* mem);
  */
 uint16_t
 BitConverter_getUint16LE(const void* mem);
+/**
+ * @brief puts the \b n elements of \b src with variable length in \b mem, which
+ * must hold at least \b n * BitConverter_VARUINT64_MAX_SIZE bytes, and returns
+ * the number of bytes written
+ */
+size_t
+BitConverter_putVarUint64Array(
+    const uint64_t* src,
+    size_t n,
+    void* mem
+);
+/**
+ * @brief gets \b n variable length uint64_t from the \b len bytes at \b mem into
+ * \b dst, and returns the number of bytes read, or 0 if \b mem is truncated
+ */
+size_t
+BitConverter_getVarUint64Array(
+    const void* mem,
+    size_t len,
+    uint64_t* dst,
+    size_t n
+);
+/**
+ * @brief puts the \b n elements of \b src with variable length in \b mem, which
+ * must hold at least \b n * BitConverter_VARUINT32_MAX_SIZE bytes, and returns
+ * the number of bytes written
+ */
+size_t
+BitConverter_putVarUint32Array(
+    const uint32_t* src,
+    size_t n,
+    void* mem
+);
+/**
+ * @brief gets \b n variable length uint32_t from the \b len bytes at \b mem into
+ * \b dst, and returns the number of bytes read, or 0 if \b mem is truncated or
+ * a value does not fit
+ */
+size_t
+BitConverter_getVarUint32Array(
+    const void* mem,
+    size_t len,
+    uint32_t* dst,
+    size_t n
+);
+/**
+ * @brief puts the bytes of the \b n uint64_t elements of \b src in \b dst in
+ * a Big Endian order. \b src and \b dst may be the same buffer, but must not
+ * overlap otherwise
+ */
+void
+BitConverter_putUint64ArrayBE(
+    const uint64_t* src,
+    void* dst,
+    size_t n
+);
+/**
+ * @brief puts the bytes of the \b n uint64_t elements of \b src in \b dst in
+ * a Little Endian order. \b src and \b dst may be the same buffer, but must not
+ * overlap otherwise
+ */
+void
+BitConverter_putUint64ArrayLE(
+    const uint64_t* src,
+    void* dst,
+    size_t n
+);
+/**
+ * @brief gets \b n uint64_t elements from the bytes placed in Big Endian
+ * order at \b src into \b dst. \b src and \b dst may be the same buffer, but
+ * must not overlap otherwise
+ */
+void
+BitConverter_getUint64ArrayBE(
+    const void* src,
+    uint64_t* dst,
+    size_t n
+);
+/**
+ * @brief gets \b n uint64_t elements from the bytes placed in Little Endian
+ * order at \b src into \b dst. \b src and \b dst may be the same buffer, but
+ * must not overlap otherwise
+ */
+void
+BitConverter_getUint64ArrayLE(
+    const void* src,
+    uint64_t* dst,
+    size_t n
+);
+/**
+ * @brief puts the bytes of the \b n uint32_t elements of \b src in \b dst in
+ * a Big Endian order. \b src and \b dst may be the same buffer, but must not
+ * overlap otherwise
+ */
+void
+BitConverter_putUint32ArrayBE(
+    const uint32_t* src,
+    void* dst,
+    size_t n
+);
+/**
+ * @brief puts the bytes of the \b n uint32_t elements of \b src in \b dst in
+ * a Little Endian order. \b src and \b dst may be the same buffer, but must not
+ * overlap otherwise
+ */
+void
+BitConverter_putUint32ArrayLE(
+    const uint32_t* src,
+    void* dst,
+    size_t n
+);
+/**
+ * @brief gets \b n uint32_t elements from the bytes placed in Big Endian
+ * order at \b src into \b dst. \b src and \b dst may be the same buffer, but
+ * must not overlap otherwise
+ */
+void
+BitConverter_getUint32ArrayBE(
+    const void* src,
+    uint32_t* dst,
+    size_t n
+);
+/**
+ * @brief gets \b n uint32_t elements from the bytes placed in Little Endian
+ * order at \b src into \b dst. \b src and \b dst may be the same buffer, but
+ * must not overlap otherwise
+ */
+void
+BitConverter_getUint32ArrayLE(
+    const void* src,
+    uint32_t* dst,
+    size_t n
+);
+/**
+ * @brief puts the bytes of the \b n uint16_t elements of \b src in \b dst in
+ * a Big Endian order. \b src and \b dst may be the same buffer, but must not
+ * overlap otherwise
+ */
+void
+BitConverter_putUint16ArrayBE(
+    const uint16_t* src,
+    void* dst,
+    size_t n
+);
+/**
+ * @brief puts the bytes of the \b n uint16_t elements of \b src in \b dst in
+ * a Little Endian order. \b src and \b dst may be the same buffer, but must not
+ * overlap otherwise
+ */
+void
+BitConverter_putUint16ArrayLE(
+    const uint16_t* src,
+    void* dst,
+    size_t n
+);
+/**
+ * @brief gets \b n uint16_t elements from the bytes placed in Big Endian
+ * order at \b src into \b dst. \b src and \b dst may be the same buffer, but
+ * must not overlap otherwise
+ */
+void
+BitConverter_getUint16ArrayBE(
+    const void* src,
+    uint16_t* dst,
+    size_t n
+);
+/**
+ * @brief gets \b n uint16_t elements from the bytes placed in Little Endian
+ * order at \b src into \b dst. \b src and \b dst may be the same buffer, but
+ * must not overlap otherwise
+ */
+void
+BitConverter_getUint16ArrayLE(
+    const void* src,
+    uint16_t* dst,
+    size_t n
+);
+
+
+// static inline byte order Functions -----------------------------------------
+
+/*
+ * The functions above are also available as static inline functions, with the
+ * suffix Inline. The host order is known at compile time, so they compile to a
+ * plain load or store, plus a byte swap for the foreign order. Unless
+ * BitConverter_Config_NO_INLINE is defined, calls to the functions above are
+ * mapped to them; the functions above are still exported, e.g. to take their
+ * address.
+ */
+
+/**
+ * @brief inline variant of BitConverter_putUint64BE()
+ */
+static inline void
+BitConverter_putUint64BEInline(
+    uint64_t arg,
+    void* mem
+)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        arg = __builtin_bswap64(arg);
+    }
+    memcpy(mem, &arg, sizeof(arg));
+}
+/**
+ * @brief inline variant of BitConverter_getUint64BE()
+ */
+static inline uint64_t
+BitConverter_getUint64BEInline(const void* mem)
+{
+    uint64_t retval;
 
+    memcpy(&retval, mem, sizeof(retval));
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        retval = __builtin_bswap64(retval);
+    }
+    return retval;
+}
+/**
+ * @brief inline variant of BitConverter_putUint64LE()
+ */
+static inline void
+BitConverter_putUint64LEInline(
+    uint64_t arg,
+    void* mem
+)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        arg = __builtin_bswap64(arg);
+    }
+    memcpy(mem, &arg, sizeof(arg));
+}
+/**
+ * @brief inline variant of BitConverter_getUint64LE()
+ */
+static inline uint64_t
+BitConverter_getUint64LEInline(const void* mem)
+{
+    uint64_t retval;
 
+    memcpy(&retval, mem, sizeof(retval));
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        retval = __builtin_bswap64(retval);
+    }
+    return retval;
+}
+/**
+ * @brief inline variant of BitConverter_putUint32BE()
+ */
+static inline void
+BitConverter_putUint32BEInline(
+    uint32_t arg,
+    void* mem
+)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        arg = __builtin_bswap32(arg);
+    }
+    memcpy(mem, &arg, sizeof(arg));
+}
+/**
+ * @brief inline variant of BitConverter_getUint32BE()
+ */
+static inline uint32_t
+BitConverter_getUint32BEInline(const void* mem)
+{
+    uint32_t retval;
+
+    memcpy(&retval, mem, sizeof(retval));
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        retval = __builtin_bswap32(retval);
+    }
+    return retval;
+}
+/**
+ * @brief inline variant of BitConverter_putUint32LE()
+ */
+static inline void
+BitConverter_putUint32LEInline(
+    uint32_t arg,
+    void* mem
+)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        arg = __builtin_bswap32(arg);
+    }
+    memcpy(mem, &arg, sizeof(arg));
+}
+/**
+ * @brief inline variant of BitConverter_getUint32LE()
+ */
+static inline uint32_t
+BitConverter_getUint32LEInline(const void* mem)
+{
+    uint32_t retval;
+
+    memcpy(&retval, mem, sizeof(retval));
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        retval = __builtin_bswap32(retval);
+    }
+    return retval;
+}
+/**
+ * @brief inline variant of BitConverter_putUint16BE()
+ */
+static inline void
+BitConverter_putUint16BEInline(
+    uint16_t arg,
+    void* mem
+)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        arg = __builtin_bswap16(arg);
+    }
+    memcpy(mem, &arg, sizeof(arg));
+}
+/**
+ * @brief inline variant of BitConverter_getUint16BE()
+ */
+static inline uint16_t
+BitConverter_getUint16BEInline(const void* mem)
+{
+    uint16_t retval;
+
+    memcpy(&retval, mem, sizeof(retval));
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        retval = __builtin_bswap16(retval);
+    }
+    return retval;
+}
+/**
+ * @brief inline variant of BitConverter_putUint16LE()
+ */
+static inline void
+BitConverter_putUint16LEInline(
+    uint16_t arg,
+    void* mem
+)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        arg = __builtin_bswap16(arg);
+    }
+    memcpy(mem, &arg, sizeof(arg));
+}
+/**
+ * @brief inline variant of BitConverter_getUint16LE()
+ */
+static inline uint16_t
+BitConverter_getUint16LEInline(const void* mem)
+{
+    uint16_t retval;
+
+    memcpy(&retval, mem, sizeof(retval));
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        retval = __builtin_bswap16(retval);
+    }
+    return retval;
+}
+
+#if !defined(BitConverter_Config_NO_INLINE)
+#   define BitConverter_putUint64BE(arg, mem) \
+    BitConverter_putUint64BEInline(arg, mem)
+#   define BitConverter_getUint64BE(mem) \
+    BitConverter_getUint64BEInline(mem)
+#   define BitConverter_putUint64LE(arg, mem) \
+    BitConverter_putUint64LEInline(arg, mem)
+#   define BitConverter_getUint64LE(mem) \
+    BitConverter_getUint64LEInline(mem)
+#   define BitConverter_putUint32BE(arg, mem) \
+    BitConverter_putUint32BEInline(arg, mem)
+#   define BitConverter_getUint32BE(mem) \
+    BitConverter_getUint32BEInline(mem)
+#   define BitConverter_putUint32LE(arg, mem) \
+    BitConverter_putUint32LEInline(arg, mem)
+#   define BitConverter_getUint32LE(mem) \
+    BitConverter_getUint32LEInline(mem)
+#   define BitConverter_putUint16BE(arg, mem) \
+    BitConverter_putUint16BEInline(arg, mem)
+#   define BitConverter_getUint16BE(mem) \
+    BitConverter_getUint16BEInline(mem)
+#   define BitConverter_putUint16LE(arg, mem) \
+    BitConverter_putUint16LEInline(arg, mem)
+#   define BitConverter_getUint16LE(mem) \
+    BitConverter_getUint16LEInline(mem)
+#endif
+
+// static inline variable length Functions ------------------------------------
+
+/*
+ * Variable length integers use 1 byte for values up to 7 bits, and one more
+ * byte for every further 7 bits, up to 9 bytes for a uint64_t. The number of
+ * leading one bits of the first byte is the number of bytes that follow, the
+ * other bits hold the value in Big Endian order. Hence the length is known
+ * from the first byte, without a loop over continuation bits. Signed values
+ * are zigzag encoded first, so small negative values stay short.
+ */
+
+/**
+ * @brief puts the \b n lowest bytes of \b arg in \b mem in a Big Endian order,
+ * \b n is between 1 and 8
+ */
+static inline void
+BitConverter_putUintNBE(
+    uint64_t arg,
+    size_t n,
+    void* mem
+)
+{
+    uint8_t* bytes = (uint8_t*) mem;
+
+    for (size_t i = n; i > 0; i--)
+    {
+        bytes[i - 1] = (uint8_t) arg;
+        arg >>= 8;
+    }
+}
+/**
+ * @brief gets the integer from the \b n bytes placed in Big Endian order at
+ * the memory location \b mem, \b n is between 1 and 8
+ */
+static inline uint64_t
+BitConverter_getUintNBE(
+    const void* mem,
+    size_t n
+)
+{
+    const uint8_t* bytes = (const uint8_t*) mem;
+    uint64_t retval = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        retval = (retval << 8) | bytes[i];
+    }
+    return retval;
+}
+/**
+ * @brief gets the number of bytes of the variable length encoding of \b arg
+ */
+static inline size_t
+BitConverter_getVarUint64Size(uint64_t arg)
+{
+    // Number of significant bits, at least one
+    const size_t bits = 64 - __builtin_clzll(arg | 1);
+
+    return (bits > 56) ? 9 : (bits + 6) / 7;
+}
+/**
+ * @brief gets the number of bytes of the variable length encoding of \b arg
+ */
+static inline size_t
+BitConverter_getVarUint32Size(uint32_t arg)
+{
+    return BitConverter_getVarUint64Size(arg);
+}
+/**
+ * @brief puts \b arg with variable length in \b mem, which must hold at least
+ * BitConverter_VARUINT64_MAX_SIZE bytes, and returns the number of bytes
+ * written
+ */
+static inline size_t
+BitConverter_putVarUint64(
+    uint64_t arg,
+    void* mem
+)
+{
+    uint8_t* bytes = (uint8_t*) mem;
+    const size_t n = BitConverter_getVarUint64Size(arg);
+
+    if (n > 8)
+    {
+        bytes[0] = 0xff;
+        BitConverter_putUint64BEInline(arg, bytes + 1);
+    }
+    else
+    {
+        BitConverter_putUintNBE(arg, n, bytes);
+        // The value leaves the top n bits free for the leading ones
+        bytes[0] |= (uint8_t) (0xff00 >> (n - 1));
+    }
+    return n;
+}
+/**
+ * @brief puts \b arg with variable length in \b mem, which must hold at least
+ * BitConverter_VARUINT32_MAX_SIZE bytes, and returns the number of bytes
+ * written
+ */
+static inline size_t
+BitConverter_putVarUint32(
+    uint32_t arg,
+    void* mem
+)
+{
+    return BitConverter_putVarUint64(arg, mem);
+}
+/**
+ * @brief gets the variable length uint64_t from the \b len bytes at \b mem into
+ * \b arg, and returns the number of bytes read, or 0 if \b mem is truncated
+ */
+static inline size_t
+BitConverter_getVarUint64(
+    const void* mem,
+    size_t len,
+    uint64_t* arg
+)
+{
+    const uint8_t* bytes = (const uint8_t*) mem;
+    size_t n;
+
+    if (len == 0)
+    {
+        return 0;
+    }
+    // Count the leading ones, the extra bit stops at 8 for a first byte 0xff
+    n = __builtin_clz(((~bytes[0] & 0xffu) << 24) | 0x800000u) + 1;
+    if (n > len)
+    {
+        return 0;
+    }
+    *arg = (n > 8) ? BitConverter_getUint64BEInline(bytes + 1) :
+           BitConverter_getUintNBE(bytes, n) & ((UINT64_C(1) << (7 * n)) - 1);
+    return n;
+}
+/**
+ * @brief gets the variable length uint32_t from the \b len bytes at \b mem into
+ * \b arg, and returns the number of bytes read, or 0 if \b mem is truncated or
+ * the value does not fit
+ */
+static inline size_t
+BitConverter_getVarUint32(
+    const void* mem,
+    size_t len,
+    uint32_t* arg
+)
+{
+    uint64_t value;
+    const size_t n = BitConverter_getVarUint64(mem, len, &value);
+
+    if (n == 0 || value > UINT32_MAX)
+    {
+        return 0;
+    }
+    *arg = (uint32_t) value;
+    return n;
+}
+/**
+ * @brief maps a int64_t to a uint64_t, so that values close to 0 map to small
+ * values: 0, -1, 1, -2, ... map to 0, 1, 2, 3, ...
+ */
+static inline uint64_t
+BitConverter_zigzagEncode64(int64_t arg)
+{
+    return ((uint64_t) arg << 1) ^ (0 - ((uint64_t) arg >> 63));
+}
+/**
+ * @brief the inverse of BitConverter_zigzagEncode64()
+ */
+static inline int64_t
+BitConverter_zigzagDecode64(uint64_t arg)
+{
+    return (int64_t) ((arg >> 1) ^ (0 - (arg & 1)));
+}
+/**
+ * @brief maps a int32_t to a uint32_t, see BitConverter_zigzagEncode64()
+ */
+static inline uint32_t
+BitConverter_zigzagEncode32(int32_t arg)
+{
+    return ((uint32_t) arg << 1) ^ (0 - ((uint32_t) arg >> 31));
+}
+/**
+ * @brief the inverse of BitConverter_zigzagEncode32()
+ */
+static inline int32_t
+BitConverter_zigzagDecode32(uint32_t arg)
+{
+    return (int32_t) ((arg >> 1) ^ (0 - (arg & 1)));
+}
+/**
+ * @brief puts the zigzag encoded \b arg with variable length in \b mem, see
+ * BitConverter_putVarUint64()
+ */
+static inline size_t
+BitConverter_putVarInt64(
+    int64_t arg,
+    void* mem
+)
+{
+    return BitConverter_putVarUint64(BitConverter_zigzagEncode64(arg), mem);
+}
+/**
+ * @brief puts the zigzag encoded \b arg with variable length in \b mem, see
+ * BitConverter_putVarUint32()
+ */
+static inline size_t
+BitConverter_putVarInt32(
+    int32_t arg,
+    void* mem
+)
+{
+    return BitConverter_putVarUint32(BitConverter_zigzagEncode32(arg), mem);
+}
+/**
+ * @brief gets the variable length, zigzag encoded int64_t at \b mem, see
+ * BitConverter_getVarUint64(); \b arg is left unchanged on failure
+ */
+static inline size_t
+BitConverter_getVarInt64(
+    const void* mem,
+    size_t len,
+    int64_t* arg
+)
+{
+    uint64_t value;
+    const size_t n = BitConverter_getVarUint64(mem, len, &value);
+
+    if (n != 0)
+    {
+        *arg = BitConverter_zigzagDecode64(value);
+    }
+    return n;
+}
+/**
+ * @brief gets the variable length, zigzag encoded int32_t at \b mem, see
+ * BitConverter_getVarUint32(); \b arg is left unchanged on failure
+ */
+static inline size_t
+BitConverter_getVarInt32(
+    const void* mem,
+    size_t len,
+    int32_t* arg
+)
+{
+    uint32_t value;
+    const size_t n = BitConverter_getVarUint32(mem, len, &value);
+
+    if (n != 0)
+    {
+        *arg = BitConverter_zigzagDecode32(value);
+    }
+    return n;
+}
 
 // static inline Functions ------------------------------------------------------------
 
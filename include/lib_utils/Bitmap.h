@@ -18,10 +18,23 @@
 #ifndef BITMAP_H
 #define BITMAP_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /* Includes ------------------------------------------------------------------*/
 /* Exported types ------------------------------------------------------------*/
+
+/**
+ * Bitmap of any number of bits, stored in an array of uint64_t provided by the
+ * user. Bit b is bit (b % 64) of word (b / 64). The members are private.
+ */
+typedef struct
+{
+    uint64_t*   words;      ///< BitmapN_WORDS(numBits) words of storage
+    size_t      numBits;    ///< number of bits of the bitmap
+} BitmapN;
+
 /* Exported constants --------------------------------------------------------*/
 
 typedef uint64_t volatile  Bitmap64;
@@ -32,7 +45,7 @@ typedef int      volatile  BitmapInt;
 
 #define Bitmap_ALL_SET_MASK             0xFFFFFFFFFFFFFFFF  //8 byte FF
 
-#define Bitmap_MASK_OF_BIT(b)           (1 << (b))
+#define Bitmap_MASK_OF_BIT(b)           ((uint64_t) 1 << (b))
 
 #define Bitmap_GET_BIT(arg, bitNum)     ((arg) & Bitmap_MASK_OF_BIT(bitNum))
 #define Bitmap_SET_BIT(arg, bitNum)     ((arg) |=  Bitmap_MASK_OF_BIT(bitNum))
@@ -55,8 +68,158 @@ typedef int      volatile  BitmapInt;
 
 
 /* Exported macro ------------------------------------------------------------*/
+
+#define BitmapN_BITS_PER_WORD           64
+/** Number of words to store a BitmapN of numBits bits */
+#define BitmapN_WORDS(numBits) \
+    (((numBits) + BitmapN_BITS_PER_WORD - 1) / BitmapN_BITS_PER_WORD)
+/** Returned by the search functions if there is no such bit */
+#define BitmapN_NOT_FOUND               ((size_t) -1)
+
 /* Exported functions ------------------------------------------------------- */
 
+/**
+ * @brief constructor, all the bits are cleared
+ *
+ * @param self pointer to the bitmap
+ * @param words storage of at least BitmapN_WORDS(numBits) words
+ * @param numBits number of bits
+ *
+ * @retval true the bitmap has been constructed
+ * @retval false words is NULL or numBits is 0
+ */
+bool
+BitmapN_ctor(BitmapN* self, uint64_t* words, size_t numBits);
+
+/**
+ * @brief destructor, the storage still belongs to the user
+ */
+void
+BitmapN_dtor(BitmapN* self);
+
+/**
+ * @brief gets the number of bits of the bitmap
+ */
+static inline size_t
+BitmapN_getSize(BitmapN const* self)
+{
+    return self->numBits;
+}
+
+/**
+ * @brief gets the given bit, it is an error to pass a bit out of the bitmap
+ */
+static inline bool
+BitmapN_getBit(BitmapN const* self, size_t bit)
+{
+    return (self->words[bit / BitmapN_BITS_PER_WORD]
+            & Bitmap_MASK_OF_BIT(bit % BitmapN_BITS_PER_WORD)) != 0;
+}
+
+/**
+ * @brief sets the given bit, it is an error to pass a bit out of the bitmap
+ */
+static inline void
+BitmapN_setBit(BitmapN* self, size_t bit)
+{
+    self->words[bit / BitmapN_BITS_PER_WORD]
+        |= Bitmap_MASK_OF_BIT(bit % BitmapN_BITS_PER_WORD);
+}
+
+/**
+ * @brief clears the given bit, it is an error to pass a bit out of the bitmap
+ */
+static inline void
+BitmapN_clearBit(BitmapN* self, size_t bit)
+{
+    self->words[bit / BitmapN_BITS_PER_WORD]
+        &= ~Bitmap_MASK_OF_BIT(bit % BitmapN_BITS_PER_WORD);
+}
+
+/**
+ * @brief finds the first set bit at or after a given bit, a word at a time
+ *
+ * @param self pointer to the bitmap
+ * @param from bit to start the search from
+ *
+ * @return the index of the bit, or BitmapN_NOT_FOUND if no bit from \b from
+ *  on is set
+ */
+size_t
+BitmapN_findFirstSet(BitmapN const* self, size_t from);
+
+/**
+ * @brief finds the first clear bit at or after a given bit, a word at a time
+ *
+ * @param self pointer to the bitmap
+ * @param from bit to start the search from
+ *
+ * @return the index of the bit, or BitmapN_NOT_FOUND if all the bits from
+ *  \b from on are set
+ */
+size_t
+BitmapN_findFirstClear(BitmapN const* self, size_t from);
+
+/**
+ * @brief counts the set bits
+ */
+size_t
+BitmapN_countSet(BitmapN const* self);
+
+/**
+ * @brief sets \b count bits starting at \b first, the range has to be in the
+ * bitmap
+ */
+void
+BitmapN_setRange(BitmapN* self, size_t first, size_t count);
+
+/**
+ * @brief clears \b count bits starting at \b first, the range has to be in
+ * the bitmap
+ */
+void
+BitmapN_clearRange(BitmapN* self, size_t first, size_t count);
+
+/*
+ * The following functions are atomic, i.e. several threads or cores can use
+ * them on the same bitmap without a lock, e.g. to allocate ids. They must not
+ * be mixed with the non atomic functions above while other threads access the
+ * bitmap. They have acquire/release semantics, so the data of a claimed slot
+ * is visible to the thread which claims it after it has been released.
+ */
+
+/**
+ * @brief atomically sets the given bit
+ *
+ * @return the value of the bit before it was set
+ */
+bool
+BitmapN_testAndSet(BitmapN* self, size_t bit);
+
+/**
+ * @brief atomically clears the given bit
+ *
+ * @return the value of the bit before it was cleared
+ */
+bool
+BitmapN_testAndClear(BitmapN* self, size_t bit);
+
+/**
+ * @brief atomically finds a clear bit and sets it
+ *
+ * The words are scanned from the one holding \b from, a clear bit found in a
+ * word is claimed with a compare and swap of the whole word. If another thread
+ * changes the word in between, the search goes on with its new value.
+ *
+ * @param self pointer to the bitmap
+ * @param from bit to start the search from
+ *
+ * @return the index of the bit that has been set, or BitmapN_NOT_FOUND if all
+ *  the bits from \b from on are set
+ */
+size_t
+BitmapN_claimFirstClear(BitmapN* self, size_t from);
+
 #endif /* BITMAP_H */
 
 ///@}
@@ -32,6 +32,14 @@ typedef
 FifoT_TYPE(char, size_t)
 CharFifo;
 
+typedef
+FifoT_SPSC_TYPE(char, size_t)
+CharSpscFifo;
+
+typedef
+FifoT_MPSC_TYPE(char, size_t)
+CharMpscFifo;
+
 /* Exported constants --------------------------------------------------------*/
 
 /* Exported macro ------------------------------------------------------------*/
@@ -46,6 +54,16 @@ CharFifo_getAndPop(CharFifo* self);
 bool
 CharFifo_forcedPush(CharFifo* self, char const* c);
 
+FifoT_SPSC_DECLARE(char, CharSpscFifo, size_t);
+
+char
+CharSpscFifo_getAndPop(CharSpscFifo* self);
+
+FifoT_MPSC_DECLARE(char, CharMpscFifo, size_t);
+
+char
+CharMpscFifo_getAndPop(CharMpscFifo* self);
+
 #endif /* <HEADER_UNIQUE_SYMBOL_H> */
 
 ///@}
@@ -21,6 +21,8 @@
 #include "lib_debug/Debug.h"
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 
 
 /**
@@ -40,7 +42,48 @@
  * The latter is the object destructor and has the responsibility to free the
  * resources associated to the object (but not the memory used by the object
  * instance).
+ *
+ * If T can be copied with memcpy() and T_dtor() does nothing, then the fifo
+ * can be defined with FifoT_DEFINE_TRIVIAL() instead of FifoT_DEFINE(). The
+ * interface is the same, but the bulk operations (#pushMany(), #popMany())
+ * reduce to at most two memcpy() calls and #dropFirst() and #clear() take
+ * constant time.
+ *
+ * If the capacity is always a power of two, FifoT_DEFINE_POW2() and
+ * FifoT_DEFINE_POW2_TRIVIAL() compute the positions in the buffer with a mask
+ * instead of keeping them in range with a compare.
+ *
+ * If LIB_UTILS_STATS is defined, every fifo defined with FifoT_DEFINE() and
+ * its flavours keeps the counters of a FifoT_Stats, see #getStats(). The
+ * lock-free flavours do not keep any. Otherwise neither the counters nor the
+ * code to update them are compiled in.
+ */
+
+#if defined(LIB_UTILS_STATS)
+/**
+ * Counters of a fifo, they are reset by the constructor only.
  */
+typedef struct
+{
+    size_t highWaterMark;   ///< the largest size the fifo has ever had
+    size_t rejected;        ///< the items not pushed because the fifo was full
+    size_t dropped;         ///< the elements lost by the overwriting pushes
+}
+FifoT_Stats;
+
+#   define FifoT_STATS_FIELD_       FifoT_Stats stats;
+#   define FifoT_STATS_(stmt__)     do { stmt__; } while (0)
+#else
+#   define FifoT_STATS_FIELD_
+#   define FifoT_STATS_(stmt__)     ((void) 0)
+#endif
+
+#define FifoT_STATS_HIGH_WATER_(self__, size__)                             \
+    FifoT_STATS_(                                                           \
+        if ((size__) > (self__)->stats.highWaterMark)                       \
+        {                                                                   \
+            (self__)->stats.highWaterMark = (size__);                       \
+        })
 
 #define FifoT_TYPE(T__, SIZE_T__)                                           \
 struct {                                                                    \
@@ -50,6 +93,30 @@ struct {                                                                    \
     volatile SIZE_T__ in;                                                   \
     volatile SIZE_T__ out;                                                  \
     volatile SIZE_T__ capacity;                                             \
+    FifoT_STATS_FIELD_                                                      \
+}
+
+/**
+ * Fixed capacity FIFO type. The elements are stored in an array of CAP__
+ * elements embedded in the fifo itself, so no buffer is passed to the
+ * constructor and the capacity is a compile time constant, this lets the
+ * compiler fold the wrap around of the positions. If CAP__ is a power of two,
+ * the positions are computed with a mask as FifoT_DEFINE_POW2() does.
+ *
+ * The fifo must be declared with FifoT_DECLARE_FIXED() and defined with
+ * FifoT_DEFINE_FIXED() or FifoT_DEFINE_FIXED_TRIVIAL(), the interface is the
+ * one of FifoT except for the constructor. A fifo in static storage is zero
+ * initialized, which is a valid empty fifo, and can be used without calling
+ * the constructor.
+ */
+#define FifoT_TYPE_FIXED(T__, SIZE_T__, CAP__)                              \
+struct {                                                                    \
+    volatile SIZE_T__ first;                                                \
+    volatile SIZE_T__ last;                                                 \
+    volatile SIZE_T__ in;                                                   \
+    volatile SIZE_T__ out;                                                  \
+    FifoT_STATS_FIELD_                                                      \
+    T__ fifo[CAP__];                                                        \
 }
 
 /**
@@ -71,6 +138,17 @@ struct {                                                                    \
 #define FifoT_CTOR_DECL(T__, N__, SIZE_T__)                                 \
     bool N__##_ctor(N__* self, void* buffer, SIZE_T__ capacity)
 
+/**
+ * Constructor of the fixed capacity fifos, it initializes an empty fifo.
+ *
+ * @param self a pointer to the container itself.
+ *
+ * @memberof FifoT
+ */
+
+#define FifoT_CTOR_FIXED_DECL(T__, N__)                                     \
+    void N__##_ctor(N__* self)
+
 /**
  * Destructor. Releases all the resources allocated by the fifo. Referenced
  * strings are free'd too.
@@ -214,8 +292,139 @@ SIZE_T__                                                                    \
 N__##_constApply(N__ const* self, N__##_applyFn fn, void* context)
 
 
-#define FifoT_DECLARE(T__, N__, SIZE_T__)                                   \
-         FifoT_CTOR_DECL(T__, N__, SIZE_T__);                               \
+/**
+ * Pushes up to ''n'' items into the fifo.
+ * The items are copied into the fifo, as #push() does for a single item.
+ *
+ * @param self a pointer to the fifo itself.
+ * @param src a pointer to the array of items to push, the item at ''src[0]''
+ *            is pushed first.
+ * @param n the number of items in ''src''.
+ *
+ * @return the number of items actually pushed, this is less than ''n'' if
+ *         the fifo runs full.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_PUSH_MANY_DECL(T__, N__, SIZE_T__)                            \
+SIZE_T__ N__##_pushMany(N__* self, T__ const* src, SIZE_T__ n)
+
+/**
+ * Pops up to ''n'' items from the fifo.
+ * The items are copied into ''dst'' starting from the first one and then
+ * destroyed in the fifo, as a sequence of #getFirst() and #pop() does.
+ *
+ * @param self a pointer to the fifo itself.
+ * @param dst a pointer to the memory receiving the items, it must be able to
+ *            hold at least ''n'' items.
+ * @param n the maximum number of items to pop.
+ *
+ * @return the number of items actually popped, this is less than ''n'' if
+ *         the fifo runs empty.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_POP_MANY_DECL(T__, N__, SIZE_T__)                             \
+SIZE_T__ N__##_popMany(N__* self, T__* dst, SIZE_T__ n)
+
+/**
+ * Retrieves the content of the fifo as (up to) two contiguous memory regions
+ * without copying it. The first span starts with the first element of the
+ * fifo, the second span (if any) continues at the beginning of the fifo
+ * memory buffer.
+ *
+ * @note that the spans are just references to the elements, they are no
+ *       longer valid once these are popped or the fifo object is destroyed.
+ *
+ * @param self a pointer to the container itself.
+ * @param spans the two spans to fill. Unused spans have ''len'' set to 0 and
+ *              ''ptr'' set to NULL.
+ * @return the number of non empty spans, i.e. 0 if the fifo is empty, 1 if
+ *         its content is contiguous or 2 if it wraps around.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_PEEK_SPANS_DECL(T__, N__, SIZE_T__)                           \
+typedef struct {                                                            \
+    T__ const* ptr;                                                         \
+    SIZE_T__ len;                                                           \
+} N__##_Span;                                                               \
+SIZE_T__ N__##_peekSpans(N__ const* self, N__##_Span spans[2])
+
+/**
+ * Removes up to ''n'' elements from the beginning of the fifo. The elements
+ * are destroyed as #pop() does, if T's destructor does nothing (fifo defined
+ * with one of the _TRIVIAL flavours) this takes constant time.
+ *
+ * @param self a pointer to the container itself.
+ * @param n the maximum number of elements to remove.
+ *
+ * @return the number of elements actually removed, this is less than ''n''
+ *         if the fifo runs empty.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_DROP_FIRST_DECL(T__, N__, SIZE_T__)                           \
+SIZE_T__ N__##_dropFirst(N__* self, SIZE_T__ n)
+
+/**
+ * Pushes an item into the fifo, if the fifo is full the first element is
+ * dropped to make room for it, i.e. the fifo keeps the most recent items.
+ *
+ * @param self a pointer to the fifo itself.
+ * @param item a pointer to the item to push.
+ *
+ * @return true if an element has been dropped, false otherwise.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_PUSH_OVERWRITE_DECL(T__, N__)                                 \
+bool N__##_pushOverwrite(N__* self, T__ const* item)
+
+/**
+ * Pushes ''n'' items into the fifo, dropping as many of the first elements
+ * as needed to make room for them. If ''n'' exceeds the capacity, only the
+ * last items of ''src'' are pushed and the fifo is full afterwards.
+ *
+ * @param self a pointer to the fifo itself.
+ * @param src a pointer to the array of items to push, the item at ''src[0]''
+ *            is pushed first.
+ * @param n the number of items in ''src''.
+ *
+ * @return the number of items lost, i.e. the elements dropped from the fifo
+ *         plus the items of ''src'' that have not been pushed.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_PUSH_MANY_OVERWRITE_DECL(T__, N__, SIZE_T__)                  \
+SIZE_T__ N__##_pushManyOverwrite(N__* self, T__ const* src, SIZE_T__ n)
+
+/**
+ * Retrieves the counters of the fifo, available only if LIB_UTILS_STATS is
+ * defined.
+ *
+ * @param self a pointer to the fifo itself.
+ *
+ * @return a copy of the counters.
+ *
+ * @memberof FifoT
+ */
+#if defined(LIB_UTILS_STATS)
+#   define FifoT_GETSTATS_DECL_(T__, N__)                                   \
+    FifoT_Stats N__##_getStats(N__ const* self);
+#   define FifoT_GETSTATS_IMPL_(T__, N__)                                   \
+    FifoT_Stats                                                             \
+    N__##_getStats(N__ const* self)                                         \
+    {                                                                       \
+        return self->stats;                                                 \
+    }
+#else
+#   define FifoT_GETSTATS_DECL_(T__, N__)
+#   define FifoT_GETSTATS_IMPL_(T__, N__)
+#endif
+
+
+#define FifoT_DECLARE_COMMON_(T__, N__, SIZE_T__)                           \
          FifoT_DTOR_DECL(T__, N__);                                         \
          FifoT_ISEMPTY_DECL(T__, N__);                                      \
          FifoT_ISFULL_DECL(T__, N__);                                       \
@@ -225,14 +434,100 @@ N__##_constApply(N__ const* self, N__##_applyFn fn, void* context)
          FifoT_POP_DECL(T__, N__);                                          \
          FifoT_GETFIRST_DECL(T__, N__);                                     \
          FifoT_CLEAR_DECL(T__, N__);                                        \
+         FifoT_PUSH_MANY_DECL(T__, N__, SIZE_T__);                          \
+         FifoT_POP_MANY_DECL(T__, N__, SIZE_T__);                           \
+         FifoT_PEEK_SPANS_DECL(T__, N__, SIZE_T__);                         \
          FifoT_CONST_APPLY_DECL(T__, N__, SIZE_T__)
 
+#define FifoT_DECLARE_METHODS_(T__, N__, SIZE_T__)                          \
+         FifoT_DECLARE_COMMON_(T__, N__, SIZE_T__);                         \
+         FifoT_GETSTATS_DECL_(T__, N__)                                     \
+         FifoT_DROP_FIRST_DECL(T__, N__, SIZE_T__);                         \
+         FifoT_PUSH_OVERWRITE_DECL(T__, N__);                               \
+         FifoT_PUSH_MANY_OVERWRITE_DECL(T__, N__, SIZE_T__)
+
+#define FifoT_DECLARE(T__, N__, SIZE_T__)                                   \
+         FifoT_CTOR_DECL(T__, N__, SIZE_T__);                               \
+         FifoT_DECLARE_METHODS_(T__, N__, SIZE_T__)
+
+#define FifoT_DECLARE_FIXED(T__, N__, SIZE_T__)                             \
+         FifoT_CTOR_FIXED_DECL(T__, N__);                                   \
+         FifoT_DECLARE_METHODS_(T__, N__, SIZE_T__)
+
 
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::: Implementation :::
 // :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
 
-#define FifoT_CTOR_IMPL(T__,N__, SIZE_T__)                                  \
+// Index policies. FifoT_IDX_ keeps the positions ''first'' and ''last'' in the
+// range [0, capacity) and wraps them with a compare, FifoT_IDX_POW2_ derives
+// the positions from the free running counters ''in'' and ''out'' with a mask
+// and thus requires the capacity to be a power of two. Neither of them needs
+// a division. WRAP() maps a position in the range [0, 2 * capacity). BUF()
+// and CAP() are the buffer and the capacity of the fifo.
+
+#define FifoT_IDX_IS_VALID_CAPACITY(capacity__)   true
+#define FifoT_IDX_BUF(self__)                     ((self__)->fifo)
+#define FifoT_IDX_CAP(self__)                     ((self__)->capacity)
+#define FifoT_IDX_FIRST(self__)                   ((self__)->first)
+#define FifoT_IDX_LAST(self__)                    ((self__)->last)
+#define FifoT_IDX_WRAP(self__, pos__)                                       \
+    (((pos__) >= (self__)->capacity) ? (pos__) - (self__)->capacity         \
+                                     : (pos__))
+#define FifoT_IDX_ADVANCE_FIRST(self__, n__)                                \
+    ((self__)->first = FifoT_IDX_WRAP(self__, (self__)->first + (n__)))
+#define FifoT_IDX_ADVANCE_LAST(self__, n__)                                 \
+    ((self__)->last = FifoT_IDX_WRAP(self__, (self__)->last + (n__)))
+
+#define FifoT_IDX_POW2_IS_VALID_CAPACITY(capacity__)                        \
+    ((capacity__) != 0 && ((capacity__) & ((capacity__) - 1)) == 0)
+#define FifoT_IDX_POW2_FIRST(self__)                                        \
+    ((self__)->out & ((self__)->capacity - 1))
+#define FifoT_IDX_POW2_LAST(self__)                                         \
+    ((self__)->in & ((self__)->capacity - 1))
+#define FifoT_IDX_POW2_WRAP(self__, pos__)                                  \
+    ((pos__) & ((self__)->capacity - 1))
+#define FifoT_IDX_POW2_ADVANCE_FIRST(self__, n__)   ((void) 0)
+#define FifoT_IDX_POW2_ADVANCE_LAST(self__, n__)    ((void) 0)
+#define FifoT_IDX_POW2_BUF(self__)                  ((self__)->fifo)
+#define FifoT_IDX_POW2_CAP(self__)                  ((self__)->capacity)
+
+// The index policy of the fixed fifos, the capacity is a constant taken from
+// the embedded array. It works as FifoT_IDX_POW2_ if the capacity is a power
+// of two and as FifoT_IDX_ otherwise, the compiler drops the unused branch.
+// The capacity is a size_t, the positions are compared as size_t as well.
+#define FifoT_IDX_FIXED_BUF(self__)               ((self__)->fifo)
+#define FifoT_IDX_FIXED_CAP(self__)                                         \
+    (sizeof((self__)->fifo) / sizeof((self__)->fifo[0]))
+#define FifoT_IDX_FIXED_IS_POW2_(self__)                                    \
+    FifoT_IDX_POW2_IS_VALID_CAPACITY(FifoT_IDX_FIXED_CAP(self__))
+#define FifoT_IDX_FIXED_WRAP(self__, pos__)                                 \
+    (FifoT_IDX_FIXED_IS_POW2_(self__)                                       \
+        ? (size_t) (pos__) & (FifoT_IDX_FIXED_CAP(self__) - 1)              \
+        : ((size_t) (pos__) >= FifoT_IDX_FIXED_CAP(self__))                 \
+            ? (size_t) (pos__) - FifoT_IDX_FIXED_CAP(self__)                \
+            : (size_t) (pos__))
+#define FifoT_IDX_FIXED_FIRST(self__)                                       \
+    (FifoT_IDX_FIXED_IS_POW2_(self__)                                       \
+        ? FifoT_IDX_FIXED_WRAP(self__, (self__)->out)                       \
+        : (self__)->first)
+#define FifoT_IDX_FIXED_LAST(self__)                                        \
+    (FifoT_IDX_FIXED_IS_POW2_(self__)                                       \
+        ? FifoT_IDX_FIXED_WRAP(self__, (self__)->in)                        \
+        : (self__)->last)
+#define FifoT_IDX_FIXED_ADVANCE_FIRST(self__, n__)                          \
+    (FifoT_IDX_FIXED_IS_POW2_(self__)                                       \
+        ? (void) 0                                                          \
+        : (void) ((self__)->first =                                         \
+                  FifoT_IDX_FIXED_WRAP(self__, (self__)->first + (n__))))
+#define FifoT_IDX_FIXED_ADVANCE_LAST(self__, n__)                           \
+    (FifoT_IDX_FIXED_IS_POW2_(self__)                                       \
+        ? (void) 0                                                          \
+        : (void) ((self__)->last =                                          \
+                  FifoT_IDX_FIXED_WRAP(self__, (self__)->last + (n__))))
+
+
+#define FifoT_CTOR_IMPL_(T__,N__, SIZE_T__, P__)                            \
 bool N__##_ctor(N__* self,                                                  \
                 void*    buffer,                                            \
                 SIZE_T__ capacity)                                          \
@@ -241,7 +536,7 @@ bool N__##_ctor(N__* self,                                                  \
                                                                             \
     self->fifo = buffer;                                                    \
                                                                             \
-    if (self->fifo == NULL)                                                 \
+    if (self->fifo == NULL || !P__##IS_VALID_CAPACITY(capacity))            \
     {                                                                       \
         return false;                                                       \
     }                                                                       \
@@ -250,9 +545,25 @@ bool N__##_ctor(N__* self,                                                  \
     self->in    = 0;                                                        \
     self->out   = 0;                                                        \
     self->capacity = capacity;                                              \
+    FifoT_STATS_(memset(&self->stats, 0, sizeof(self->stats)));             \
     return true;                                                            \
 }
 
+#define FifoT_CTOR_IMPL(T__,N__, SIZE_T__)                                  \
+    FifoT_CTOR_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_)
+
+#define FifoT_CTOR_FIXED_IMPL(T__, N__)                                     \
+void N__##_ctor(N__* self)                                                  \
+{                                                                           \
+    Debug_ASSERT_SELF(self);                                                \
+                                                                            \
+    self->first = 0;                                                        \
+    self->last  = 0;                                                        \
+    self->in    = 0;                                                        \
+    self->out   = 0;                                                        \
+    FifoT_STATS_(memset(&self->stats, 0, sizeof(self->stats)));             \
+}
+
 #define FifoT_DTOR_IMPL(T__, N__)                                           \
 void                                                                        \
 N__##_dtor(N__* self)                                                       \
@@ -267,52 +578,58 @@ N__##_isEmpty(N__ const* self)                                              \
     return self->in == self->out;                                           \
 }
 
-#define FifoT_ISFULL_IMPL(T__, N__)                                         \
+#define FifoT_ISFULL_IMPL_(T__, N__, P__)                                   \
 bool                                                                        \
 N__##_isFull(N__ const* self)                                               \
 {                                                                           \
-    return N__##_getSize(self) == self->capacity;                           \
+    return N__##_getSize(self) == P__##CAP(self);                           \
 }
 
+#define FifoT_ISFULL_IMPL(T__, N__)                                         \
+    FifoT_ISFULL_IMPL_(T__, N__, FifoT_IDX_)
+
+// ''in'' and ''out'' are free running counters, their difference is the size
+// even after they wrapped around (SIZE_T__ must be unsigned).
 #define FifoT_GETSIZE_IMPL(T__, N__, SIZE_T__)                              \
 SIZE_T__                                                                    \
 N__##_getSize(N__ const* self)                                              \
 {                                                                           \
-    if (self->in >= self->out)                                              \
-    {                                                                       \
-        return self->in - self->out;                                        \
-    }                                                                       \
-    else                                                                    \
-    {                                                                       \
-        return self->out - self->in;                                        \
-    }                                                                       \
+    return (SIZE_T__) (self->in - self->out);                               \
 }
 
-#define FifoT_GETCAPACITY_IMPL(T__, N__, SIZE_T__)                          \
+#define FifoT_GETCAPACITY_IMPL_(T__, N__, SIZE_T__, P__)                    \
 SIZE_T__                                                                    \
 N__##_getCapacity(N__ const* self)                                          \
 {                                                                           \
-    return self->capacity;                                                  \
+    return (SIZE_T__) P__##CAP(self);                                       \
 }
 
-#define FifoT_PUSH_IMPL(T__, N__, SIZE_T__)                                 \
+#define FifoT_GETCAPACITY_IMPL(T__, N__, SIZE_T__)                          \
+    FifoT_GETCAPACITY_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_)
+
+#define FifoT_PUSH_IMPL_(T__, N__, SIZE_T__, P__)                           \
 bool                                                                        \
 N__##_push(N__* self, T__ const* item)                                      \
 {                                                                           \
     if (N__##_isFull(self))                                                 \
     {                                                                       \
+        FifoT_STATS_(self->stats.rejected++);                               \
         return false;                                                       \
     }                                                                       \
     DECL_UNUSED_VAR(const bool ok) =                                        \
-        T__##_ctorCopy(&self->fifo[ self->last ], item);                    \
+        T__##_ctorCopy(&P__##BUF(self)[ P__##LAST(self) ], item);           \
     Debug_ASSERT(ok);                                                       \
                                                                             \
-    self->last = (self->last + 1) % self->capacity;                         \
+    P__##ADVANCE_LAST(self, 1);                                             \
     self->in++;                                                             \
+    FifoT_STATS_HIGH_WATER_(self, N__##_getSize(self));                     \
     return true;                                                            \
 }
 
-#define FifoT_POP_IMPL(T__, N__)                                            \
+#define FifoT_PUSH_IMPL(T__, N__, SIZE_T__)                                 \
+    FifoT_PUSH_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_)
+
+#define FifoT_POP_IMPL_(T__, N__, P__)                                      \
 bool                                                                        \
 N__##_pop(N__* self)                                                        \
 {                                                                           \
@@ -320,13 +637,16 @@ N__##_pop(N__* self)                                                        \
     {                                                                       \
         return false;                                                       \
     }                                                                       \
-    T__##_dtor(&self->fifo[self->first]);                                   \
-    self->first = (self->first + 1) % self->capacity;                       \
+    T__##_dtor(&P__##BUF(self)[ P__##FIRST(self) ]);                        \
+    P__##ADVANCE_FIRST(self, 1);                                            \
     self->out++;                                                            \
     return true;                                                            \
 }
 
-#define FifoT_GETFIRST_IMPL(T__, N__)                                       \
+#define FifoT_POP_IMPL(T__, N__)                                            \
+    FifoT_POP_IMPL_(T__, N__, FifoT_IDX_)
+
+#define FifoT_GETFIRST_IMPL_(T__, N__, P__)                                 \
 T__ const*                                                                  \
 N__##_getFirst(N__ const* self)                                             \
 {                                                                           \
@@ -336,10 +656,13 @@ N__##_getFirst(N__ const* self)                                             \
     }                                                                       \
     else                                                                    \
     {                                                                       \
-        return &self->fifo[self->first];                                    \
+        return &P__##BUF(self)[ P__##FIRST(self) ];                         \
     }                                                                       \
 }
 
+#define FifoT_GETFIRST_IMPL(T__, N__)                                       \
+    FifoT_GETFIRST_IMPL_(T__, N__, FifoT_IDX_)
+
 #define FifoT_CLEAR_IMPL(T__, N__, SIZE_T__)                                \
 void                                                                        \
 N__##_clear(N__* self)                                                      \
@@ -347,7 +670,7 @@ N__##_clear(N__* self)                                                      \
     while (N__##_pop(self));                                                \
 }
 
-#define FifoT_CONST_APPLY_IMPL(T__, N__, SIZE_T__)                          \
+#define FifoT_CONST_APPLY_IMPL_(T__, N__, SIZE_T__, P__)                    \
 SIZE_T__                                                                    \
 N__##_constApply(N__ const* self,                                           \
                     N__##_applyFn fn,                                       \
@@ -355,28 +678,1050 @@ N__##_constApply(N__ const* self,                                           \
 {                                                                           \
     SIZE_T__ i = 0;                                                         \
     SIZE_T__ size = N__##_getSize(self);                                    \
+    SIZE_T__ first = P__##FIRST(self);                                      \
     bool cont = true;                                                       \
                                                                             \
     for (i = 0; i < size && cont; ++i)                                      \
     {                                                                       \
-        SIZE_T__ index = (i + self->first) % self->capacity;                \
-        cont = fn(context, &self->fifo[ index ], i);                        \
+        SIZE_T__ index = P__##WRAP(self, first + i);                        \
+        cont = fn(context, &P__##BUF(self)[ index ], i);                    \
     }                                                                       \
     return i;                                                               \
 }
 
+#define FifoT_CONST_APPLY_IMPL(T__, N__, SIZE_T__)                          \
+    FifoT_CONST_APPLY_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_)
+
 
-#define FifoT_DEFINE(T__, N__, SIZE_T__)                                    \
-         FifoT_CTOR_IMPL(T__, N__, SIZE_T__)                                \
+// Copy policies of the bulk operations. FifoT_BULK_COPY constructs ''n__''
+// elements at ''dst__'' from the ones at ''src__'', FifoT_BULK_TAKE does the
+// same and then destroys the source elements.
+
+#define FifoT_BULK_COPY(T__, dst__, src__, n__)                             \
+    do                                                                      \
+    {                                                                       \
+        for (size_t i__ = 0; i__ < (size_t) (n__); ++i__)                   \
+        {                                                                   \
+            DECL_UNUSED_VAR(const bool ok) =                                \
+                T__##_ctorCopy(&(dst__)[i__], &(src__)[i__]);               \
+            Debug_ASSERT(ok);                                               \
+        }                                                                   \
+    }                                                                       \
+    while (0)
+
+#define FifoT_BULK_TAKE(T__, dst__, src__, n__)                             \
+    do                                                                      \
+    {                                                                       \
+        for (size_t i__ = 0; i__ < (size_t) (n__); ++i__)                   \
+        {                                                                   \
+            DECL_UNUSED_VAR(const bool ok) =                                \
+                T__##_ctorCopy(&(dst__)[i__], &(src__)[i__]);               \
+            Debug_ASSERT(ok);                                               \
+            T__##_dtor(&(src__)[i__]);                                      \
+        }                                                                   \
+    }                                                                       \
+    while (0)
+
+#define FifoT_BULK_COPY_TRIVIAL(T__, dst__, src__, n__)                     \
+    memcpy((dst__), (src__), (n__) * sizeof(T__))
+
+#define FifoT_BULK_TAKE_TRIVIAL(T__, dst__, src__, n__)                     \
+    memcpy((dst__), (src__), (n__) * sizeof(T__))
+
+// Drop policies. FifoT_BULK_DROP destroys ''n__'' elements at ''ptr__'', the
+// trivial one does nothing at all.
+
+#define FifoT_BULK_DROP(T__, ptr__, n__)                                    \
+    do                                                                      \
+    {                                                                       \
+        for (size_t i__ = 0; i__ < (size_t) (n__); ++i__)                   \
+        {                                                                   \
+            T__##_dtor(&(ptr__)[i__]);                                      \
+        }                                                                   \
+    }                                                                       \
+    while (0)
+
+#define FifoT_BULK_DROP_TRIVIAL(T__, ptr__, n__)    ((void) 0)
+
+#define FifoT_DROP_FIRST_IMPL_(T__, N__, SIZE_T__, P__, DROP__)             \
+SIZE_T__                                                                    \
+N__##_dropFirst(N__* self, SIZE_T__ n)                                      \
+{                                                                           \
+    SIZE_T__ size = N__##_getSize(self);                                    \
+    SIZE_T__ first = P__##FIRST(self);                                      \
+    SIZE_T__ head = P__##CAP(self) - first;                                 \
+                                                                            \
+    if (n > size)                                                           \
+    {                                                                       \
+        n = size;                                                           \
+    }                                                                       \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    DROP__(T__, &P__##BUF(self)[first], head);                              \
+    DROP__(T__, &P__##BUF(self)[0], n - head);                              \
+                                                                            \
+    P__##ADVANCE_FIRST(self, n);                                            \
+    self->out += n;                                                         \
+    return n;                                                               \
+}
+
+// The clear of the fifos which are not shared between threads, it takes
+// constant time if the elements do not need to be destroyed.
+#define FifoT_CLEAR_BY_DROP_IMPL(T__, N__)                                  \
+void                                                                        \
+N__##_clear(N__* self)                                                      \
+{                                                                           \
+    N__##_dropFirst(self, N__##_getSize(self));                             \
+}
+
+#define FifoT_PUSH_OVERWRITE_IMPL_(T__, N__, SIZE_T__, P__, DROP__)         \
+bool                                                                        \
+N__##_pushOverwrite(N__* self, T__ const* item)                             \
+{                                                                           \
+    Debug_ASSERT(P__##CAP(self) > 0);                                       \
+    bool full = N__##_isFull(self);                                         \
+                                                                            \
+    if (full)                                                               \
+    {                                                                       \
+        DROP__(T__, &P__##BUF(self)[ P__##FIRST(self) ], 1);                \
+        P__##ADVANCE_FIRST(self, 1);                                        \
+        self->out++;                                                        \
+        FifoT_STATS_(self->stats.dropped++);                                \
+    }                                                                       \
+    DECL_UNUSED_VAR(const bool ok) =                                        \
+        T__##_ctorCopy(&P__##BUF(self)[ P__##LAST(self) ], item);           \
+    Debug_ASSERT(ok);                                                       \
+                                                                            \
+    P__##ADVANCE_LAST(self, 1);                                             \
+    self->in++;                                                             \
+    FifoT_STATS_HIGH_WATER_(self, N__##_getSize(self));                     \
+    return full;                                                            \
+}
+
+#define FifoT_PUSH_MANY_OVERWRITE_IMPL_(T__, N__, SIZE_T__, P__)            \
+SIZE_T__                                                                    \
+N__##_pushManyOverwrite(N__* self, T__ const* src, SIZE_T__ n)              \
+{                                                                           \
+    SIZE_T__ skipped = 0;                                                   \
+    SIZE_T__ room = P__##CAP(self) - N__##_getSize(self);                   \
+                                                                            \
+    if (n > P__##CAP(self))                                                 \
+    {                                                                       \
+        skipped = n - P__##CAP(self);                                       \
+        src += skipped;                                                     \
+        n = P__##CAP(self);                                                 \
+    }                                                                       \
+    SIZE_T__ dropped = (n > room) ? N__##_dropFirst(self, n - room) : 0;    \
+                                                                            \
+    DECL_UNUSED_VAR(const SIZE_T__ pushed) = N__##_pushMany(self, src, n);  \
+    Debug_ASSERT(pushed == n);                                              \
+                                                                            \
+    FifoT_STATS_(self->stats.dropped += skipped + dropped);                 \
+    return skipped + dropped;                                               \
+}
+
+#define FifoT_PUSH_MANY_OVERWRITE_IMPL(T__, N__, SIZE_T__)                  \
+    FifoT_PUSH_MANY_OVERWRITE_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_)
+
+#define FifoT_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, P__, COPY__)              \
+SIZE_T__                                                                    \
+N__##_pushMany(N__* self, T__ const* src, SIZE_T__ n)                       \
+{                                                                           \
+    SIZE_T__ room = P__##CAP(self) - N__##_getSize(self);                   \
+    SIZE_T__ last = P__##LAST(self);                                        \
+    SIZE_T__ head = P__##CAP(self) - last;                                  \
+                                                                            \
+    if (n > room)                                                           \
+    {                                                                       \
+        FifoT_STATS_(self->stats.rejected += n - room);                     \
+        n = room;                                                           \
+    }                                                                       \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    COPY__(T__, &P__##BUF(self)[last], src, head);                          \
+    COPY__(T__, &P__##BUF(self)[0], src + head, n - head);                  \
+                                                                            \
+    P__##ADVANCE_LAST(self, n);                                             \
+    self->in += n;                                                          \
+    FifoT_STATS_HIGH_WATER_(self, N__##_getSize(self));                     \
+    return n;                                                               \
+}
+
+#define FifoT_POP_MANY_IMPL_(T__, N__, SIZE_T__, P__, TAKE__)               \
+SIZE_T__                                                                    \
+N__##_popMany(N__* self, T__* dst, SIZE_T__ n)                              \
+{                                                                           \
+    SIZE_T__ size = N__##_getSize(self);                                    \
+    SIZE_T__ first = P__##FIRST(self);                                      \
+    SIZE_T__ head = P__##CAP(self) - first;                                 \
+                                                                            \
+    if (n > size)                                                           \
+    {                                                                       \
+        n = size;                                                           \
+    }                                                                       \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    TAKE__(T__, dst, &P__##BUF(self)[first], head);                         \
+    TAKE__(T__, dst + head, &P__##BUF(self)[0], n - head);                  \
+                                                                            \
+    P__##ADVANCE_FIRST(self, n);                                            \
+    self->out += n;                                                         \
+    return n;                                                               \
+}
+
+#define FifoT_PUSH_MANY_IMPL(T__, N__, SIZE_T__)                            \
+    FifoT_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_, FifoT_BULK_COPY)
+
+#define FifoT_POP_MANY_IMPL(T__, N__, SIZE_T__)                             \
+    FifoT_POP_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_, FifoT_BULK_TAKE)
+
+#define FifoT_PUSH_MANY_TRIVIAL_IMPL(T__, N__, SIZE_T__)                    \
+    FifoT_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_,                   \
+                          FifoT_BULK_COPY_TRIVIAL)
+
+#define FifoT_POP_MANY_TRIVIAL_IMPL(T__, N__, SIZE_T__)                     \
+    FifoT_POP_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_,                    \
+                         FifoT_BULK_TAKE_TRIVIAL)
+
+// Fills the spans of ''size__'' elements starting at position ''first__'' of
+// the buffer ''buf__'' of ''cap__'' elements
+#define FifoT_FILL_SPANS_(SIZE_T__, buf__, cap__, spans__, first__, size__) \
+    do                                                                      \
+    {                                                                       \
+        SIZE_T__ head__ = (cap__) - (first__);                              \
+        if (head__ > (size__))                                              \
+        {                                                                   \
+            head__ = (size__);                                              \
+        }                                                                   \
+        (spans__)[0].ptr = (head__ > 0) ? &(buf__)[first__] : NULL;         \
+        (spans__)[0].len = head__;                                          \
+        (spans__)[1].ptr = ((size__) > head__) ? &(buf__)[0] : NULL;        \
+        (spans__)[1].len = (size__) - head__;                               \
+    }                                                                       \
+    while (0)
+
+#define FifoT_FILL_SPANS(SIZE_T__, self__, spans__, first__, size__)        \
+    FifoT_FILL_SPANS_(SIZE_T__, (self__)->fifo, (self__)->capacity,         \
+                      spans__, first__, size__)
+
+#define FifoT_PEEK_SPANS_IMPL_(T__, N__, SIZE_T__, P__)                     \
+SIZE_T__                                                                    \
+N__##_peekSpans(N__ const* self, N__##_Span spans[2])                       \
+{                                                                           \
+    SIZE_T__ size = N__##_getSize(self);                                    \
+    SIZE_T__ first = P__##FIRST(self);                                      \
+                                                                            \
+    FifoT_FILL_SPANS_(SIZE_T__, P__##BUF(self), P__##CAP(self),             \
+                      spans, first, size);                                  \
+    return (spans[0].len > 0) + (spans[1].len > 0);                         \
+}
+
+#define FifoT_PEEK_SPANS_IMPL(T__, N__, SIZE_T__)                           \
+    FifoT_PEEK_SPANS_IMPL_(T__, N__, SIZE_T__, FifoT_IDX_)
+
+
+#define FifoT_DEFINE_METHODS_(T__, N__, SIZE_T__, P__, COPY__, TAKE__,      \
+                              DROP__)                                       \
          FifoT_DTOR_IMPL(T__, N__)                                          \
          FifoT_ISEMPTY_IMPL(T__, N__)                                       \
-         FifoT_ISFULL_IMPL(T__, N__)                                        \
+         FifoT_ISFULL_IMPL_(T__, N__, P__)                                  \
          FifoT_GETSIZE_IMPL(T__, N__, SIZE_T__)                             \
-         FifoT_GETCAPACITY_IMPL(T__, N__, SIZE_T__)                         \
-         FifoT_PUSH_IMPL(T__, N__, SIZE_T__)                                \
-         FifoT_POP_IMPL(T__, N__)                                           \
-         FifoT_GETFIRST_IMPL(T__, N__)                                      \
-         FifoT_CLEAR_IMPL(T__, N__, SIZE_T__)                               \
-         FifoT_CONST_APPLY_IMPL(T__, N__, SIZE_T__)
+         FifoT_GETCAPACITY_IMPL_(T__, N__, SIZE_T__, P__)                   \
+         FifoT_PUSH_IMPL_(T__, N__, SIZE_T__, P__)                          \
+         FifoT_POP_IMPL_(T__, N__, P__)                                     \
+         FifoT_GETFIRST_IMPL_(T__, N__, P__)                                \
+         FifoT_CLEAR_BY_DROP_IMPL(T__, N__)                                 \
+         FifoT_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, P__, COPY__)             \
+         FifoT_POP_MANY_IMPL_(T__, N__, SIZE_T__, P__, TAKE__)              \
+         FifoT_PEEK_SPANS_IMPL_(T__, N__, SIZE_T__, P__)                    \
+         FifoT_CONST_APPLY_IMPL_(T__, N__, SIZE_T__, P__)                   \
+         FifoT_DROP_FIRST_IMPL_(T__, N__, SIZE_T__, P__, DROP__)            \
+         FifoT_PUSH_OVERWRITE_IMPL_(T__, N__, SIZE_T__, P__, DROP__)        \
+         FifoT_PUSH_MANY_OVERWRITE_IMPL_(T__, N__, SIZE_T__, P__)           \
+         FifoT_GETSTATS_IMPL_(T__, N__)
+
+#define FifoT_DEFINE_(T__, N__, SIZE_T__, P__, COPY__, TAKE__, DROP__)      \
+         FifoT_CTOR_IMPL_(T__, N__, SIZE_T__, P__)                          \
+         FifoT_DEFINE_METHODS_(T__, N__, SIZE_T__, P__,                     \
+                               COPY__, TAKE__, DROP__)
+
+#define FifoT_DEFINE(T__, N__, SIZE_T__)                                    \
+         FifoT_DEFINE_(T__, N__, SIZE_T__, FifoT_IDX_,                      \
+                       FifoT_BULK_COPY, FifoT_BULK_TAKE,                    \
+                       FifoT_BULK_DROP)
+
+#define FifoT_DEFINE_TRIVIAL(T__, N__, SIZE_T__)                            \
+         FifoT_DEFINE_(T__, N__, SIZE_T__, FifoT_IDX_,                      \
+                       FifoT_BULK_COPY_TRIVIAL, FifoT_BULK_TAKE_TRIVIAL,    \
+                       FifoT_BULK_DROP_TRIVIAL)
+
+/**
+ * Power of two flavours of FifoT_DEFINE() and FifoT_DEFINE_TRIVIAL(). The
+ * interface is the same, but the constructor fails unless the capacity is a
+ * power of two. In exchange the positions in the buffer are computed from the
+ * free running counters with a mask, so push and pop update a single counter
+ * and do not need any compare to wrap around.
+ */
+#define FifoT_DEFINE_POW2(T__, N__, SIZE_T__)                               \
+         FifoT_DEFINE_(T__, N__, SIZE_T__, FifoT_IDX_POW2_,                 \
+                       FifoT_BULK_COPY, FifoT_BULK_TAKE,                    \
+                       FifoT_BULK_DROP)
+
+#define FifoT_DEFINE_POW2_TRIVIAL(T__, N__, SIZE_T__)                       \
+         FifoT_DEFINE_(T__, N__, SIZE_T__, FifoT_IDX_POW2_,                 \
+                       FifoT_BULK_COPY_TRIVIAL, FifoT_BULK_TAKE_TRIVIAL,    \
+                       FifoT_BULK_DROP_TRIVIAL)
+
+/**
+ * Definitions of the fifos of FifoT_TYPE_FIXED(), declared with
+ * FifoT_DECLARE_FIXED(). The _TRIVIAL flavour has the same requirements as
+ * FifoT_DEFINE_TRIVIAL().
+ */
+#define FifoT_DEFINE_FIXED(T__, N__, SIZE_T__)                              \
+         FifoT_CTOR_FIXED_IMPL(T__, N__)                                    \
+         FifoT_DEFINE_METHODS_(T__, N__, SIZE_T__, FifoT_IDX_FIXED_,        \
+                               FifoT_BULK_COPY, FifoT_BULK_TAKE,            \
+                               FifoT_BULK_DROP)
+
+#define FifoT_DEFINE_FIXED_TRIVIAL(T__, N__, SIZE_T__)                      \
+         FifoT_CTOR_FIXED_IMPL(T__, N__)                                    \
+         FifoT_DEFINE_METHODS_(T__, N__, SIZE_T__, FifoT_IDX_FIXED_,        \
+                               FifoT_BULK_COPY_TRIVIAL,                     \
+                               FifoT_BULK_TAKE_TRIVIAL,                     \
+                               FifoT_BULK_DROP_TRIVIAL)
+
+
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+// ::::::::::::::::::::::::::::::::::::::::: Single producer/single consumer :::
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/**
+ * Lock-free single-producer/single-consumer flavour of FifoT.
+ *
+ * It provides the same interface as FifoT, but one producer and one consumer
+ * can operate on the container at the same time without any lock. #push() and
+ * #pushMany() are the producer methods; #pop(), #popMany(), #getFirst(),
+ * #peekSpans(), #clear() and #constApply() are consumer methods. #isEmpty(),
+ * #isFull() and #getSize() can be called from both sides, the result is a
+ * snapshot that might already be outdated when it is returned.
+ *
+ * The producer owns ''in'' and ''last'', the consumer owns ''out'' and
+ * ''first''. Each side publishes its counter with release semantics and reads
+ * the counter of the other side with acquire semantics, so the element
+ * written by #push() is visible to the consumer before the counter is, and a
+ * slot released by #pop() is not overwritten before its destruction finished.
+ * Both sides also keep a cached copy of the counter of the other side, so the
+ * cache line of the other side is only touched when the cached view says the
+ * fifo is full (producer) or empty (consumer).
+ *
+ * The counters of the two sides are kept on separate cache lines to avoid
+ * false sharing, see #FifoT_CACHE_LINE_SIZE.
+ *
+ * @note SIZE_T must be an unsigned type, ''in'' and ''out'' are free running
+ *       counters and the size is computed as their difference.
+ */
+
+#if !defined(FifoT_CACHE_LINE_SIZE)
+#define FifoT_CACHE_LINE_SIZE 64
+#endif
+
+#define FifoT_SPSC_TYPE(T__, SIZE_T__)                                      \
+struct {                                                                    \
+    T__* fifo;                                                              \
+    SIZE_T__ capacity;                                                      \
+    /* producer side */                                                     \
+    SIZE_T__ in __attribute__((aligned(FifoT_CACHE_LINE_SIZE)));            \
+    SIZE_T__ last;                                                          \
+    SIZE_T__ outCached;                                                     \
+    /* consumer side */                                                     \
+    SIZE_T__ out __attribute__((aligned(FifoT_CACHE_LINE_SIZE)));           \
+    SIZE_T__ first;                                                         \
+    SIZE_T__ inCached;                                                      \
+}
+
+#define FifoT_SPSC_DECLARE(T__, N__, SIZE_T__)                              \
+         FifoT_CTOR_DECL(T__, N__, SIZE_T__);                               \
+         FifoT_DECLARE_COMMON_(T__, N__, SIZE_T__)
+
+#define FifoT_SPSC_LOAD_ACQUIRE(p__)    __atomic_load_n(p__, __ATOMIC_ACQUIRE)
+#define FifoT_SPSC_STORE_RELEASE(p__, v__)                                  \
+    __atomic_store_n(p__, v__, __ATOMIC_RELEASE)
+
+#define FifoT_SPSC_CTOR_IMPL(T__,N__, SIZE_T__)                             \
+bool N__##_ctor(N__* self,                                                  \
+                void*    buffer,                                            \
+                SIZE_T__ capacity)                                          \
+{                                                                           \
+    Debug_ASSERT_SELF(self);                                                \
+                                                                            \
+    self->fifo = buffer;                                                    \
+                                                                            \
+    if (self->fifo == NULL || capacity == 0)                                \
+    {                                                                       \
+        return false;                                                       \
+    }                                                                       \
+    self->capacity  = capacity;                                             \
+    self->in        = 0;                                                    \
+    self->last      = 0;                                                    \
+    self->outCached = 0;                                                    \
+    self->out       = 0;                                                    \
+    self->first     = 0;                                                    \
+    self->inCached  = 0;                                                    \
+    __atomic_thread_fence(__ATOMIC_RELEASE);                                \
+    return true;                                                            \
+}
+
+#define FifoT_SPSC_ISEMPTY_IMPL(T__, N__)                                   \
+bool                                                                        \
+N__##_isEmpty(N__ const* self)                                              \
+{                                                                           \
+    return FifoT_SPSC_LOAD_ACQUIRE(&self->in) ==                            \
+           FifoT_SPSC_LOAD_ACQUIRE(&self->out);                             \
+}
+
+#define FifoT_SPSC_ISFULL_IMPL(T__, N__)                                    \
+bool                                                                        \
+N__##_isFull(N__ const* self)                                               \
+{                                                                           \
+    return N__##_getSize(self) == self->capacity;                           \
+}
+
+#define FifoT_SPSC_GETSIZE_IMPL(T__, N__, SIZE_T__)                         \
+SIZE_T__                                                                    \
+N__##_getSize(N__ const* self)                                              \
+{                                                                           \
+    /* read ''out'' first, so that the size can never appear negative. If */\
+    /* both sides moved in between, the size is capped to the capacity */   \
+    SIZE_T__ out  = FifoT_SPSC_LOAD_ACQUIRE(&self->out);                    \
+    SIZE_T__ in   = FifoT_SPSC_LOAD_ACQUIRE(&self->in);                     \
+    SIZE_T__ size = (SIZE_T__) (in - out);                                  \
+    return (size > self->capacity) ? self->capacity : size;                 \
+}
+
+#define FifoT_SPSC_PUSH_IMPL(T__, N__, SIZE_T__)                            \
+bool                                                                        \
+N__##_push(N__* self, T__ const* item)                                      \
+{                                                                           \
+    SIZE_T__ in = self->in;                                                 \
+                                                                            \
+    if ((SIZE_T__) (in - self->outCached) == self->capacity)                \
+    {                                                                       \
+        self->outCached = FifoT_SPSC_LOAD_ACQUIRE(&self->out);              \
+        if ((SIZE_T__) (in - self->outCached) == self->capacity)            \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+    }                                                                       \
+    DECL_UNUSED_VAR(const bool ok) =                                        \
+        T__##_ctorCopy(&self->fifo[ self->last ], item);                    \
+    Debug_ASSERT(ok);                                                       \
+                                                                            \
+    self->last = (self->last + 1 == self->capacity) ? 0 : self->last + 1;   \
+    FifoT_SPSC_STORE_RELEASE(&self->in, (SIZE_T__) (in + 1));               \
+    return true;                                                            \
+}
+
+#define FifoT_SPSC_POP_IMPL(T__, N__, SIZE_T__)                             \
+bool                                                                        \
+N__##_pop(N__* self)                                                        \
+{                                                                           \
+    SIZE_T__ out = self->out;                                               \
+                                                                            \
+    if (self->inCached == out)                                              \
+    {                                                                       \
+        self->inCached = FifoT_SPSC_LOAD_ACQUIRE(&self->in);                \
+        if (self->inCached == out)                                          \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+    }                                                                       \
+    T__##_dtor(&self->fifo[self->first]);                                   \
+    self->first = (self->first + 1 == self->capacity) ? 0 : self->first + 1;\
+    FifoT_SPSC_STORE_RELEASE(&self->out, (SIZE_T__) (out + 1));             \
+    return true;                                                            \
+}
+
+#define FifoT_SPSC_GETFIRST_IMPL(T__, N__)                                  \
+T__ const*                                                                  \
+N__##_getFirst(N__ const* self)                                             \
+{                                                                           \
+    if (FifoT_SPSC_LOAD_ACQUIRE(&self->in) == self->out)                    \
+    {                                                                       \
+        return NULL;                                                        \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+        return &self->fifo[self->first];                                    \
+    }                                                                       \
+}
+
+#define FifoT_SPSC_CONST_APPLY_IMPL(T__, N__, SIZE_T__)                     \
+SIZE_T__                                                                    \
+N__##_constApply(N__ const* self,                                           \
+                    N__##_applyFn fn,                                       \
+                    void* context)                                          \
+{                                                                           \
+    SIZE_T__ i = 0;                                                         \
+    SIZE_T__ size = (SIZE_T__) (FifoT_SPSC_LOAD_ACQUIRE(&self->in) -        \
+                                self->out);                                 \
+    SIZE_T__ index = self->first;                                           \
+    bool cont = true;                                                       \
+                                                                            \
+    for (i = 0; i < size && cont; ++i)                                      \
+    {                                                                       \
+        cont = fn(context, &self->fifo[ index ], i);                        \
+        index = (index + 1 == self->capacity) ? 0 : index + 1;              \
+    }                                                                       \
+    return i;                                                               \
+}
+
+#define FifoT_SPSC_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, COPY__)              \
+SIZE_T__                                                                    \
+N__##_pushMany(N__* self, T__ const* src, SIZE_T__ n)                       \
+{                                                                           \
+    SIZE_T__ in   = self->in;                                               \
+    SIZE_T__ room = self->capacity - (SIZE_T__) (in - self->outCached);     \
+    SIZE_T__ last = self->last;                                             \
+    SIZE_T__ head = self->capacity - last;                                  \
+                                                                            \
+    if (n > room)                                                           \
+    {                                                                       \
+        self->outCached = FifoT_SPSC_LOAD_ACQUIRE(&self->out);              \
+        room = self->capacity - (SIZE_T__) (in - self->outCached);          \
+        if (n > room)                                                       \
+        {                                                                   \
+            n = room;                                                       \
+        }                                                                   \
+    }                                                                       \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    COPY__(T__, &self->fifo[last], src, head);                              \
+    COPY__(T__, &self->fifo[0], src + head, n - head);                      \
+                                                                            \
+    last += n;                                                              \
+    self->last = (last >= self->capacity) ? last - self->capacity : last;   \
+    FifoT_SPSC_STORE_RELEASE(&self->in, (SIZE_T__) (in + n));               \
+    return n;                                                               \
+}
+
+#define FifoT_SPSC_POP_MANY_IMPL_(T__, N__, SIZE_T__, TAKE__)               \
+SIZE_T__                                                                    \
+N__##_popMany(N__* self, T__* dst, SIZE_T__ n)                              \
+{                                                                           \
+    SIZE_T__ out   = self->out;                                             \
+    SIZE_T__ size  = (SIZE_T__) (self->inCached - out);                     \
+    SIZE_T__ first = self->first;                                           \
+    SIZE_T__ head  = self->capacity - first;                                \
+                                                                            \
+    if (n > size)                                                           \
+    {                                                                       \
+        self->inCached = FifoT_SPSC_LOAD_ACQUIRE(&self->in);                \
+        size = (SIZE_T__) (self->inCached - out);                           \
+        if (n > size)                                                       \
+        {                                                                   \
+            n = size;                                                       \
+        }                                                                   \
+    }                                                                       \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    TAKE__(T__, dst, &self->fifo[first], head);                             \
+    TAKE__(T__, dst + head, &self->fifo[0], n - head);                      \
+                                                                            \
+    first += n;                                                             \
+    self->first = (first >= self->capacity) ? first - self->capacity        \
+                                            : first;                        \
+    FifoT_SPSC_STORE_RELEASE(&self->out, (SIZE_T__) (out + n));             \
+    return n;                                                               \
+}
+
+#define FifoT_SPSC_PUSH_MANY_IMPL(T__, N__, SIZE_T__)                       \
+    FifoT_SPSC_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_BULK_COPY)
+
+#define FifoT_SPSC_POP_MANY_IMPL(T__, N__, SIZE_T__)                        \
+    FifoT_SPSC_POP_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_BULK_TAKE)
+
+#define FifoT_SPSC_PUSH_MANY_TRIVIAL_IMPL(T__, N__, SIZE_T__)               \
+    FifoT_SPSC_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_BULK_COPY_TRIVIAL)
+
+#define FifoT_SPSC_POP_MANY_TRIVIAL_IMPL(T__, N__, SIZE_T__)                \
+    FifoT_SPSC_POP_MANY_IMPL_(T__, N__, SIZE_T__, FifoT_BULK_TAKE_TRIVIAL)
+
+#define FifoT_SPSC_PEEK_SPANS_IMPL(T__, N__, SIZE_T__)                      \
+SIZE_T__                                                                    \
+N__##_peekSpans(N__ const* self, N__##_Span spans[2])                       \
+{                                                                           \
+    SIZE_T__ size = (SIZE_T__) (FifoT_SPSC_LOAD_ACQUIRE(&self->in) -        \
+                                self->out);                                 \
+                                                                            \
+    FifoT_FILL_SPANS(SIZE_T__, self, spans, self->first, size);             \
+    return (spans[0].len > 0) + (spans[1].len > 0);                         \
+}
+
+#define FifoT_SPSC_DEFINE(T__, N__, SIZE_T__)                               \
+         FifoT_SPSC_CTOR_IMPL(T__, N__, SIZE_T__)                           \
+         FifoT_DTOR_IMPL(T__, N__)                                          \
+         FifoT_SPSC_ISEMPTY_IMPL(T__, N__)                                  \
+         FifoT_SPSC_ISFULL_IMPL(T__, N__)                                   \
+         FifoT_SPSC_GETSIZE_IMPL(T__, N__, SIZE_T__)                        \
+         FifoT_GETCAPACITY_IMPL(T__, N__, SIZE_T__)                         \
+         FifoT_SPSC_PUSH_IMPL(T__, N__, SIZE_T__)                           \
+         FifoT_SPSC_POP_IMPL(T__, N__, SIZE_T__)                            \
+         FifoT_SPSC_GETFIRST_IMPL(T__, N__)                                 \
+         FifoT_CLEAR_IMPL(T__, N__, SIZE_T__)                               \
+         FifoT_SPSC_PUSH_MANY_IMPL(T__, N__, SIZE_T__)                      \
+         FifoT_SPSC_POP_MANY_IMPL(T__, N__, SIZE_T__)                       \
+         FifoT_SPSC_PEEK_SPANS_IMPL(T__, N__, SIZE_T__)                     \
+         FifoT_SPSC_CONST_APPLY_IMPL(T__, N__, SIZE_T__)
+
+#define FifoT_SPSC_DEFINE_TRIVIAL(T__, N__, SIZE_T__)                       \
+         FifoT_SPSC_CTOR_IMPL(T__, N__, SIZE_T__)                           \
+         FifoT_DTOR_IMPL(T__, N__)                                          \
+         FifoT_SPSC_ISEMPTY_IMPL(T__, N__)                                  \
+         FifoT_SPSC_ISFULL_IMPL(T__, N__)                                   \
+         FifoT_SPSC_GETSIZE_IMPL(T__, N__, SIZE_T__)                        \
+         FifoT_GETCAPACITY_IMPL(T__, N__, SIZE_T__)                         \
+         FifoT_SPSC_PUSH_IMPL(T__, N__, SIZE_T__)                           \
+         FifoT_SPSC_POP_IMPL(T__, N__, SIZE_T__)                            \
+         FifoT_SPSC_GETFIRST_IMPL(T__, N__)                                 \
+         FifoT_CLEAR_IMPL(T__, N__, SIZE_T__)                               \
+         FifoT_SPSC_PUSH_MANY_TRIVIAL_IMPL(T__, N__, SIZE_T__)              \
+         FifoT_SPSC_POP_MANY_TRIVIAL_IMPL(T__, N__, SIZE_T__)               \
+         FifoT_SPSC_PEEK_SPANS_IMPL(T__, N__, SIZE_T__)                     \
+         FifoT_SPSC_CONST_APPLY_IMPL(T__, N__, SIZE_T__)
+
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+// :::::::::::::::::::::::::::::::::::::::::: Multi producer/single consumer :::
+// :::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::::
+
+/**
+ * Lock-free multi-producer/single-consumer flavour of FifoT.
+ *
+ * It provides the same interface as FifoT, but any number of producers and
+ * one consumer can operate on the container at the same time without any
+ * lock. Besides #push() and #pushMany(), a producer can write in place: it
+ * reserves a range of slots with #reserve(), constructs the elements in the
+ * returned spans and then hands them over to the consumer with #commit().
+ * #pop(), #popMany(), #getFirst(), #peekSpans(), #clear() and #constApply()
+ * are consumer methods.
+ *
+ * Producers reserve slots by advancing ''reserved'' with a compare and swap,
+ * which fails only if another producer reserved in between. It is not a
+ * fetch-add because a reservation must fail as a whole if the fifo has not
+ * enough room, and an added count could not be taken back once another
+ * producer has reserved behind it.
+ *
+ * Every slot has a sequence number, which a producer sets to its position
+ * plus one with a release store to commit the element in it. The slots of a
+ * reservation are committed from the last to the first, so the consumer sees
+ * either all of them or none. The producers never wait for each other, they
+ * commit in any order. The consumer drains the run of committed slots from
+ * ''out'' on, a pending reservation holds back the elements reserved after
+ * it, but never the ones committed before it. The end of the run is cached in
+ * ''inCached'', the consumer scans further only when it has caught up with it.
+ *
+ * The sequence numbers are stored in the buffer passed to the constructor,
+ * after the elements. The buffer must hold FifoT_MPSC_SIZE_OF_BUFFER() bytes
+ * and be aligned for SIZE_T.
+ *
+ * #isEmpty(), #isFull() and #getSize() can be called from all sides. They
+ * count the reserved elements too, so #getFirst() can return NULL while
+ * #isEmpty() returns false, until the pending reservations are committed.
+ *
+ * @note SIZE_T must be an unsigned type and the capacity must be a power of
+ *       two, the positions in the buffer are derived from the free running
+ *       counters with a mask.
+ */
+
+#define FifoT_MPSC_TYPE(T__, SIZE_T__)                                      \
+struct {                                                                    \
+    T__* fifo;                                                              \
+    SIZE_T__* seqs;                                                         \
+    SIZE_T__ capacity;                                                      \
+    /* producer side */                                                     \
+    SIZE_T__ reserved __attribute__((aligned(FifoT_CACHE_LINE_SIZE)));      \
+    /* consumer side */                                                     \
+    SIZE_T__ out __attribute__((aligned(FifoT_CACHE_LINE_SIZE)));           \
+    SIZE_T__ inCached;                                                      \
+}
+
+/**
+ * The size in bytes of the buffer of a multi-producer fifo of ''capacity__''
+ * elements: the elements, followed by the sequence numbers of the slots.
+ */
+#define FifoT_MPSC_SIZE_OF_BUFFER(T__, SIZE_T__, capacity__)                \
+    (FifoT_MPSC_SEQS_OFFSET_(T__, SIZE_T__, capacity__)                     \
+     + (capacity__) * sizeof(SIZE_T__))
+
+// The offset of the sequence numbers in the buffer, aligned for SIZE_T.
+#define FifoT_MPSC_SEQS_OFFSET_(T__, SIZE_T__, capacity__)                  \
+    (((capacity__) * sizeof(T__) + __alignof__(SIZE_T__) - 1)               \
+     / __alignof__(SIZE_T__) * __alignof__(SIZE_T__))
+
+/**
+ * Reserves ''n'' contiguous slots at the end of the fifo. The slots are not
+ * visible to the consumer until they are committed with #commit().
+ *
+ * @param self a pointer to the fifo itself.
+ * @param n the number of slots to reserve.
+ * @param spans the two spans of uninitialized storage the caller has to
+ *              construct the elements in, the second one is used if the slots
+ *              wrap around the end of the buffer. Unused spans have ''len''
+ *              set to 0 and ''ptr'' set to NULL.
+ *
+ * @return true if the slots have been reserved, false if the fifo has not
+ *         enough room for ''n'' elements.
+ *
+ * @memberof FifoT
+ */
+#define FifoT_MPSC_RESERVE_DECL(T__, N__, SIZE_T__)                         \
+typedef struct {                                                            \
+    T__* ptr;                                                               \
+    SIZE_T__ len;                                                           \
+} N__##_MutSpan;                                                            \
+bool N__##_reserve(N__* self, SIZE_T__ n, N__##_MutSpan spans[2])
+
+/**
+ * Commits the slots previously reserved with #reserve(). All the elements in
+ * the spans must have been constructed. This never waits, the consumer sees
+ * the elements once the reservations before them are committed as well.
+ *
+ * @param self a pointer to the fifo itself.
+ * @param spans the spans returned by #reserve().
+ *
+ * @memberof FifoT
+ */
+#define FifoT_MPSC_COMMIT_DECL(T__, N__, SIZE_T__)                          \
+void N__##_commit(N__* self, N__##_MutSpan const spans[2])
+
+#define FifoT_MPSC_DECLARE(T__, N__, SIZE_T__)                              \
+         FifoT_CTOR_DECL(T__, N__, SIZE_T__);                               \
+         FifoT_DECLARE_COMMON_(T__, N__, SIZE_T__);                         \
+         FifoT_MPSC_RESERVE_DECL(T__, N__, SIZE_T__);                       \
+         FifoT_MPSC_COMMIT_DECL(T__, N__, SIZE_T__)
+
+// Advances ''in__'' over the run of committed slots which starts at it.
+#define FifoT_MPSC_LOAD_IN(SIZE_T__, self__, in__)                          \
+    do                                                                      \
+    {                                                                       \
+        while (FifoT_SPSC_LOAD_ACQUIRE(                                     \
+                   &(self__)->seqs[FifoT_IDX_POW2_WRAP(self__, in__)])      \
+               == (SIZE_T__) ((in__) + 1))                                  \
+        {                                                                   \
+            (in__)++;                                                       \
+        }                                                                   \
+    }                                                                       \
+    while (0)
+
+// Commits the ''n__'' slots reserved at ''start__''. The first slot is the
+// last one released, an acquire of it makes the whole reservation visible.
+#define FifoT_MPSC_PUBLISH(SIZE_T__, self__, start__, n__)                  \
+    do                                                                      \
+    {                                                                       \
+        for (SIZE_T__ i__ = (n__); i__ > 0; --i__)                          \
+        {                                                                   \
+            SIZE_T__ pos__ = (SIZE_T__) ((start__) + i__ - 1);              \
+            FifoT_SPSC_STORE_RELEASE(                                       \
+                &(self__)->seqs[FifoT_IDX_POW2_WRAP(self__, pos__)],        \
+                (SIZE_T__) (pos__ + 1));                                    \
+        }                                                                   \
+    }                                                                       \
+    while (0)
+
+// Reserves up to ''n__'' slots, starting at ''start__''. If ''partial__'' is
+// false, either all of them or none (''n__'' is set to 0) are reserved. This
+// is a compare and swap loop rather than a fetch-add, see FifoT_MPSC_TYPE().
+#define FifoT_MPSC_CLAIM(SIZE_T__, self__, n__, start__, partial__)         \
+    do                                                                      \
+    {                                                                       \
+        SIZE_T__ want__ = (n__);                                            \
+        (start__) = __atomic_load_n(&(self__)->reserved, __ATOMIC_RELAXED); \
+        for (;;)                                                            \
+        {                                                                   \
+            /* the acquire on ''out'' orders the destruction of the */      \
+            /* popped elements before the construction of the new ones */   \
+            SIZE_T__ used__ = (SIZE_T__) ((start__) -                       \
+                FifoT_SPSC_LOAD_ACQUIRE(&(self__)->out));                   \
+            if (used__ > (self__)->capacity)                                \
+            {                                                               \
+                /* ''start__'' is outdated, the consumer is ahead of it */  \
+                (start__) = __atomic_load_n(&(self__)->reserved,            \
+                                            __ATOMIC_RELAXED);              \
+                continue;                                                   \
+            }                                                               \
+            SIZE_T__ room__ = (self__)->capacity - used__;                  \
+            (n__) = (want__ <= room__) ? want__                             \
+                                       : ((partial__) ? room__ : 0);        \
+            if ((n__) == 0 ||                                               \
+                __atomic_compare_exchange_n(&(self__)->reserved,            \
+                                            &(start__),                     \
+                                            (SIZE_T__) ((start__) + (n__)), \
+                                            true,                           \
+                                            __ATOMIC_RELAXED,               \
+                                            __ATOMIC_RELAXED))              \
+            {                                                               \
+                break;                                                      \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    while (0)
+
+#define FifoT_MPSC_CTOR_IMPL(T__,N__, SIZE_T__)                             \
+bool N__##_ctor(N__* self,                                                  \
+                void*    buffer,                                            \
+                SIZE_T__ capacity)                                          \
+{                                                                           \
+    Debug_ASSERT_SELF(self);                                                \
+                                                                            \
+    self->fifo = buffer;                                                    \
+                                                                            \
+    if (self->fifo == NULL || !FifoT_IDX_POW2_IS_VALID_CAPACITY(capacity))  \
+    {                                                                       \
+        return false;                                                       \
+    }                                                                       \
+    /* no slot is committed, a position plus one is never 0 before the */   \
+    /* counters wrap, and after that every slot has been written */         \
+    self->seqs = (SIZE_T__*) ((char*) buffer +                              \
+        FifoT_MPSC_SEQS_OFFSET_(T__, SIZE_T__, capacity));                  \
+    memset(self->seqs, 0, capacity * sizeof(SIZE_T__));                     \
+    self->capacity  = capacity;                                             \
+    self->reserved  = 0;                                                    \
+    self->out       = 0;                                                    \
+    self->inCached  = 0;                                                    \
+    __atomic_thread_fence(__ATOMIC_RELEASE);                                \
+    return true;                                                            \
+}
+
+#define FifoT_MPSC_ISEMPTY_IMPL(T__, N__)                                   \
+bool                                                                        \
+N__##_isEmpty(N__ const* self)                                              \
+{                                                                           \
+    return N__##_getSize(self) == 0;                                        \
+}
+
+#define FifoT_MPSC_GETSIZE_IMPL(T__, N__, SIZE_T__)                         \
+SIZE_T__                                                                    \
+N__##_getSize(N__ const* self)                                              \
+{                                                                           \
+    /* see FifoT_SPSC_GETSIZE_IMPL() */                                     \
+    SIZE_T__ out  = FifoT_SPSC_LOAD_ACQUIRE(&self->out);                    \
+    SIZE_T__ in   = FifoT_SPSC_LOAD_ACQUIRE(&self->reserved);               \
+    SIZE_T__ size = (SIZE_T__) (in - out);                                  \
+    return (size > self->capacity) ? self->capacity : size;                 \
+}
+
+#define FifoT_MPSC_RESERVE_IMPL(T__, N__, SIZE_T__)                         \
+bool                                                                        \
+N__##_reserve(N__* self, SIZE_T__ n, N__##_MutSpan spans[2])                \
+{                                                                           \
+    SIZE_T__ start;                                                         \
+                                                                            \
+    FifoT_MPSC_CLAIM(SIZE_T__, self, n, start, false);                      \
+    FifoT_FILL_SPANS(SIZE_T__, self, spans,                                 \
+                     FifoT_IDX_POW2_WRAP(self, start), n);                  \
+    return n > 0;                                                           \
+}
+
+#define FifoT_MPSC_COMMIT_IMPL(T__, N__, SIZE_T__)                          \
+void                                                                        \
+N__##_commit(N__* self, N__##_MutSpan const spans[2])                       \
+{                                                                           \
+    SIZE_T__ n = spans[0].len + spans[1].len;                               \
+                                                                            \
+    if (n == 0)                                                             \
+    {                                                                       \
+        return;                                                             \
+    }                                                                       \
+    /* the consumer does not pass a pending slot and a reservation is */    \
+    /* less than a capacity ahead of ''out'', so its start follows from */  \
+    /* the position of its first slot */                                    \
+    SIZE_T__ out = __atomic_load_n(&self->out, __ATOMIC_RELAXED);           \
+    SIZE_T__ first = (SIZE_T__) (spans[0].ptr - self->fifo);                \
+    SIZE_T__ start = (SIZE_T__) (out +                                      \
+        FifoT_IDX_POW2_WRAP(self, first - out));                            \
+                                                                            \
+    FifoT_MPSC_PUBLISH(SIZE_T__, self, start, n);                           \
+}
+
+#define FifoT_MPSC_PUSH_IMPL(T__, N__, SIZE_T__)                            \
+bool                                                                        \
+N__##_push(N__* self, T__ const* item)                                      \
+{                                                                           \
+    SIZE_T__ n = 1;                                                         \
+    SIZE_T__ start;                                                         \
+                                                                            \
+    FifoT_MPSC_CLAIM(SIZE_T__, self, n, start, false);                      \
+    if (n == 0)                                                             \
+    {                                                                       \
+        return false;                                                       \
+    }                                                                       \
+    DECL_UNUSED_VAR(const bool ok) =                                        \
+        T__##_ctorCopy(&self->fifo[ FifoT_IDX_POW2_WRAP(self, start) ],     \
+                       item);                                               \
+    Debug_ASSERT(ok);                                                       \
+                                                                            \
+    FifoT_MPSC_PUBLISH(SIZE_T__, self, start, 1);                           \
+    return true;                                                            \
+}
+
+#define FifoT_MPSC_POP_IMPL(T__, N__, SIZE_T__)                             \
+bool                                                                        \
+N__##_pop(N__* self)                                                        \
+{                                                                           \
+    SIZE_T__ out = self->out;                                               \
+                                                                            \
+    if (self->inCached == out)                                              \
+    {                                                                       \
+        FifoT_MPSC_LOAD_IN(SIZE_T__, self, self->inCached);                 \
+        if (self->inCached == out)                                          \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+    }                                                                       \
+    T__##_dtor(&self->fifo[ FifoT_IDX_POW2_WRAP(self, out) ]);              \
+    FifoT_SPSC_STORE_RELEASE(&self->out, (SIZE_T__) (out + 1));             \
+    return true;                                                            \
+}
+
+#define FifoT_MPSC_GETFIRST_IMPL(T__, N__, SIZE_T__)                        \
+T__ const*                                                                  \
+N__##_getFirst(N__ const* self)                                             \
+{                                                                           \
+    SIZE_T__ in = self->inCached;                                           \
+                                                                            \
+    FifoT_MPSC_LOAD_IN(SIZE_T__, self, in);                                 \
+    if (in == self->out)                                                    \
+    {                                                                       \
+        return NULL;                                                        \
+    }                                                                       \
+    else                                                                    \
+    {                                                                       \
+        return &self->fifo[ FifoT_IDX_POW2_WRAP(self, self->out) ];         \
+    }                                                                       \
+}
+
+#define FifoT_MPSC_CONST_APPLY_IMPL(T__, N__, SIZE_T__)                     \
+SIZE_T__                                                                    \
+N__##_constApply(N__ const* self,                                           \
+                    N__##_applyFn fn,                                       \
+                    void* context)                                          \
+{                                                                           \
+    SIZE_T__ i = 0;                                                         \
+    SIZE_T__ in = self->inCached;                                           \
+    bool cont = true;                                                       \
+                                                                            \
+    FifoT_MPSC_LOAD_IN(SIZE_T__, self, in);                                 \
+    SIZE_T__ size = (SIZE_T__) (in - self->out);                            \
+                                                                            \
+    for (i = 0; i < size && cont; ++i)                                      \
+    {                                                                       \
+        SIZE_T__ index = FifoT_IDX_POW2_WRAP(self, self->out + i);          \
+        cont = fn(context, &self->fifo[ index ], i);                        \
+    }                                                                       \
+    return i;                                                               \
+}
+
+#define FifoT_MPSC_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, COPY__)              \
+SIZE_T__                                                                    \
+N__##_pushMany(N__* self, T__ const* src, SIZE_T__ n)                       \
+{                                                                           \
+    SIZE_T__ start;                                                         \
+                                                                            \
+    FifoT_MPSC_CLAIM(SIZE_T__, self, n, start, true);                       \
+    if (n == 0)                                                             \
+    {                                                                       \
+        return 0;                                                           \
+    }                                                                       \
+    SIZE_T__ last = FifoT_IDX_POW2_WRAP(self, start);                       \
+    SIZE_T__ head = self->capacity - last;                                  \
+                                                                            \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    COPY__(T__, &self->fifo[last], src, head);                              \
+    COPY__(T__, &self->fifo[0], src + head, n - head);                      \
+                                                                            \
+    FifoT_MPSC_PUBLISH(SIZE_T__, self, start, n);                           \
+    return n;                                                               \
+}
+
+#define FifoT_MPSC_POP_MANY_IMPL_(T__, N__, SIZE_T__, TAKE__)               \
+SIZE_T__                                                                    \
+N__##_popMany(N__* self, T__* dst, SIZE_T__ n)                              \
+{                                                                           \
+    SIZE_T__ out   = self->out;                                             \
+    SIZE_T__ size  = (SIZE_T__) (self->inCached - out);                     \
+    SIZE_T__ first = FifoT_IDX_POW2_WRAP(self, out);                        \
+    SIZE_T__ head  = self->capacity - first;                                \
+                                                                            \
+    if (n > size)                                                           \
+    {                                                                       \
+        FifoT_MPSC_LOAD_IN(SIZE_T__, self, self->inCached);                 \
+        size = (SIZE_T__) (self->inCached - out);                           \
+        if (n > size)                                                       \
+        {                                                                   \
+            n = size;                                                       \
+        }                                                                   \
+    }                                                                       \
+    if (head > n)                                                           \
+    {                                                                       \
+        head = n;                                                           \
+    }                                                                       \
+    TAKE__(T__, dst, &self->fifo[first], head);                             \
+    TAKE__(T__, dst + head, &self->fifo[0], n - head);                      \
+                                                                            \
+    FifoT_SPSC_STORE_RELEASE(&self->out, (SIZE_T__) (out + n));             \
+    return n;                                                               \
+}
+
+#define FifoT_MPSC_PEEK_SPANS_IMPL(T__, N__, SIZE_T__)                      \
+SIZE_T__                                                                    \
+N__##_peekSpans(N__ const* self, N__##_Span spans[2])                       \
+{                                                                           \
+    SIZE_T__ in = self->inCached;                                           \
+                                                                            \
+    FifoT_MPSC_LOAD_IN(SIZE_T__, self, in);                                 \
+    FifoT_FILL_SPANS(SIZE_T__, self, spans,                                 \
+                     FifoT_IDX_POW2_WRAP(self, self->out),                  \
+                     (SIZE_T__) (in - self->out));                          \
+    return (spans[0].len > 0) + (spans[1].len > 0);                         \
+}
+
+#define FifoT_MPSC_DEFINE_(T__, N__, SIZE_T__, COPY__, TAKE__)              \
+         FifoT_MPSC_CTOR_IMPL(T__, N__, SIZE_T__)                           \
+         FifoT_DTOR_IMPL(T__, N__)                                          \
+         FifoT_MPSC_ISEMPTY_IMPL(T__, N__)                                  \
+         FifoT_SPSC_ISFULL_IMPL(T__, N__)                                   \
+         FifoT_MPSC_GETSIZE_IMPL(T__, N__, SIZE_T__)                        \
+         FifoT_GETCAPACITY_IMPL(T__, N__, SIZE_T__)                         \
+         FifoT_MPSC_RESERVE_IMPL(T__, N__, SIZE_T__)                        \
+         FifoT_MPSC_COMMIT_IMPL(T__, N__, SIZE_T__)                         \
+         FifoT_MPSC_PUSH_IMPL(T__, N__, SIZE_T__)                           \
+         FifoT_MPSC_POP_IMPL(T__, N__, SIZE_T__)                            \
+         FifoT_MPSC_GETFIRST_IMPL(T__, N__, SIZE_T__)                       \
+         FifoT_CLEAR_IMPL(T__, N__, SIZE_T__)                               \
+         FifoT_MPSC_PUSH_MANY_IMPL_(T__, N__, SIZE_T__, COPY__)             \
+         FifoT_MPSC_POP_MANY_IMPL_(T__, N__, SIZE_T__, TAKE__)              \
+         FifoT_MPSC_PEEK_SPANS_IMPL(T__, N__, SIZE_T__)                     \
+         FifoT_MPSC_CONST_APPLY_IMPL(T__, N__, SIZE_T__)
+
+#define FifoT_MPSC_DEFINE(T__, N__, SIZE_T__)                               \
+         FifoT_MPSC_DEFINE_(T__, N__, SIZE_T__,                             \
+                            FifoT_BULK_COPY, FifoT_BULK_TAKE)
+
+#define FifoT_MPSC_DEFINE_TRIVIAL(T__, N__, SIZE_T__)                       \
+         FifoT_MPSC_DEFINE_(T__, N__, SIZE_T__,                             \
+                            FifoT_BULK_COPY_TRIVIAL, FifoT_BULK_TAKE_TRIVIAL)
+
 #endif
 ///@}
@@ -20,6 +20,9 @@
 
 #include "lib_utils/VectorT.h"
 
+#include <stdint.h>
+#include <string.h>
+
 /**
  * @file
  *
@@ -78,16 +81,100 @@
  * @endcode
  * To define all the container methods. This is likely to be done in a C file.
  *
- * @note as of the current version of this component, access is implemented as
- *       a sequential search in the keys stored in the container. This means a
- *       complexity of O(N) where N is the number of the keys. Future versions
- *       of the container may employ more efficient algorithms at the cost of
- *       requiring additional methods for the key (e.g. comparison or hashing
- *       functions).
+ * @note access in MapT is implemented as a sequential search in the keys
+ *       stored in the container. This means a complexity of O(N) where N is
+ *       the number of the keys. If K provides a hashing function, then the
+ *       hashed flavour of the container (see #MapT_DECLARE_HASHED()) can be
+ *       used instead, it offers the same interface with O(1) average access.
+ *       If K is ordered, the sorted flavour (see #MapT_DECLARE_SORTED())
+ *       offers O(log N) access and ordered iteration without extra memory.
+ *       If the values are large, the SoA flavour (see #MapT_DECLARE_SOA())
+ *       keeps the sequential search on a dense array of keys. For integer
+ *       keys this search compares several keys at once, see
+ *       #MapT_DEFINE_SOA_INTKEY().
+ *
+ * If LIB_UTILS_STATS is defined, every map counts its lookups and how many
+ * keys they compare, see #MapT_getStats(). Otherwise the counters are not
+ * compiled in.
  */
 
 #define MapT_SIZE_OF_BUFFER(N__, numItems)  (sizeof(N__##_Item) * numItems)
 
+#if defined(LIB_UTILS_STATS)
+/**
+ * Counters of the lookups of a map, see #MapT_getStats(). They are reset by
+ * the constructors only.
+ */
+typedef struct
+{
+    size_t lookups;     ///< the calls of #MapT_getIndexOf()
+    size_t misses;      ///< the lookups of keys not in the map
+    size_t probes;      ///< the keys compared by all the lookups
+    size_t maxProbe;    ///< the keys compared by the longest lookup
+}
+MapT_Stats;
+
+/*
+ * The lookups take a const map, so several threads may search the same map
+ * at the same time. The counters are relaxed atomics: they do not order
+ * anything, they only make such concurrent lookups free of data races.
+ */
+static inline void
+MapT_countLookup_(MapT_Stats* stats, size_t probes, bool found)
+{
+    __atomic_fetch_add(&stats->lookups, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->misses, !found, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&stats->probes, probes, __ATOMIC_RELAXED);
+
+    size_t max = __atomic_load_n(&stats->maxProbe, __ATOMIC_RELAXED);
+    while (probes > max &&
+           !__atomic_compare_exchange_n(&stats->maxProbe, &max, probes, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+        // 'max' has been reloaded, try again
+    }
+}
+
+static inline MapT_Stats
+MapT_loadStats_(MapT_Stats const* stats)
+{
+    MapT_Stats copy;
+
+    copy.lookups    = __atomic_load_n(&stats->lookups, __ATOMIC_RELAXED);
+    copy.misses     = __atomic_load_n(&stats->misses, __ATOMIC_RELAXED);
+    copy.probes     = __atomic_load_n(&stats->probes, __ATOMIC_RELAXED);
+    copy.maxProbe   = __atomic_load_n(&stats->maxProbe, __ATOMIC_RELAXED);
+    return copy;
+}
+
+#   define MapT_STATS_FIELD_            MapT_Stats stats_;
+#   define MapT_STATS_(stmt__)          do { stmt__; } while (0)
+#   define MapT_GETSTATS_DECL_(K__,V__,N__)                                 \
+    MapT_Stats N__##_getStats(N__ const* self);
+#   define MapT_GETSTATS_IMPL_(K__,V__,N__)                                 \
+    MapT_Stats N__##_getStats(N__ const* self)                              \
+    {                                                                       \
+        return MapT_loadStats_(&self->stats_);                              \
+    }
+#else
+#   define MapT_STATS_FIELD_
+#   define MapT_STATS_(stmt__)          ((void) 0)
+#   define MapT_GETSTATS_DECL_(K__,V__,N__)
+#   define MapT_GETSTATS_IMPL_(K__,V__,N__)
+#endif
+
+#define MapT_STATS_INIT_(self__)                                            \
+    MapT_STATS_(memset(&(self__)->stats_, 0, sizeof((self__)->stats_)))
+
+/*
+ * getIndexOf() takes a const map, the counters are updated nonetheless. A map
+ * is never defined const, its constructors take a mutable one, so the cast
+ * is well-defined. See MapT_countLookup_() for concurrent lookups.
+ */
+#define MapT_STATS_LOOKUP_(self__, probes__, found__)                       \
+    MapT_STATS_(MapT_countLookup_((MapT_Stats*) &(self__)->stats_,          \
+                                  (probes__), (found__)))
+
 /**
  * @fn bool MapT_ctor(MapT* self, size_t capacity)
  *
@@ -312,6 +399,116 @@
 #define MapT_CLEAR_DECL(K__,V__,N__)     \
     void N__##_clear(N__* self)
 
+/**
+ * @fn MapT_Stats MapT_getStats(MapT const* self)
+ *
+ * Retrieves the counters of the lookups, available only if LIB_UTILS_STATS
+ * is defined. The mean length of a lookup is 'probes' / 'lookups'. The sorted
+ * flavour counts the depth of its binary search as the length of a lookup.
+ * Concurrent lookups of the same map are counted without data races, in
+ * that case the copy is not a consistent snapshot of all the counters.
+ *
+ * @param self a pointer to the container.
+ * @return a copy of the counters.
+ */
+
+/**
+ * @fn MapT_Item const* MapT_getData(MapT const* self)
+ *
+ * Retrieves the associations as a contiguous array of #MapT_getSize() items,
+ * each with a 'key' and a 'value' member. The item at position 'index' holds
+ * the association with the same index, the reference is valid as long as the
+ * one returned by #MapT_getKeyAt().
+ *
+ * @param self a pointer to the container.
+ * @return a pointer to the first association.
+ */
+#define MapT_GETDATA_DECL(K__,V__,N__)       \
+    N__##_Item const* N__##_getData(N__ const* self)
+
+/**
+ * @fn int MapT_constApply(MapT const* self, MapT_applyFn fn, void* context)
+ *
+ * Applies a given function to all the associations, in the order of their
+ * indexes.
+ *
+ * @param self a pointer to the container.
+ * @param fn the function to apply, it has the signature
+ *           bool fn(void* context, K const* key, V const* value, int index),
+ *           where the return value has the "continue" semantic.
+ * @param context a context pointer that is passed along with each
+ *                association.
+ * @return the number of associations processed.
+ */
+#define MapT_CONST_APPLY_DECL(K__,V__,N__)                                  \
+    typedef bool (*N__##_applyFn)(void* context,                            \
+                                  K__ const* key,                           \
+                                  V__ const* value,                         \
+                                  int index);                               \
+    int N__##_constApply(N__ const* self, N__##_applyFn fn, void* context)
+
+/**
+ * @fn int MapT_apply(MapT* self, MapT_mutApplyFn fn, void* context)
+ *
+ * Same as #MapT_constApply(), but the function can modify the values in
+ * place. The keys can not be modified and the function must not insert or
+ * remove associations.
+ *
+ * @param self a pointer to the container.
+ * @param fn the function to apply, it has the signature
+ *           bool fn(void* context, K const* key, V* value, int index).
+ * @param context a context pointer that is passed along with each
+ *                association.
+ * @return the number of associations processed.
+ */
+#define MapT_APPLY_DECL(K__,V__,N__)                                        \
+    typedef bool (*N__##_mutApplyFn)(void* context,                         \
+                                     K__ const* key,                        \
+                                     V__* value,                            \
+                                     int index);                            \
+    int N__##_apply(N__* self, N__##_mutApplyFn fn, void* context)
+
+/**
+ * @fn int MapT_constApplyRange(MapT const* self, int begin, int end,
+ *                              MapT_applyFn fn, void* context)
+ *
+ * Same as #MapT_constApply(), limited to the associations with an index in
+ * [begin, end), an empty or inverted range processes none. Disjoint ranges
+ * can be processed by several threads, as long as none of them changes the
+ * container itself.
+ *
+ * @param self a pointer to the container.
+ * @param begin the index of the first association to process.
+ * @param end the index after the last association to process, it is an error
+ *        to specify a range beyond #MapT_getSize().
+ * @param fn the function to apply, see #MapT_constApply().
+ * @param context a context pointer that is passed along with each
+ *                association.
+ * @return the number of associations processed.
+ */
+#define MapT_CONST_APPLY_RANGE_DECL(K__,V__,N__)                            \
+    int N__##_constApplyRange(N__ const* self, int begin, int end,          \
+                              N__##_applyFn fn, void* context)
+
+/**
+ * @fn int MapT_applyRange(MapT* self, int begin, int end,
+ *                         MapT_mutApplyFn fn, void* context)
+ *
+ * Same as #MapT_constApplyRange(), but the function can modify the values in
+ * place, see #MapT_apply().
+ *
+ * @param self a pointer to the container.
+ * @param begin the index of the first association to process.
+ * @param end the index after the last association to process.
+ * @param fn the function to apply, see #MapT_apply().
+ * @param context a context pointer that is passed along with each
+ *                association.
+ * @return the number of associations processed.
+ */
+#define MapT_APPLY_RANGE_DECL(K__,V__,N__)                                  \
+    int N__##_applyRange(N__* self, int begin, int end,                     \
+                         N__##_mutApplyFn fn, void* context)
+
 /**
  * MapT template declaration macro. This macro has to be used to declare the
  * associative container. Where this macro will be instanced there will be the
@@ -340,8 +537,10 @@
     typedef struct                                                          \
     {                                                                       \
         N__##_Impl mapImpl;                                                 \
+        MapT_STATS_FIELD_                                                   \
     }                                                                       \
     N__;                                                                    \
+    MapT_GETSTATS_DECL_(K__,V__,N__)                                        \
     MapT_CTOR_DECL(K__,V__,N__);                                            \
     MapT_CTOR_STATIC_DECL(K__,V__,N__);                                     \
     MapT_CTOR_COPY_DECL(K__,V__,N__);                                       \
@@ -356,12 +555,18 @@
     MapT_FIND_DECL(K__,V__,N__);                                            \
     MapT_ISEMPTY_DECL(K__,V__,N__);                                         \
     MapT_GETSIZE_DECL(K__, V__, N__);                                       \
-    MapT_CLEAR_DECL(K__,V__,N__);
+    MapT_CLEAR_DECL(K__,V__,N__);                                           \
+    MapT_GETDATA_DECL(K__,V__,N__);                                         \
+    MapT_CONST_APPLY_DECL(K__,V__,N__);                                     \
+    MapT_APPLY_DECL(K__,V__,N__);                                           \
+    MapT_CONST_APPLY_RANGE_DECL(K__,V__,N__);                               \
+    MapT_APPLY_RANGE_DECL(K__,V__,N__);
 
 #define MapT_CTOR_IMPL(K__,V__,N__)                                         \
     bool                                                                    \
     N__##_ctor(N__* self, size_t capacity)                                  \
     {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
         return N__##_Impl_ctor(&self->mapImpl, capacity);                   \
     }
 
@@ -369,6 +574,7 @@
     bool                                                                    \
     N__##_ctorStatic(N__* self, void* buffer, size_t capacity)              \
     {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
         return N__##_Impl_ctorStatic(&self->mapImpl, buffer, capacity);     \
     }
 
@@ -376,6 +582,7 @@
     bool								    \
     N__##_ctorCopy(N__* self, N__ const* a)                                 \
     {									    \
+        MapT_STATS_INIT_(self);                                             \
 	    return N__##_Impl_ctorCopy(&self->mapImpl, &a->mapImpl);        \
     }
 
@@ -395,24 +602,29 @@
         {                                                                   \
             return false;                                                   \
         }                                                                   \
-        N__##_Item item;                                                    \
-        K__##_ctorCopy(&item.key, key);                                     \
-        V__##_ctorCopy(&item.value, value);                                 \
-        return N__##_Impl_pushBack(&self->mapImpl, item);                   \
+        N__##_Item* item = N__##_Impl_emplaceBack(&self->mapImpl);          \
+        if (item == NULL)                                                   \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        if (K__##_ctorCopy(&item->key, key))                                \
+        {                                                                   \
+            if (V__##_ctorCopy(&item->value, value))                        \
+            {                                                               \
+                return true;                                                \
+            }                                                               \
+            K__##_dtor(&item->key);                                         \
+        }                                                                   \
+        N__##_Impl_cancelEmplace(&self->mapImpl);                           \
+        return false;                                                       \
     }
 
 #define MapT_REMOVEAT_IMPL(K__,V__,N__)                                     \
     void N__##_removeAt(N__* self, int index)                               \
     {                                                                       \
         Debug_ASSERT(index >= 0);                                           \
-        int size = N__##_Impl_getSize(&self->mapImpl);                      \
-        Debug_ASSERT(index < size);                                         \
-        if (index !=  size-1)                                               \
-        {                                                                   \
-            N__##_Item tmp = N__##_Impl_getElementAt(&self->mapImpl, size-1);\
-            N__##_Impl_replaceElementAt(&self->mapImpl, index, tmp);        \
-        }                                                                   \
-        N__##_Impl_popBack(&self->mapImpl);                                 \
+        Debug_ASSERT(index < N__##_getSize(self));                          \
+        N__##_Impl_removeAtSwap(&self->mapImpl, index);                     \
     }
 
 
@@ -444,9 +656,11 @@
             item = N__##_Impl_getPtrToElementAt(&self->mapImpl, i);         \
             if (K__##_isEqual(key, &item->key))                             \
             {                                                               \
+                MapT_STATS_LOOKUP_(self, i + 1, true);                      \
                 return i;                                                   \
             }                                                               \
         }                                                                   \
+        MapT_STATS_LOOKUP_(self, size, false);                              \
         return -1;                                                          \
     }
 
@@ -464,25 +678,9 @@
                            int index,                                       \
                            V__ const* newValue)                             \
     {                                                                       \
-        N__##_Item const* item;                                             \
-        item = N__##_Impl_getPtrToElementAt(&self->mapImpl, index);         \
-        Debug_ASSERT(item >= 0);                                            \
-        N__##_Item newItem;                                                 \
-        if (K__##_ctorCopy(&newItem.key, &item->key))                       \
-        {                                                                   \
-            if (V__##_ctorCopy(&newItem.value, newValue))                   \
-            {                                                               \
-                if (N__##_Impl_replaceElementAt(&self->mapImpl,             \
-                                                 index,                     \
-                                                 newItem))                  \
-                {                                                           \
-                    return true;                                            \
-                }                                                           \
-                V__##_dtor(&newItem.value);                                 \
-            }                                                               \
-            K__##_dtor(&newItem.key);                                       \
-        }                                                                   \
-        return false;                                                       \
+        N__##_Item* item;                                                   \
+        item = N__##_Impl_getMutPtrAt(&self->mapImpl, index);               \
+        return V__##_assign(&item->value, newValue);                        \
     }
 
 #define MapT_GETKEYAT_IMPL(K__, V__, N__)                                   \
@@ -512,6 +710,45 @@
         N__##_Impl_clear(&self->mapImpl);                                   \
     }
 
+#define MapT_GETDATA_IMPL(K__,V__,N__)                                      \
+    N__##_Item const* N__##_getData(N__ const* self)                        \
+    {                                                                       \
+        return N__##_Impl_getData(&self->mapImpl);                          \
+    }
+
+// The range apply functions, CONST__ is either const or empty.
+#define MapT_APPLY_RANGE_IMPL_(K__,V__,N__,NAME__,FN__,CONST__)             \
+    int N__##_##NAME__(N__ CONST__* self, int begin, int end,               \
+                       N__##_##FN__ fn, void* context)                      \
+    {                                                                       \
+        Debug_ASSERT(begin >= 0);                                           \
+        Debug_ASSERT(end <= N__##_getSize(self));                           \
+        N__##_Item CONST__* items = self->mapImpl.vector_;                  \
+        int i = begin;                                                      \
+        bool cont = true;                                                   \
+                                                                            \
+        for (; i < end && cont; ++i)                                        \
+        {                                                                   \
+            cont = fn(context, &items[i].key, &items[i].value, i);          \
+        }                                                                   \
+        return i - begin;                                                   \
+    }
+
+#define MapT_APPLY_IMPL(K__,V__,N__)                                        \
+    MapT_APPLY_RANGE_IMPL_(K__,V__,N__,constApplyRange,applyFn,const)       \
+    MapT_APPLY_RANGE_IMPL_(K__,V__,N__,applyRange,mutApplyFn,)              \
+                                                                            \
+    int N__##_constApply(N__ const* self, N__##_applyFn fn, void* context)  \
+    {                                                                       \
+        return N__##_constApplyRange(self, 0, N__##_getSize(self),          \
+                                     fn, context);                          \
+    }                                                                       \
+                                                                            \
+    int N__##_apply(N__* self, N__##_mutApplyFn fn, void* context)          \
+    {                                                                       \
+        return N__##_applyRange(self, 0, N__##_getSize(self), fn, context); \
+    }
+
 #define MapT_Item_ctorCopy_IMPL(K__,V__,N__)                                \
     bool N__##_Item_ctorCopy(N__##_Item* self, N__##_Item const* src)       \
     {                                                                       \
@@ -585,8 +822,1286 @@
     MapT_FIND_IMPL(K__,V__,N__)                 \
     MapT_ISEMPTY_IMPL(K__,V__,N__)              \
     MapT_GETSIZE_IMPL(K__, V__, N__)            \
-    MapT_CLEAR_IMPL(K__,V__,N__)
+    MapT_CLEAR_IMPL(K__,V__,N__)                \
+    MapT_GETDATA_IMPL(K__,V__,N__)              \
+    MapT_APPLY_IMPL(K__,V__,N__)                \
+    MapT_GETSTATS_IMPL_(K__,V__,N__)
+
+/**
+ * Hashed map container template.
+ *
+ * The hashed flavour provides the very same interface of MapT, so callers can
+ * switch from one to the other just by changing the declaration and definition
+ * macros. Associations are still kept densely packed in a VectorT, therefore
+ * indexes in the range [0, getSize()) are valid for #MapT_getKeyAt() and
+ * #MapT_getValueAt() exactly as they are for MapT. On top of that an open
+ * addressing (linear probing) hash index maps keys to the association index,
+ * making #MapT_getIndexOf(), #MapT_find(), #MapT_insert() and #MapT_remove()
+ * O(1) on average.
+ *
+ * The hash index lives inside the caller's buffer: every item embeds two
+ * index slots, so MapT_SIZE_OF_BUFFER(N, capacity) grows by two ints per item
+ * compared to MapT, and the buffer given to #MapT_ctorStatic() holds both the
+ * associations and an index of 2*capacity slots, i.e. the load factor never
+ * exceeds 1/2.
+ *
+ * In addition to the methods required by MapT, K must define:
+ *
+ * @code
+ * uint32_t K_hash(K const* key);
+ * @endcode
+ *
+ * K_hash() must return the same value for keys that are equal according to
+ * K_isEqual(). The returned value is scrambled by the container before use,
+ * so a simple hash (e.g. the identity for integer keys) is good enough.
+ *
+ * @code
+ * MapT_DECLARE_HASHED(K,V,N);
+ * MapT_DEFINE_HASHED(K,V,N);
+ * @endcode
+ *
+ * @note the index of an association may change on #MapT_remove() and
+ *       #MapT_removeAt() exactly as it does for MapT.
+ */
+
+#define MapT_HASHED_EMPTY_SLOT  (-1)
+
+// Maps a hash to a slot in [0, numSlots) with a multiply instead of a modulo.
+// The multiplication by the golden ratio spreads the low bits of weak hashes
+// into the high bits used by the range reduction.
+#define MapT_HASHED_BUCKET(hash__, numSlots__)                              \
+    ((size_t) (((uint64_t) ((uint32_t) (hash__) * 0x9E3779B1u)              \
+                * (numSlots__)) >> 32))
+
+#define MapT_HASHED_NUM_SLOTS(self__)   (2 * (self__)->mapImpl.size_)
+
+#define MapT_HASHED_SLOT(self__, slot__)                                    \
+    ((self__)->mapImpl.vector_[(slot__) >> 1].slots_[(slot__) & 1])
+
+/**
+ * Hashed MapT template declaration macro, see #MapT_DECLARE().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+#define MapT_DECLARE_HASHED(K__, V__, N__)                                  \
+    typedef struct                                                          \
+    {                                                                       \
+        K__ key;                                                            \
+        V__ value;                                                          \
+        int slots_[2];                                                      \
+    }                                                                       \
+    N__##_Item;                                                             \
+    void N__##_Item_dtor(N__##_Item* self);                                 \
+    bool N__##_Item_ctorCopy(N__##_Item* self,                              \
+                              N__##_Item const* orig);                      \
+    bool N__##_Item_assign(N__##_Item* self,                                \
+                            N__##_Item const* orig);                        \
+    bool N__##_Item_ctorMove(N__##_Item* self,                              \
+                            N__##_Item const* orig);                        \
+    VectorT_DECLARE(N__##_Item, N__##_Impl, size_t);                        \
+    typedef struct                                                          \
+    {                                                                       \
+        N__##_Impl mapImpl;                                                 \
+        MapT_STATS_FIELD_                                                   \
+    }                                                                       \
+    N__;                                                                    \
+    MapT_GETSTATS_DECL_(K__,V__,N__)                                        \
+    MapT_CTOR_DECL(K__,V__,N__);                                            \
+    MapT_CTOR_STATIC_DECL(K__,V__,N__);                                     \
+    MapT_CTOR_COPY_DECL(K__,V__,N__);                                       \
+    MapT_DTOR_DECL(K__,V__,N__);                                            \
+    MapT_INSERT_DECL(K__,V__,N__);                                          \
+    MapT_REMOVEAT_DECL(K__,V__,N__);                                        \
+    MapT_REMOVE_DECL(K__,V__,N__);                                          \
+    MapT_GETINDEXOF_DECL(K__,V__,N__);                                      \
+    MapT_GETVALUEAT_DECL(K__,V__,N__);                                      \
+    MapT_SETVALUEAT_DECL(K__,V__,N__);                                      \
+    MapT_GETKEYAT_DECL(K__, V__, N__);                                      \
+    MapT_FIND_DECL(K__,V__,N__);                                            \
+    MapT_ISEMPTY_DECL(K__,V__,N__);                                         \
+    MapT_GETSIZE_DECL(K__, V__, N__);                                       \
+    MapT_CLEAR_DECL(K__,V__,N__);                                           \
+    MapT_GETDATA_DECL(K__,V__,N__);                                         \
+    MapT_CONST_APPLY_DECL(K__,V__,N__);                                     \
+    MapT_APPLY_DECL(K__,V__,N__);                                           \
+    MapT_CONST_APPLY_RANGE_DECL(K__,V__,N__);                               \
+    MapT_APPLY_RANGE_DECL(K__,V__,N__);
+
+#define MapT_HASHED_PRIVATE_IMPL(K__,V__,N__)                               \
+    static size_t                                                           \
+    N__##_findSlotOf(N__ const* self, int index)                            \
+    {                                                                       \
+        size_t numSlots = MapT_HASHED_NUM_SLOTS(self);                      \
+        size_t slot = MapT_HASHED_BUCKET(                                   \
+                        K__##_hash(&self->mapImpl.vector_[index].key),      \
+                        numSlots);                                          \
+        while (MapT_HASHED_SLOT(self, slot) != index)                       \
+        {                                                                   \
+            Debug_ASSERT(MapT_HASHED_SLOT(self, slot) !=                    \
+                         MapT_HASHED_EMPTY_SLOT);                           \
+            if (++slot == numSlots)                                         \
+            {                                                               \
+                slot = 0;                                                   \
+            }                                                               \
+        }                                                                   \
+        return slot;                                                        \
+    }                                                                       \
+                                                                            \
+    static void                                                             \
+    N__##_addSlotOf(N__* self, int index)                                   \
+    {                                                                       \
+        size_t numSlots = MapT_HASHED_NUM_SLOTS(self);                      \
+        size_t slot = MapT_HASHED_BUCKET(                                   \
+                        K__##_hash(&self->mapImpl.vector_[index].key),      \
+                        numSlots);                                          \
+        while (MapT_HASHED_SLOT(self, slot) != MapT_HASHED_EMPTY_SLOT)      \
+        {                                                                   \
+            if (++slot == numSlots)                                         \
+            {                                                               \
+                slot = 0;                                                   \
+            }                                                               \
+        }                                                                   \
+        MapT_HASHED_SLOT(self, slot) = index;                               \
+    }                                                                       \
+                                                                            \
+    /* Backward shift deletion, it keeps probe sequences without holes so */\
+    /* that no tombstones are needed. */                                    \
+    static void                                                             \
+    N__##_delSlot(N__* self, size_t slot)                                   \
+    {                                                                       \
+        size_t numSlots = MapT_HASHED_NUM_SLOTS(self);                      \
+        size_t next = slot;                                                 \
+                                                                            \
+        MapT_HASHED_SLOT(self, slot) = MapT_HASHED_EMPTY_SLOT;              \
+        for (;;)                                                            \
+        {                                                                   \
+            if (++next == numSlots)                                         \
+            {                                                               \
+                next = 0;                                                   \
+            }                                                               \
+            int index = MapT_HASHED_SLOT(self, next);                       \
+            if (index == MapT_HASHED_EMPTY_SLOT)                            \
+            {                                                               \
+                return;                                                     \
+            }                                                               \
+            size_t home = MapT_HASHED_BUCKET(                               \
+                            K__##_hash(&self->mapImpl.vector_[index].key),  \
+                            numSlots);                                      \
+            /* leave the entry where it is if its home slot lies */         \
+            /* cyclically in (slot, next] */                                \
+            if ((slot < next) ? (slot < home && home <= next)               \
+                              : (slot < home || home <= next))              \
+            {                                                               \
+                continue;                                                   \
+            }                                                               \
+            MapT_HASHED_SLOT(self, slot) = index;                           \
+            MapT_HASHED_SLOT(self, next) = MapT_HASHED_EMPTY_SLOT;          \
+            slot = next;                                                    \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    static void                                                             \
+    N__##_rehash(N__* self)                                                 \
+    {                                                                       \
+        size_t numSlots = MapT_HASHED_NUM_SLOTS(self);                      \
+        int size = N__##_Impl_getSize(&self->mapImpl);                      \
+        for (size_t slot = 0; slot < numSlots; ++slot)                      \
+        {                                                                   \
+            MapT_HASHED_SLOT(self, slot) = MapT_HASHED_EMPTY_SLOT;          \
+        }                                                                   \
+        for (int i = 0; i < size; ++i)                                      \
+        {                                                                   \
+            N__##_addSlotOf(self, i);                                       \
+        }                                                                   \
+    }
+
+#define MapT_HASHED_CTOR_IMPL(K__,V__,N__)                                  \
+    bool                                                                    \
+    N__##_ctor(N__* self, size_t capacity)                                  \
+    {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
+        if (!N__##_Impl_ctor(&self->mapImpl, capacity))                     \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        N__##_rehash(self);                                                 \
+        return true;                                                        \
+    }
+
+#define MapT_HASHED_CTOR_STATIC_IMPL(K__,V__,N__)                           \
+    bool                                                                    \
+    N__##_ctorStatic(N__* self, void* buffer, size_t capacity)              \
+    {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
+        if (!N__##_Impl_ctorStatic(&self->mapImpl, buffer, capacity))       \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        N__##_rehash(self);                                                 \
+        return true;                                                        \
+    }
+
+#define MapT_HASHED_CTOR_COPY_IMPL(K__,V__,N__)                             \
+    bool                                                                    \
+    N__##_ctorCopy(N__* self, N__ const* a)                                 \
+    {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
+        if (!N__##_Impl_ctorCopy(&self->mapImpl, &a->mapImpl))              \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        N__##_rehash(self);                                                 \
+        return true;                                                        \
+    }
+
+#define MapT_HASHED_INSERT_IMPL(K__,V__,N__)                                \
+    bool N__##_insert(N__* self,                                            \
+                       K__ const* key,                                      \
+                       V__ const* value)                                    \
+    {                                                                       \
+        if (N__##_find(self, key))                                          \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        size_t capacity = self->mapImpl.size_;                              \
+        N__##_Item* item = N__##_Impl_emplaceBack(&self->mapImpl);          \
+        if (item == NULL)                                                   \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        bool retval = false;                                                \
+        if (K__##_ctorCopy(&item->key, key))                                \
+        {                                                                   \
+            retval = V__##_ctorCopy(&item->value, value);                   \
+            if (!retval)                                                    \
+            {                                                               \
+                K__##_dtor(&item->key);                                     \
+            }                                                               \
+        }                                                                   \
+        if (!retval)                                                        \
+        {                                                                   \
+            N__##_Impl_cancelEmplace(&self->mapImpl);                       \
+        }                                                                   \
+        if (self->mapImpl.size_ != capacity)                                \
+        {                                                                   \
+            /* the vector has grown, so has the number of slots */          \
+            N__##_rehash(self);                                             \
+        }                                                                   \
+        else if (retval)                                                    \
+        {                                                                   \
+            N__##_addSlotOf(self, N__##_Impl_getSize(&self->mapImpl) - 1);  \
+        }                                                                   \
+        return retval;                                                      \
+    }
+
+#define MapT_HASHED_REMOVEAT_IMPL(K__,V__,N__)                              \
+    void N__##_removeAt(N__* self, int index)                               \
+    {                                                                       \
+        Debug_ASSERT(index >= 0);                                           \
+        int size = N__##_Impl_getSize(&self->mapImpl);                      \
+        Debug_ASSERT(index < size);                                         \
+        N__##_delSlot(self, N__##_findSlotOf(self, index));                 \
+        if (index !=  size-1)                                               \
+        {                                                                   \
+            /* the last item fills the hole, redirect its slot */           \
+            size_t slot = N__##_findSlotOf(self, size-1);                   \
+            MapT_HASHED_SLOT(self, slot) = index;                           \
+        }                                                                   \
+        /* the item moves key and value only, the slots stay in place */    \
+        N__##_Impl_removeAtSwap(&self->mapImpl, index);                     \
+    }
+
+#define MapT_HASHED_GETINDEXOF_IMPL(K__,V__,N__)                            \
+    int N__##_getIndexOf(N__ const* self, K__ const* key)                   \
+    {                                                                       \
+        size_t numSlots = MapT_HASHED_NUM_SLOTS(self);                      \
+        if (numSlots == 0)                                                  \
+        {                                                                   \
+            MapT_STATS_LOOKUP_(self, 0, false);                             \
+            return -1;                                                      \
+        }                                                                   \
+        size_t slot = MapT_HASHED_BUCKET(K__##_hash(key), numSlots);        \
+        DECL_UNUSED_VAR(const size_t home) = slot;                          \
+        for (;;)                                                            \
+        {                                                                   \
+            int index = MapT_HASHED_SLOT(self, slot);                       \
+            if (index == MapT_HASHED_EMPTY_SLOT)                            \
+            {                                                               \
+                /* the empty slot does not compare a key */                 \
+                MapT_STATS_LOOKUP_(self,                                    \
+                                   (slot + numSlots - home) % numSlots,     \
+                                   false);                                  \
+                return -1;                                                  \
+            }                                                               \
+            if (K__##_isEqual(key, &self->mapImpl.vector_[index].key))      \
+            {                                                               \
+                MapT_STATS_LOOKUP_(self,                                    \
+                                   (slot + numSlots - home) % numSlots + 1, \
+                                   true);                                   \
+                return index;                                               \
+            }                                                               \
+            if (++slot == numSlots)                                         \
+            {                                                               \
+                slot = 0;                                                   \
+            }                                                               \
+        }                                                                   \
+    }
+
+#define MapT_HASHED_CLEAR_IMPL(K__,V__,N__)                                 \
+    void N__##_clear(N__* self)                                             \
+    {                                                                       \
+        N__##_Impl_clear(&self->mapImpl);                                   \
+        N__##_rehash(self);                                                 \
+    }
+
+/**
+ * Hashed MapT template definition macro, see #MapT_DEFINE().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+
+#define MapT_DEFINE_HASHED(K__,V__,N__)         \
+    VectorT_DEFINE(N__##_Item, N__##_Impl, size_t)\
+    MapT_Item_dtor_IMPL(K__,V__,N__)            \
+    MapT_Item_ctorCopy_IMPL(K__,V__,N__)        \
+    MapT_Item_assign_IMPL(K__,V__,N__)          \
+    MapT_Item_ctorMove_IMPL(K__,V__,N__)        \
+    MapT_HASHED_PRIVATE_IMPL(K__,V__,N__)       \
+    MapT_HASHED_CTOR_IMPL(K__,V__,N__)          \
+    MapT_HASHED_CTOR_STATIC_IMPL(K__,V__,N__)   \
+    MapT_HASHED_CTOR_COPY_IMPL(K__,V__,N__)     \
+    MapT_DTOR_IMPL(K__,V__,N__)                 \
+    MapT_HASHED_INSERT_IMPL(K__,V__,N__)        \
+    MapT_HASHED_REMOVEAT_IMPL(K__,V__,N__)      \
+    MapT_REMOVE_IMPL(K__,V__,N__)               \
+    MapT_HASHED_GETINDEXOF_IMPL(K__,V__,N__)    \
+    MapT_GETVALUEAT_IMPL(K__,V__,N__)           \
+    MapT_SETVALUEAT_IMPL(K__,V__,N__)           \
+    MapT_GETKEYAT_IMPL(K__, V__, N__)           \
+    MapT_FIND_IMPL(K__,V__,N__)                 \
+    MapT_ISEMPTY_IMPL(K__,V__,N__)              \
+    MapT_GETSIZE_IMPL(K__, V__, N__)            \
+    MapT_HASHED_CLEAR_IMPL(K__,V__,N__)         \
+    MapT_GETDATA_IMPL(K__,V__,N__)              \
+    MapT_APPLY_IMPL(K__,V__,N__)                \
+    MapT_GETSTATS_IMPL_(K__,V__,N__)
+
+
+/**
+ * Sorted map container template.
+ *
+ * The sorted flavour provides the interface of MapT, with the associations
+ * kept in the VectorT ordered by key. Iterating the indexes [0, getSize())
+ * visits the keys in ascending order and #MapT_getIndexOf() and #MapT_find()
+ * are binary searches, i.e. O(log N). #MapT_insert() and #MapT_remove() keep
+ * the order by moving the following associations, i.e. they are O(N) moves
+ * but only O(log N) comparisons. The layout is the one of MapT, so the memory
+ * usage and #MapT_ctorStatic() are unchanged.
+ *
+ * In addition to the methods required by MapT, K must define:
+ *
+ * @code
+ * int K_compare(K const* a, K const* b);
+ * @endcode
+ *
+ * K_compare() returns a negative value if 'a' sorts before 'b', zero if they
+ * are equal and a positive value otherwise. Keys are compared with K_compare()
+ * only, K_isEqual() is not used by this flavour.
+ *
+ * @code
+ * MapT_DECLARE_SORTED(K,V,N);
+ * MapT_DEFINE_SORTED(K,V,N);
+ * @endcode
+ *
+ * @note the index of an association changes on every #MapT_insert() of a
+ *       lower key and every removal of an association with a lower key.
+ */
+
+/**
+ * @fn int MapT_lowerBound(MapT const* self, K const* key)
+ *
+ * Range query on a sorted map. The associations in [lowerBound(a),
+ * upperBound(b)) are the ones with a key in the closed interval [a, b].
+ *
+ * @param self a pointer to the container.
+ * @param key the key to look up.
+ * @return the index of the first association with a key not lower than 'key',
+ *         #MapT_getSize() if there is none.
+ */
+#define MapT_LOWERBOUND_DECL(K__,V__,N__)   \
+    int N__##_lowerBound(N__ const* self, K__ const* key)
+
+/**
+ * @fn int MapT_upperBound(MapT const* self, K const* key)
+ *
+ * Range query on a sorted map, see #MapT_lowerBound().
+ *
+ * @param self a pointer to the container.
+ * @param key the key to look up.
+ * @return the index of the first association with a key greater than 'key',
+ *         #MapT_getSize() if there is none.
+ */
+#define MapT_UPPERBOUND_DECL(K__,V__,N__)   \
+    int N__##_upperBound(N__ const* self, K__ const* key)
+
+/**
+ * @fn int MapT_insertMany(MapT* self, K const* keys, V const* values,
+ *                         size_t count)
+ *
+ * Bulk insertion in a sorted map. The new associations are copied at the end
+ * of the container, sorted once and then merged in place with the existing
+ * ones, which is O((N + count) log(N + count)) instead of the O(N * count) of
+ * repeated #MapT_insert() calls. No temporary memory is needed besides the
+ * room for the new associations in the container.
+ *
+ * As for #MapT_insert(), keys already in the container are skipped. If a key
+ * is repeated in 'keys' then only one of its associations is inserted.
+ *
+ * @param self a pointer to the container.
+ * @param keys the keys to insert.
+ * @param values the values to insert, 'values[i]' is associated to 'keys[i]'.
+ * @param count the number of elements in 'keys' and 'values'.
+ * @return the number of associations added to the container, -1 if the
+ *         system ran out of memory or a copy failed. In this case the
+ *         container is left unchanged.
+ */
+#define MapT_INSERTMANY_DECL(K__,V__,N__)   \
+    int N__##_insertMany(N__* self,         \
+                          K__ const* keys,  \
+                          V__ const* values,\
+                          size_t count)
+
+/**
+ * Sorted MapT template declaration macro, see #MapT_DECLARE().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+#define MapT_DECLARE_SORTED(K__, V__, N__)                                  \
+    MapT_DECLARE(K__,V__,N__)                                               \
+    MapT_LOWERBOUND_DECL(K__,V__,N__);                                      \
+    MapT_UPPERBOUND_DECL(K__,V__,N__);                                      \
+    MapT_INSERTMANY_DECL(K__,V__,N__);
+
+#define MapT_BITS_OF_(n__)                                                  \
+    (((n__) > 0) ? sizeof(unsigned) * CHAR_BIT                              \
+                   - (size_t) __builtin_clz((unsigned) (n__))               \
+                 : 0)
+
+#define MapT_SORTED_PRIVATE_IMPL(K__,V__,N__)                               \
+    static bool                                                             \
+    N__##_Item_ctorKeyValue(N__##_Item* self,                               \
+                            K__ const* key,                                 \
+                            V__ const* value)                               \
+    {                                                                       \
+        if (K__##_ctorCopy(&self->key, key))                                \
+        {                                                                   \
+            if (V__##_ctorCopy(&self->value, value))                        \
+            {                                                               \
+                return true;                                                \
+            }                                                               \
+            K__##_dtor(&self->key);                                         \
+        }                                                                   \
+        return false;                                                       \
+    }                                                                       \
+                                                                            \
+    /* The moved-from item is raw storage afterwards, it is not destroyed */\
+    static void                                                             \
+    N__##_moveItem(N__##_Item* dst, N__##_Item* src)                        \
+    {                                                                       \
+        DECL_UNUSED_VAR(const bool ok) = N__##_Item_ctorMove(dst, src);     \
+        Debug_ASSERT(ok);                                                   \
+    }                                                                       \
+                                                                            \
+    static void                                                             \
+    N__##_swapItems(N__##_Item* a, N__##_Item* b)                           \
+    {                                                                       \
+        N__##_Item tmp;                                                     \
+        N__##_moveItem(&tmp, a);                                            \
+        N__##_moveItem(a, b);                                               \
+        N__##_moveItem(b, &tmp);                                            \
+    }                                                                       \
+                                                                            \
+    /* First index in [lo, hi) with a key greater than (upper) or not */    \
+    /* lower than (!upper) the given key, hi if there is none. */           \
+    static int                                                              \
+    N__##_bound(N__##_Item const* items,                                    \
+                int lo,                                                     \
+                int hi,                                                     \
+                K__ const* key,                                             \
+                bool upper)                                                 \
+    {                                                                       \
+        while (lo < hi)                                                     \
+        {                                                                   \
+            int mid = lo + (hi - lo) / 2;                                   \
+            int cmp = K__##_compare(&items[mid].key, key);                  \
+            if (cmp < 0 || (upper && cmp == 0))                             \
+            {                                                               \
+                lo = mid + 1;                                               \
+            }                                                               \
+            else                                                            \
+            {                                                               \
+                hi = mid;                                                   \
+            }                                                               \
+        }                                                                   \
+        return lo;                                                          \
+    }                                                                       \
+                                                                            \
+    static void                                                             \
+    N__##_siftDown(N__##_Item* items, int root, int n)                      \
+    {                                                                       \
+        for (;;)                                                            \
+        {                                                                   \
+            int child = 2 * root + 1;                                       \
+            if (child >= n)                                                 \
+            {                                                               \
+                return;                                                     \
+            }                                                               \
+            if (child + 1 < n &&                                            \
+                K__##_compare(&items[child].key, &items[child + 1].key) < 0)\
+            {                                                               \
+                ++child;                                                    \
+            }                                                               \
+            if (K__##_compare(&items[root].key, &items[child].key) >= 0)    \
+            {                                                               \
+                return;                                                     \
+            }                                                               \
+            N__##_swapItems(&items[root], &items[child]);                   \
+            root = child;                                                   \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    /* Heapsort, it is in place and needs no recursion */                   \
+    static void                                                             \
+    N__##_sort(N__##_Item* items, int n)                                    \
+    {                                                                       \
+        for (int i = n / 2; i-- > 0; )                                      \
+        {                                                                   \
+            N__##_siftDown(items, i, n);                                    \
+        }                                                                   \
+        for (int i = n - 1; i > 0; --i)                                     \
+        {                                                                   \
+            N__##_swapItems(&items[0], &items[i]);                          \
+            N__##_siftDown(items, 0, i);                                    \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    static void                                                             \
+    N__##_reverse(N__##_Item* items, int first, int last)                   \
+    {                                                                       \
+        while (first + 1 < last)                                            \
+        {                                                                   \
+            N__##_swapItems(&items[first++], &items[--last]);               \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    /* Merges the sorted ranges [first, middle) and [middle, last) */       \
+    /* without any buffer, by rotating and recursing on the halves. The */  \
+    /* keys in the two ranges are known to be distinct. */                  \
+    static void                                                             \
+    N__##_merge(N__##_Item* items, int first, int middle, int last)         \
+    {                                                                       \
+        int len1 = middle - first;                                          \
+        int len2 = last - middle;                                           \
+        if (len1 == 0 || len2 == 0 ||                                       \
+            K__##_compare(&items[middle - 1].key, &items[middle].key) < 0)  \
+        {                                                                   \
+            return;                                                         \
+        }                                                                   \
+        if (len1 + len2 == 2)                                               \
+        {                                                                   \
+            N__##_swapItems(&items[first], &items[middle]);                 \
+            return;                                                         \
+        }                                                                   \
+        int firstCut;                                                       \
+        int secondCut;                                                      \
+        if (len1 > len2)                                                    \
+        {                                                                   \
+            firstCut = first + len1 / 2;                                    \
+            secondCut = N__##_bound(items, middle, last,                    \
+                                    &items[firstCut].key, false);           \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            secondCut = middle + len2 / 2;                                  \
+            firstCut = N__##_bound(items, first, middle,                    \
+                                   &items[secondCut].key, true);            \
+        }                                                                   \
+        /* rotate [firstCut, middle, secondCut) */                          \
+        N__##_reverse(items, firstCut, middle);                             \
+        N__##_reverse(items, middle, secondCut);                            \
+        N__##_reverse(items, firstCut, secondCut);                          \
+        int newMiddle = firstCut + (secondCut - middle);                    \
+        N__##_merge(items, first, firstCut, newMiddle);                     \
+        N__##_merge(items, newMiddle, secondCut, last);                     \
+    }
+
+#define MapT_SORTED_INSERT_IMPL(K__,V__,N__)                                \
+    bool N__##_insert(N__* self,                                            \
+                       K__ const* key,                                      \
+                       V__ const* value)                                    \
+    {                                                                       \
+        int size = N__##_Impl_getSize(&self->mapImpl);                      \
+        int index = N__##_lowerBound(self, key);                            \
+        if (index < size &&                                                 \
+            K__##_compare(&self->mapImpl.vector_[index].key, key) == 0)     \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        N__##_Item* item = N__##_Impl_emplaceBack(&self->mapImpl);          \
+        if (item == NULL)                                                   \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        if (!N__##_Item_ctorKeyValue(item, key, value))                     \
+        {                                                                   \
+            N__##_Impl_cancelEmplace(&self->mapImpl);                       \
+            return false;                                                   \
+        }                                                                   \
+        if (index < size)                                                   \
+        {                                                                   \
+            /* make room at 'index' keeping the order */                    \
+            N__##_Item* items = self->mapImpl.vector_;                      \
+            N__##_Item tmp;                                                 \
+            N__##_moveItem(&tmp, &items[size]);                             \
+            for (int i = size; i > index; --i)                              \
+            {                                                               \
+                N__##_moveItem(&items[i], &items[i - 1]);                   \
+            }                                                               \
+            N__##_moveItem(&items[index], &tmp);                            \
+        }                                                                   \
+        return true;                                                        \
+    }
+
+#define MapT_SORTED_INSERTMANY_IMPL(K__,V__,N__)                            \
+    int N__##_insertMany(N__* self,                                         \
+                          K__ const* keys,                                  \
+                          V__ const* values,                                \
+                          size_t count)                                     \
+    {                                                                       \
+        int size = N__##_Impl_getSize(&self->mapImpl);                      \
+        int added = 0;                                                      \
+        if (!N__##_Impl_reserve(&self->mapImpl, (size_t) size + count))     \
+        {                                                                   \
+            return -1;                                                      \
+        }                                                                   \
+        /* no relocation from here on, the room has been reserved */        \
+        N__##_Item* items = self->mapImpl.vector_;                          \
+        for (size_t i = 0; i < count; ++i)                                  \
+        {                                                                   \
+            /* look up the sorted associations only */                      \
+            int index = N__##_bound(items, 0, size, &keys[i], false);       \
+            if (index < size &&                                             \
+                K__##_compare(&items[index].key, &keys[i]) == 0)            \
+            {                                                               \
+                continue;                                                   \
+            }                                                               \
+            N__##_Item* item = N__##_Impl_emplaceBack(&self->mapImpl);      \
+            Debug_ASSERT(item != NULL);                                     \
+            if (!N__##_Item_ctorKeyValue(item, &keys[i], &values[i]))       \
+            {                                                               \
+                /* rollback */                                              \
+                N__##_Impl_cancelEmplace(&self->mapImpl);                   \
+                while (added-- > 0)                                         \
+                {                                                           \
+                    N__##_Impl_popBack(&self->mapImpl);                     \
+                }                                                           \
+                return -1;                                                  \
+            }                                                               \
+            ++added;                                                        \
+        }                                                                   \
+        N__##_sort(&items[size], added);                                    \
+        /* drop the keys repeated in the batch */                           \
+        int last = size;                                                    \
+        for (int i = size; i < size + added; ++i)                           \
+        {                                                                   \
+            if (last > size &&                                              \
+                K__##_compare(&items[i].key, &items[last - 1].key) == 0)    \
+            {                                                               \
+                N__##_Item_dtor(&items[i]);                                 \
+            }                                                               \
+            else                                                            \
+            {                                                               \
+                if (i != last)                                              \
+                {                                                           \
+                    N__##_moveItem(&items[last], &items[i]);                \
+                }                                                           \
+                ++last;                                                     \
+            }                                                               \
+        }                                                                   \
+        for (int i = last; i < size + added; ++i)                           \
+        {                                                                   \
+            N__##_Impl_cancelEmplace(&self->mapImpl);                       \
+        }                                                                   \
+        N__##_merge(items, 0, size, last);                                  \
+        return last - size;                                                 \
+    }
+
+#define MapT_SORTED_REMOVEAT_IMPL(K__,V__,N__)                              \
+    void N__##_removeAt(N__* self, int index)                               \
+    {                                                                       \
+        Debug_ASSERT(index >= 0);                                           \
+        int size = N__##_Impl_getSize(&self->mapImpl);                      \
+        Debug_ASSERT(index < size);                                         \
+        N__##_Item* items = self->mapImpl.vector_;                          \
+        N__##_Item_dtor(&items[index]);                                     \
+        for (int i = index + 1; i < size; ++i)                              \
+        {                                                                   \
+            N__##_moveItem(&items[i - 1], &items[i]);                       \
+        }                                                                   \
+        /* the last item has been moved, it must not be destroyed */        \
+        N__##_Impl_cancelEmplace(&self->mapImpl);                           \
+    }
+
+#define MapT_SORTED_GETINDEXOF_IMPL(K__,V__,N__)                            \
+    int N__##_getIndexOf(N__ const* self, K__ const* key)                   \
+    {                                                                       \
+        int size = N__##_Impl_getSize(&self->mapImpl);                      \
+        int index = N__##_lowerBound(self, key);                            \
+        bool found = (index < size &&                                       \
+            K__##_compare(&self->mapImpl.vector_[index].key, key) == 0);    \
+                                                                            \
+        /* the depth of the binary search, i.e. the bits of the size */     \
+        MapT_STATS_LOOKUP_(self, MapT_BITS_OF_(size), found);               \
+        return found ? index : -1;                                          \
+    }
+
+#define MapT_SORTED_LOWERBOUND_IMPL(K__,V__,N__)                            \
+    int N__##_lowerBound(N__ const* self, K__ const* key)                   \
+    {                                                                       \
+        return N__##_bound(self->mapImpl.vector_, 0,                        \
+                           N__##_Impl_getSize(&self->mapImpl), key, false); \
+    }
+
+#define MapT_SORTED_UPPERBOUND_IMPL(K__,V__,N__)                            \
+    int N__##_upperBound(N__ const* self, K__ const* key)                   \
+    {                                                                       \
+        return N__##_bound(self->mapImpl.vector_, 0,                        \
+                           N__##_Impl_getSize(&self->mapImpl), key, true);  \
+    }
+
+/**
+ * Sorted MapT template definition macro, see #MapT_DEFINE().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+
+#define MapT_DEFINE_SORTED(K__,V__,N__)         \
+    VectorT_DEFINE(N__##_Item, N__##_Impl, size_t)\
+    MapT_Item_dtor_IMPL(K__,V__,N__)            \
+    MapT_Item_ctorCopy_IMPL(K__,V__,N__)        \
+    MapT_Item_assign_IMPL(K__,V__,N__)          \
+    MapT_Item_ctorMove_IMPL(K__,V__,N__)        \
+    MapT_SORTED_PRIVATE_IMPL(K__,V__,N__)       \
+    MapT_CTOR_IMPL(K__,V__,N__)                 \
+    MapT_CTOR_STATIC_IMPL(K__,V__,N__)          \
+    MapT_CTOR_COPY_IMPL(K__,V__,N__)            \
+    MapT_DTOR_IMPL(K__,V__,N__)                 \
+    MapT_SORTED_INSERT_IMPL(K__,V__,N__)        \
+    MapT_SORTED_INSERTMANY_IMPL(K__,V__,N__)    \
+    MapT_SORTED_REMOVEAT_IMPL(K__,V__,N__)      \
+    MapT_REMOVE_IMPL(K__,V__,N__)               \
+    MapT_SORTED_GETINDEXOF_IMPL(K__,V__,N__)    \
+    MapT_SORTED_LOWERBOUND_IMPL(K__,V__,N__)    \
+    MapT_SORTED_UPPERBOUND_IMPL(K__,V__,N__)    \
+    MapT_GETVALUEAT_IMPL(K__,V__,N__)           \
+    MapT_SETVALUEAT_IMPL(K__,V__,N__)           \
+    MapT_GETKEYAT_IMPL(K__, V__, N__)           \
+    MapT_FIND_IMPL(K__,V__,N__)                 \
+    MapT_ISEMPTY_IMPL(K__,V__,N__)              \
+    MapT_GETSIZE_IMPL(K__, V__, N__)            \
+    MapT_CLEAR_IMPL(K__,V__,N__)                \
+    MapT_GETDATA_IMPL(K__,V__,N__)              \
+    MapT_APPLY_IMPL(K__,V__,N__)                \
+    MapT_GETSTATS_IMPL_(K__,V__,N__)
+
+
+/**
+ * Structure of arrays map container template.
+ *
+ * The SoA flavour provides the interface of MapT, but the keys and the values
+ * are kept in two separate VectorTs instead of one VectorT of associations.
+ * The key and the value of the association at index 'i' are at position 'i'
+ * in their vector, so the indexes behave exactly as they do for MapT. The
+ * sequential search of #MapT_getIndexOf() reads the dense array of keys only,
+ * i.e. it does not pull the values into the cache. This pays off when the
+ * values are much larger than the keys.
+ *
+ * A buffer of MapT_SIZE_OF_BUFFER(N, capacity) bytes given to
+ * #MapT_ctorStatic() is split into the array of the keys and the one of the
+ * values. Instead of #MapT_getData() the arrays are available through
+ * #MapT_getKeys() and #MapT_getValues().
+ *
+ * @code
+ * MapT_DECLARE_SOA(K,V,N);
+ * MapT_DEFINE_SOA(K,V,N);
+ * @endcode
+ *
+ * @note the index of an association may change on #MapT_remove() and
+ *       #MapT_removeAt() exactly as it does for MapT.
+ */
+
+/**
+ * @fn K const* MapT_getKeys(MapT const* self)
+ *
+ * Retrieves the keys of a SoA map as a contiguous array of #MapT_getSize()
+ * keys, the key at position 'index' is the one of the association with the
+ * same index.
+ *
+ * @param self a pointer to the container.
+ * @return a pointer to the first key. The reference is valid as long as the
+ *         one returned by #MapT_getKeyAt().
+ */
+#define MapT_GETKEYS_DECL(K__,V__,N__)       \
+    K__ const* N__##_getKeys(N__ const* self)
+
+/**
+ * @fn V const* MapT_getValues(MapT const* self)
+ *
+ * Retrieves the values of a SoA map as a contiguous array, see
+ * #MapT_getKeys().
+ *
+ * @param self a pointer to the container.
+ * @return a pointer to the first value. The reference is valid as long as the
+ *         one returned by #MapT_getValueAt().
+ */
+#define MapT_GETVALUES_DECL(K__,V__,N__)     \
+    V__ const* N__##_getValues(N__ const* self)
+
+/**
+ * SoA MapT template declaration macro, see #MapT_DECLARE().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+#define MapT_DECLARE_SOA(K__, V__, N__)                                     \
+    /* not stored, it gives the size of the buffer for #MapT_ctorStatic() */\
+    typedef struct                                                          \
+    {                                                                       \
+        K__ key;                                                            \
+        V__ value;                                                          \
+    }                                                                       \
+    N__##_Item;                                                             \
+    VectorT_DECLARE(K__, N__##_Keys, size_t);                               \
+    VectorT_DECLARE(V__, N__##_Values, size_t);                             \
+    typedef struct                                                          \
+    {                                                                       \
+        N__##_Keys keys;                                                    \
+        N__##_Values values;                                                \
+        MapT_STATS_FIELD_                                                   \
+    }                                                                       \
+    N__;                                                                    \
+    MapT_GETSTATS_DECL_(K__,V__,N__)                                        \
+    MapT_CTOR_DECL(K__,V__,N__);                                            \
+    MapT_CTOR_STATIC_DECL(K__,V__,N__);                                     \
+    MapT_CTOR_COPY_DECL(K__,V__,N__);                                       \
+    MapT_DTOR_DECL(K__,V__,N__);                                            \
+    MapT_INSERT_DECL(K__,V__,N__);                                          \
+    MapT_REMOVEAT_DECL(K__,V__,N__);                                        \
+    MapT_REMOVE_DECL(K__,V__,N__);                                          \
+    MapT_GETINDEXOF_DECL(K__,V__,N__);                                      \
+    MapT_GETVALUEAT_DECL(K__,V__,N__);                                      \
+    MapT_SETVALUEAT_DECL(K__,V__,N__);                                      \
+    MapT_GETKEYAT_DECL(K__, V__, N__);                                      \
+    MapT_FIND_DECL(K__,V__,N__);                                            \
+    MapT_ISEMPTY_DECL(K__,V__,N__);                                         \
+    MapT_GETSIZE_DECL(K__, V__, N__);                                       \
+    MapT_CLEAR_DECL(K__,V__,N__);                                           \
+    MapT_GETKEYS_DECL(K__,V__,N__);                                         \
+    MapT_GETVALUES_DECL(K__,V__,N__);                                       \
+    MapT_CONST_APPLY_DECL(K__,V__,N__);                                     \
+    MapT_APPLY_DECL(K__,V__,N__);                                           \
+    MapT_CONST_APPLY_RANGE_DECL(K__,V__,N__);                               \
+    MapT_APPLY_RANGE_DECL(K__,V__,N__);
+
+#define MapT_SOA_CTOR_IMPL(K__,V__,N__)                                     \
+    bool                                                                    \
+    N__##_ctor(N__* self, size_t capacity)                                  \
+    {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
+        if (!N__##_Keys_ctor(&self->keys, capacity))                        \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        if (!N__##_Values_ctor(&self->values, capacity))                    \
+        {                                                                   \
+            N__##_Keys_dtor(&self->keys);                                   \
+            return false;                                                   \
+        }                                                                   \
+        return true;                                                        \
+    }
+
+#define MapT_SOA_CTOR_STATIC_IMPL(K__,V__,N__)                              \
+    bool                                                                    \
+    N__##_ctorStatic(N__* self, void* buffer, size_t capacity)              \
+    {                                                                       \
+        /* the values follow the keys, aligned for V */                     \
+        size_t align = __alignof__(V__);                                    \
+        size_t offset = capacity * sizeof(K__);                             \
+        offset = (offset + align - 1) / align * align;                      \
+                                                                            \
+        MapT_STATS_INIT_(self);                                             \
+        return (buffer != NULL) &&                                          \
+               N__##_Keys_ctorStatic(&self->keys, buffer, capacity) &&      \
+               N__##_Values_ctorStatic(&self->values,                       \
+                                       (uint8_t*) buffer + offset,          \
+                                       capacity);                           \
+    }
+
+#define MapT_SOA_CTOR_COPY_IMPL(K__,V__,N__)                                \
+    bool                                                                    \
+    N__##_ctorCopy(N__* self, N__ const* a)                                 \
+    {                                                                       \
+        MapT_STATS_INIT_(self);                                             \
+        if (!N__##_Keys_ctorCopy(&self->keys, &a->keys))                    \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        if (!N__##_Values_ctorCopy(&self->values, &a->values))              \
+        {                                                                   \
+            N__##_Keys_dtor(&self->keys);                                   \
+            return false;                                                   \
+        }                                                                   \
+        return true;                                                        \
+    }
+
+#define MapT_SOA_DTOR_IMPL(K__,V__,N__)                                     \
+    void                                                                    \
+    N__##_dtor(N__* self)                                                   \
+    {                                                                       \
+        N__##_Keys_dtor(&self->keys);                                       \
+        N__##_Values_dtor(&self->values);                                   \
+    }
+
+#define MapT_SOA_INSERT_IMPL(K__,V__,N__)                                   \
+    bool N__##_insert(N__* self,                                            \
+                       K__ const* key,                                      \
+                       V__ const* value)                                    \
+    {                                                                       \
+        if (N__##_find(self, key))                                          \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        K__* newKey = N__##_Keys_emplaceBack(&self->keys);                  \
+        if (newKey == NULL)                                                 \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        V__* newValue = N__##_Values_emplaceBack(&self->values);            \
+        if (newValue != NULL)                                               \
+        {                                                                   \
+            if (K__##_ctorCopy(newKey, key))                                \
+            {                                                               \
+                if (V__##_ctorCopy(newValue, value))                        \
+                {                                                           \
+                    return true;                                            \
+                }                                                           \
+                K__##_dtor(newKey);                                         \
+            }                                                               \
+            N__##_Values_cancelEmplace(&self->values);                      \
+        }                                                                   \
+        N__##_Keys_cancelEmplace(&self->keys);                              \
+        return false;                                                       \
+    }
+
+#define MapT_SOA_REMOVEAT_IMPL(K__,V__,N__)                                 \
+    void N__##_removeAt(N__* self, int index)                               \
+    {                                                                       \
+        Debug_ASSERT(index >= 0);                                           \
+        Debug_ASSERT(index < N__##_getSize(self));                          \
+        N__##_Keys_removeAtSwap(&self->keys, index);                        \
+        N__##_Values_removeAtSwap(&self->values, index);                    \
+    }
+
+#define MapT_SOA_GETINDEXOF_IMPL(K__,V__,N__)                               \
+    int N__##_getIndexOf(N__ const* self, K__ const* key)                   \
+    {                                                                       \
+        K__ const* keys = self->keys.vector_;                               \
+        int size = N__##_getSize(self);                                     \
+        for (int i = 0; i < size; ++i)                                      \
+        {                                                                   \
+            if (K__##_isEqual(key, &keys[i]))                               \
+            {                                                               \
+                MapT_STATS_LOOKUP_(self, i + 1, true);                      \
+                return i;                                                   \
+            }                                                               \
+        }                                                                   \
+        MapT_STATS_LOOKUP_(self, size, false);                              \
+        return -1;                                                          \
+    }
+
+#define MapT_SOA_GETVALUEAT_IMPL(K__,V__,N__)                               \
+    V__ const* N__##_getValueAt(N__ const* self, int index)                 \
+    {                                                                       \
+        return N__##_Values_getPtrToElementAt(&self->values, index);        \
+    }
+
+#define MapT_SOA_SETVALUEAT_IMPL(K__,V__,N__)                               \
+    bool N__##_setValueAt(N__* self,                                        \
+                           int index,                                       \
+                           V__ const* newValue)                             \
+    {                                                                       \
+        V__* value = N__##_Values_getMutPtrAt(&self->values, index);        \
+        return V__##_assign(value, newValue);                               \
+    }
+
+#define MapT_SOA_GETKEYAT_IMPL(K__, V__, N__)                               \
+    K__ const* N__##_getKeyAt(N__ const* self, int index)                   \
+    {                                                                       \
+        Debug_ASSERT(index >= 0);                                           \
+        return N__##_Keys_getPtrToElementAt(&self->keys, index);            \
+    }
+
+#define MapT_SOA_ISEMPTY_IMPL(K__,V__,N__)                                  \
+    bool N__##_isEmpty(N__ const* self)                                     \
+    {                                                                       \
+        return N__##_Keys_isEmpty(&self->keys);                             \
+    }
+
+#define MapT_SOA_GETSIZE_IMPL(K__, V__, N__)                                \
+    int N__##_getSize(N__ const* self)                                      \
+    {                                                                       \
+        return N__##_Keys_getSize(&self->keys);                             \
+    }
+
+#define MapT_SOA_CLEAR_IMPL(K__,V__,N__)                                    \
+    void N__##_clear(N__* self)                                             \
+    {                                                                       \
+        N__##_Keys_clear(&self->keys);                                      \
+        N__##_Values_clear(&self->values);                                  \
+    }
+
+#define MapT_SOA_GETKEYS_IMPL(K__,V__,N__)                                  \
+    K__ const* N__##_getKeys(N__ const* self)                               \
+    {                                                                       \
+        return N__##_Keys_getData(&self->keys);                             \
+    }                                                                       \
+                                                                            \
+    V__ const* N__##_getValues(N__ const* self)                             \
+    {                                                                       \
+        return N__##_Values_getData(&self->values);                         \
+    }
+
+// The range apply functions, see MapT_APPLY_RANGE_IMPL_().
+#define MapT_SOA_APPLY_RANGE_IMPL_(K__,V__,N__,NAME__,FN__,CONST__)         \
+    int N__##_##NAME__(N__ CONST__* self, int begin, int end,               \
+                       N__##_##FN__ fn, void* context)                      \
+    {                                                                       \
+        Debug_ASSERT(begin >= 0);                                           \
+        Debug_ASSERT(end <= N__##_getSize(self));                           \
+        K__ const* keys = self->keys.vector_;                               \
+        V__ CONST__* values = self->values.vector_;                         \
+        int i = begin;                                                      \
+        bool cont = true;                                                   \
+                                                                            \
+        for (; i < end && cont; ++i)                                        \
+        {                                                                   \
+            cont = fn(context, &keys[i], &values[i], i);                    \
+        }                                                                   \
+        return i - begin;                                                   \
+    }
+
+#define MapT_SOA_APPLY_IMPL(K__,V__,N__)                                    \
+    MapT_SOA_APPLY_RANGE_IMPL_(K__,V__,N__,constApplyRange,applyFn,const)   \
+    MapT_SOA_APPLY_RANGE_IMPL_(K__,V__,N__,applyRange,mutApplyFn,)          \
+                                                                            \
+    int N__##_constApply(N__ const* self, N__##_applyFn fn, void* context)  \
+    {                                                                       \
+        return N__##_constApplyRange(self, 0, N__##_getSize(self),          \
+                                     fn, context);                          \
+    }                                                                       \
+                                                                            \
+    int N__##_apply(N__* self, N__##_mutApplyFn fn, void* context)          \
+    {                                                                       \
+        return N__##_applyRange(self, 0, N__##_getSize(self), fn, context); \
+    }
+
+/**
+ * SoA MapT template definition macro, see #MapT_DEFINE().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+
+#define MapT_DEFINE_SOA(K__,V__,N__)            \
+    VectorT_DEFINE(K__, N__##_Keys, size_t)     \
+    VectorT_DEFINE(V__, N__##_Values, size_t)   \
+    MapT_SOA_CTOR_IMPL(K__,V__,N__)             \
+    MapT_SOA_CTOR_STATIC_IMPL(K__,V__,N__)      \
+    MapT_SOA_CTOR_COPY_IMPL(K__,V__,N__)        \
+    MapT_SOA_DTOR_IMPL(K__,V__,N__)             \
+    MapT_SOA_INSERT_IMPL(K__,V__,N__)           \
+    MapT_SOA_REMOVEAT_IMPL(K__,V__,N__)         \
+    MapT_REMOVE_IMPL(K__,V__,N__)               \
+    MapT_SOA_GETINDEXOF_IMPL(K__,V__,N__)       \
+    MapT_SOA_GETVALUEAT_IMPL(K__,V__,N__)       \
+    MapT_SOA_SETVALUEAT_IMPL(K__,V__,N__)       \
+    MapT_SOA_GETKEYAT_IMPL(K__, V__, N__)       \
+    MapT_FIND_IMPL(K__,V__,N__)                 \
+    MapT_SOA_ISEMPTY_IMPL(K__,V__,N__)          \
+    MapT_SOA_GETSIZE_IMPL(K__, V__, N__)        \
+    MapT_SOA_CLEAR_IMPL(K__,V__,N__)            \
+    MapT_SOA_GETKEYS_IMPL(K__,V__,N__)          \
+    MapT_SOA_APPLY_IMPL(K__,V__,N__)            \
+    MapT_GETSTATS_IMPL_(K__,V__,N__)
+
+// integer key scan ----------------------------------------------------------
+
+/*
+ * The scan compares a block of keys with a needle splatted into a vector
+ * register, the result of the comparison is reduced to a bit mask, so the
+ * index of the first match is found with a count of the trailing zeros. The
+ * intrinsics are kept out of this header, the scan is implemented in MapT.c.
+ */
+
+typedef uint32_t __attribute__((may_alias)) MapT_Key32;
+typedef uint64_t __attribute__((may_alias)) MapT_Key64;
+
+/**
+ * @brief searches a 32-bit key in an array of keys
+ *
+ * The keys are compared 4, 8 or 16 at a time with the widest of SSE2, AVX2
+ * and AVX-512 the code is compiled for, or 4 at a time with NEON on ARMv7
+ * and AArch64 (little endian only). They are compared one by one on other
+ * targets, or if MapT_Config_NO_SIMD is defined.
+ *
+ * @param keys the array of keys.
+ * @param size the number of keys in the array.
+ * @param needle the key to search for.
+ * @return the index of the first key equal to 'needle', or -1 if there is
+ *         none.
+ */
+int
+MapT_scanKeys32(MapT_Key32 const* keys, int size, uint32_t needle);
+
+/**
+ * @brief searches a 64-bit key in an array of keys, see MapT_scanKeys32()
+ */
+int
+MapT_scanKeys64(MapT_Key64 const* keys, int size, uint64_t needle);
+
+/*
+ * The single paths of the scan, MapT_scanKeys32() and MapT_scanKeys64() pick
+ * one of them at compile time. They are exported for the unit tests, the
+ * caller of a SIMD path has to check that the CPU supports it.
+ */
+int
+MapT_scanKeys32Scalar(MapT_Key32 const* keys, int size, uint32_t needle);
+int
+MapT_scanKeys64Scalar(MapT_Key64 const* keys, int size, uint64_t needle);
+
+#if !defined(MapT_Config_NO_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#   define MapT_SCAN_X86_
+int
+MapT_scanKeys32Sse2(MapT_Key32 const* keys, int size, uint32_t needle);
+int
+MapT_scanKeys64Sse2(MapT_Key64 const* keys, int size, uint64_t needle);
+int
+MapT_scanKeys32Avx2(MapT_Key32 const* keys, int size, uint32_t needle);
+int
+MapT_scanKeys64Avx2(MapT_Key64 const* keys, int size, uint64_t needle);
+int
+MapT_scanKeys32Avx512(MapT_Key32 const* keys, int size, uint32_t needle);
+int
+MapT_scanKeys64Avx512(MapT_Key64 const* keys, int size, uint64_t needle);
+#elif !defined(MapT_Config_NO_SIMD) && defined(__ARM_NEON) && \
+      !defined(__ARM_BIG_ENDIAN)
+#   define MapT_SCAN_NEON_
+int
+MapT_scanKeys32Neon(MapT_Key32 const* keys, int size, uint32_t needle);
+int
+MapT_scanKeys64Neon(MapT_Key64 const* keys, int size, uint64_t needle);
+#endif
+
+/**
+ * SoA MapT template definition macro for integer keys, see
+ * #MapT_DECLARE_SOA().
+ *
+ * The container is declared with #MapT_DECLARE_SOA(), this macro replaces
+ * #MapT_DEFINE_SOA() and defines a #MapT_getIndexOf() that compares up to 16
+ * keys per instruction with MapT_scanKeys32() or MapT_scanKeys64(). The
+ * search is still linear, but it has one branch per block of keys instead of
+ * one per key, which is what small maps benefit from. The scan is vectorized
+ * on x86 and on little endian ARM with NEON, other targets compare the keys
+ * one by one.
+ *
+ * @code
+ * MapT_DECLARE_SOA(Pointer,V,N);
+ * MapT_DEFINE_SOA_INTKEY(Pointer,V,N);
+ * @endcode
+ *
+ * @note K must have a size of 4 or 8 bytes, e.g. uint32_t or Pointer, and
+ *       K_isEqual() must be equivalent to the comparison of the bits of the
+ *       keys. K_isEqual() is not used by #MapT_getIndexOf().
+ *
+ * @param K__ the key type.
+ * @param V__ the value type.
+ * @param N__ the name of the type that will provide the associative container
+ *            on the given types for key and value.
+ */
+
+#define MapT_SOA_INTKEY_GETINDEXOF_IMPL(K__,V__,N__)                        \
+    int N__##_getIndexOf(N__ const* self, K__ const* key)                   \
+    {                                                                       \
+        Debug_STATIC_ASSERT(sizeof(K__) == sizeof(uint32_t) ||              \
+                            sizeof(K__) == sizeof(uint64_t));               \
+        void const* keys = self->keys.vector_;                              \
+        int size = N__##_getSize(self);                                     \
+                                                                            \
+        int index;                                                          \
+        if (sizeof(K__) == sizeof(uint32_t))                                \
+        {                                                                   \
+            uint32_t needle;                                                \
+            memcpy(&needle, key, sizeof(needle));                           \
+            index = MapT_scanKeys32(keys, size, needle);                    \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            uint64_t needle = 0;                                            \
+            memcpy(&needle, key, sizeof(K__));                              \
+            index = MapT_scanKeys64(keys, size, needle);                    \
+        }                                                                   \
+        MapT_STATS_LOOKUP_(self, (index >= 0) ? index + 1 : size,           \
+                           index >= 0);                                     \
+        return index;                                                       \
+    }
 
+#define MapT_DEFINE_SOA_INTKEY(K__,V__,N__)         \
+    VectorT_DEFINE(K__, N__##_Keys, size_t)         \
+    VectorT_DEFINE(V__, N__##_Values, size_t)       \
+    MapT_SOA_CTOR_IMPL(K__,V__,N__)                 \
+    MapT_SOA_CTOR_STATIC_IMPL(K__,V__,N__)          \
+    MapT_SOA_CTOR_COPY_IMPL(K__,V__,N__)            \
+    MapT_SOA_DTOR_IMPL(K__,V__,N__)                 \
+    MapT_SOA_INSERT_IMPL(K__,V__,N__)               \
+    MapT_SOA_REMOVEAT_IMPL(K__,V__,N__)             \
+    MapT_REMOVE_IMPL(K__,V__,N__)                   \
+    MapT_SOA_INTKEY_GETINDEXOF_IMPL(K__,V__,N__)    \
+    MapT_SOA_GETVALUEAT_IMPL(K__,V__,N__)           \
+    MapT_SOA_SETVALUEAT_IMPL(K__,V__,N__)           \
+    MapT_SOA_GETKEYAT_IMPL(K__, V__, N__)           \
+    MapT_FIND_IMPL(K__,V__,N__)                     \
+    MapT_SOA_ISEMPTY_IMPL(K__,V__,N__)              \
+    MapT_SOA_GETSIZE_IMPL(K__, V__, N__)            \
+    MapT_SOA_CLEAR_IMPL(K__,V__,N__)                \
+    MapT_SOA_GETKEYS_IMPL(K__,V__,N__)              \
+    MapT_SOA_APPLY_IMPL(K__,V__,N__)                \
+    MapT_GETSTATS_IMPL_(K__,V__,N__)
 
 #if defined(DOXYGEN_SCAN)
 // fake prototypes for doxygen use
@@ -604,6 +2119,19 @@ bool MapT_find(MapT const* self, K const* key);
 bool MapT_isEmpty(MapT const* self);
 int MapT_getSize(MapT const* self);;
 void MapT_clear(MapT* self);
+MapT_Item const* MapT_getData(MapT const* self);
+int MapT_constApply(MapT const* self, MapT_applyFn fn, void* context);
+int MapT_apply(MapT* self, MapT_mutApplyFn fn, void* context);
+int MapT_constApplyRange(MapT const* self, int begin, int end,
+                         MapT_applyFn fn, void* context);
+int MapT_applyRange(MapT* self, int begin, int end,
+                    MapT_mutApplyFn fn, void* context);
+MapT_Stats MapT_getStats(MapT const* self);
+K const* MapT_getKeys(MapT const* self);
+V const* MapT_getValues(MapT const* self);
+int MapT_lowerBound(MapT const* self, K const* key);
+int MapT_upperBound(MapT const* self, K const* key);
+int MapT_insertMany(MapT* self, K const* keys, V const* values, size_t count);
 #endif
 
 #endif
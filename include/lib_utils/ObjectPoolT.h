@@ -0,0 +1,292 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @addtogroup lib_utils
+ * @{
+ *
+ * @file ObjectPoolT.h
+ *
+ * @brief Fixed size object pool template
+ */
+#if !defined(OBJECTPOOLT_H)
+#define OBJECTPOOLT_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#include "lib_mem/Memory.h"
+#include "lib_debug/Debug.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * ObjectPoolT declaration macro. Use this in your header files.
+ *
+ * @param T the type of the objects of the pool.
+ * @param N the name for the newly defined type.
+ * @param SIZE_T the type of the indices, it limits the capacity.
+ *
+ * The pool hands out storage for objects of type T from a buffer with a fixed
+ * number of slots, acquiring and releasing a slot is O(1) and never touches
+ * the heap. The free slots are kept in a list linked through the slots
+ * themselves, slots which have never been used are taken in order, so the
+ * construction of the pool is O(1) as well.
+ *
+ * The pool does not construct or destroy the objects: the caller constructs
+ * the object in the storage returned by N##_acquire() and destroys it before
+ * passing it to N##_release().
+ */
+
+#define ObjectPoolT_DECLARE(T, N, SIZE_T)                                   \
+typedef union                                                               \
+{                                                                           \
+    T item;                                                                 \
+    SIZE_T next;                                                            \
+} N##_Slot;                                                                 \
+typedef struct                                                              \
+{                                                                           \
+    N##_Slot* slots_;                                                       \
+    SIZE_T capacity_;                                                       \
+    SIZE_T used_;                                                           \
+    SIZE_T freeHead_;                                                       \
+    SIZE_T nextUnused_;                                                     \
+    bool isStatic_;                                                         \
+} N;                                                                        \
+bool N##_ctor(N* p, SIZE_T capacity);                                       \
+bool N##_ctorStatic(N* p, void* buffer, SIZE_T capacity);                   \
+void N##_dtor(N* p);                                                        \
+T* N##_acquire(N* p);                                                       \
+void N##_release(N* p, T* item);                                            \
+bool N##_owns(N const* p, T const* item);                                   \
+SIZE_T N##_getUsed(N const* p);                                             \
+SIZE_T N##_getCapacity(N const* p);                                         \
+bool N##_isFull(N const* p)
+
+/**
+ * @fn bool ObjectPoolT_ctor( ObjectPoolT* p, int capacity )
+ *
+ * Constructor, allocates the slots with Memory_alloc().
+ *
+ * @param p a pointer to the pool.
+ * @param capacity the number of objects the pool can hold.
+ * @retval true the operation has been successfully completed.
+ * @retval false the system ran out of memory.
+ */
+
+/**
+ * @fn bool ObjectPoolT_ctorStatic( ObjectPoolT* p, void* buffer, int capacity )
+ *
+ * Constructor, uses the slots of a buffer provided by the caller.
+ *
+ * @param p a pointer to the pool.
+ * @param buffer a buffer of ObjectPoolT_SIZE_OF_BUFFER(ObjectPoolT, capacity)
+ *        bytes, aligned for T.
+ * @param capacity the number of objects the pool can hold.
+ * @retval true the operation has been successfully completed.
+ * @retval false the buffer is NULL.
+ */
+
+/**
+ * @fn void ObjectPoolT_dtor( ObjectPoolT* p )
+ *
+ * Destructor. The objects still acquired are not destroyed, their storage is
+ * no longer valid afterwards. The pool is left empty with no capacity, so
+ * #ObjectPoolT_acquire() returns NULL until it is constructed again.
+ *
+ * @param p a pointer to the pool.
+ */
+
+/**
+ * @fn T* ObjectPoolT_acquire( ObjectPoolT* p )
+ *
+ * Takes a slot out of the pool in O(1).
+ *
+ * @param p a pointer to the pool.
+ * @return a pointer to the uninitialized storage of an object, or NULL if all
+ *         the slots are in use.
+ */
+
+/**
+ * @fn void ObjectPoolT_release( ObjectPoolT* p, T* item )
+ *
+ * Gives a slot back to the pool in O(1). The slot is reused first by the next
+ * call of #ObjectPoolT_acquire(), while it is likely still in the cache.
+ *
+ * @param p a pointer to the pool.
+ * @param item an object acquired from this pool and already destroyed. It is
+ *        an error to release an object twice or to release a foreign one.
+ */
+
+/**
+ * @fn bool ObjectPoolT_owns( ObjectPoolT const* p, T const* item )
+ *
+ * @param p a pointer to the pool.
+ * @param item a pointer to an object.
+ * @return true if 'item' points to the start of a slot of the pool which has
+ *         been handed out at least once.
+ */
+
+/**
+ * @fn int ObjectPoolT_getUsed( ObjectPoolT const* p )
+ *
+ * @param p a pointer to the pool.
+ * @return the number of slots in use.
+ */
+
+/**
+ * @fn int ObjectPoolT_getCapacity( ObjectPoolT const* p )
+ *
+ * @param p a pointer to the pool.
+ * @return the number of slots of the pool.
+ */
+
+/**
+ * @fn bool ObjectPoolT_isFull( ObjectPoolT const* p )
+ *
+ * @param p a pointer to the pool.
+ * @return true if all the slots are in use.
+ */
+
+#define ObjectPoolT_SIZE_OF_BUFFER(N__, numItems)                           \
+    (sizeof(N__##_Slot) * (numItems))
+
+#if defined(Memory_Config_STATIC)
+#   define ObjectPoolT_DEFINE_CTOR(T, N, SIZE_T)
+#   define ObjectPoolT_FREE_SLOTS(p__)
+#else
+#   define ObjectPoolT_DEFINE_CTOR(T, N, SIZE_T)                            \
+    bool N##_ctor(N* p, SIZE_T capacity)                                    \
+    {                                                                       \
+        void* buffer;                                                       \
+                                                                            \
+        buffer = Memory_alloc(ObjectPoolT_SIZE_OF_BUFFER(N, capacity));     \
+                                                                            \
+        if (!N##_ctorStatic(p, buffer, capacity))                           \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        p->isStatic_ = false;                                               \
+        return true;                                                        \
+    }
+#   define ObjectPoolT_FREE_SLOTS(p__)                                      \
+    if (!(p__)->isStatic_)                                                  \
+    {                                                                       \
+        Memory_free((p__)->slots_);                                         \
+    }
+#endif
+
+#define ObjectPoolT_DEFINE(T, N, SIZE_T)                                    \
+                                                                            \
+    bool N##_ctorStatic(N* p, void* buffer, SIZE_T capacity)                \
+    {                                                                       \
+        p->slots_ = buffer;                                                 \
+        if (p->slots_ == NULL)                                              \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        p->capacity_    = capacity;                                         \
+        p->used_        = 0;                                                \
+        /* the capacity as index marks the end of the free list */          \
+        p->freeHead_    = capacity;                                         \
+        p->nextUnused_  = 0;                                                \
+        p->isStatic_    = true;                                             \
+        return true;                                                        \
+    }                                                                       \
+                                                                            \
+    ObjectPoolT_DEFINE_CTOR(T, N, SIZE_T)                                   \
+                                                                            \
+    void N##_dtor(N* p)                                                     \
+    {                                                                       \
+        ObjectPoolT_FREE_SLOTS(p)                                           \
+        p->slots_       = NULL;                                             \
+        p->capacity_    = 0;                                                \
+        p->used_        = 0;                                                \
+        /* an empty pool, acquire() fails and owns() is always false */     \
+        p->freeHead_    = 0;                                                \
+        p->nextUnused_  = 0;                                                \
+    }                                                                       \
+                                                                            \
+    T* N##_acquire(N* p)                                                    \
+    {                                                                       \
+        SIZE_T index;                                                       \
+                                                                            \
+        if (p->freeHead_ != p->capacity_)                                   \
+        {                                                                   \
+            index = p->freeHead_;                                           \
+            p->freeHead_ = p->slots_[index].next;                           \
+        }                                                                   \
+        else if (p->nextUnused_ < p->capacity_)                             \
+        {                                                                   \
+            index = p->nextUnused_++;                                       \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            return NULL;                                                    \
+        }                                                                   \
+        p->used_++;                                                         \
+        return &p->slots_[index].item;                                      \
+    }                                                                       \
+                                                                            \
+    void N##_release(N* p, T* item)                                         \
+    {                                                                       \
+        Debug_ASSERT(N##_owns(p, item));                                    \
+        Debug_ASSERT(p->used_ > 0);                                         \
+        N##_Slot* slot = (N##_Slot*) item;                                  \
+                                                                            \
+        slot->next = p->freeHead_;                                          \
+        p->freeHead_ = slot - p->slots_;                                    \
+        p->used_--;                                                         \
+    }                                                                       \
+                                                                            \
+    bool N##_owns(N const* p, T const* item)                                \
+    {                                                                       \
+        char const* base = (char const*) p->slots_;                         \
+        char const* end = (char const*) (p->slots_ + p->nextUnused_);       \
+        char const* ptr = (char const*) item;                               \
+                                                                            \
+        /* inside the slots in use so far and at the start of a slot */     \
+        return (ptr >= base && ptr < end &&                                 \
+                (size_t) (ptr - base) % sizeof(N##_Slot) == 0);             \
+    }                                                                       \
+                                                                            \
+    SIZE_T N##_getUsed(N const* p)                                          \
+    {                                                                       \
+        return p->used_;                                                    \
+    }                                                                       \
+                                                                            \
+    SIZE_T N##_getCapacity(N const* p)                                      \
+    {                                                                       \
+        return p->capacity_;                                                \
+    }                                                                       \
+                                                                            \
+    bool N##_isFull(N const* p)                                             \
+    {                                                                       \
+        return (p->used_ == p->capacity_);                                  \
+    }
+
+#if defined(__cplusplus)
+}
+#endif
+
+#if defined( DOXYGEN_SCAN )
+bool ObjectPoolT_ctor( ObjectPoolT* p, int capacity );
+bool ObjectPoolT_ctorStatic( ObjectPoolT* p, void* buffer, int capacity );
+void ObjectPoolT_dtor( ObjectPoolT* p );
+T* ObjectPoolT_acquire( ObjectPoolT* p );
+void ObjectPoolT_release( ObjectPoolT* p, T* item );
+bool ObjectPoolT_owns( ObjectPoolT const* p, T const* item );
+int ObjectPoolT_getUsed( ObjectPoolT const* p );
+int ObjectPoolT_getCapacity( ObjectPoolT const* p );
+bool ObjectPoolT_isFull( ObjectPoolT const* p );
+#endif
+
+#endif
+///@}
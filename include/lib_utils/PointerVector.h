@@ -27,6 +27,8 @@ bool Pointer_ctorCopy(Pointer* dst, Pointer const* src);
 bool Pointer_ctorMove(Pointer* dst, Pointer const* src);
 bool Pointer_assign(Pointer* dst, Pointer const* src);
 bool Pointer_isEqual(Pointer const * a, Pointer const * b);
+uint32_t Pointer_hash(Pointer const* key);
+int Pointer_compare(Pointer const* a, Pointer const* b);
 
 VectorT_DECLARE(Pointer, PointerVector, size_t);
 
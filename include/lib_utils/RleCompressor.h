@@ -19,6 +19,7 @@
 
 #include "OS_Error.h"
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -29,6 +30,86 @@
  */
 #define RLECOMPRESSOR_MAX_INPUT_SIZE ((1ul << 30) - 1)
 
+/**
+ * There are two versions of the format, both start with a 7 byte header: three
+ * magic bytes and the decompressed length as little endian uint32.
+ *
+ * Version 1 ("RLE") encodes every run, even of length 1, as a length field
+ * followed by the symbol, so incompressible data can double in size.
+ *
+ * Version 2 ("RL2") uses the same length fields, but their lowest bit tells
+ * whether a symbol or a literal run of raw bytes follows. Short runs are kept
+ * in literal runs, so the output is never larger than the input plus the
+ * header plus 4 bytes for every (2^29)-1 bytes of input, i.e. at most
+ * ilen + 19 bytes.
+ *
+ * All decoders accept both versions.
+ *
+ * The block framed format ("RLB") splits the input into blocks of a fixed
+ * size, each of them encoded as an independent version 2 stream. It starts
+ * with the block framed header: the magic, the decompressed length and the
+ * block size as little endian uint32, then the offset of the end of every
+ * block, counted from the end of the offsets, as little endian uint32. The
+ * blocks can be encoded and decoded in parallel, and a range of the data can be
+ * decoded without decoding the blocks in front of it. Only the block functions
+ * accept this format.
+ */
+
+/**
+ * Size of the scratch buffer of a stream, it can hold the header or one encoded
+ * symbol, whichever is longer
+ */
+#define RLECOMPRESSOR_STREAM_BUFFER_SIZE 7
+
+/**
+ * State of an incremental encoder, see RleCompressor_CompressStream_init().
+ * The members are private.
+ */
+typedef struct
+{
+    size_t  ilen;       ///< total length of the input, as given to init
+    size_t  consumed;   ///< input consumed so far
+    size_t  runLen;     ///< length of the current run, 0 if there is none
+    uint8_t sym;        ///< symbol of the current run
+    uint8_t buf[RLECOMPRESSOR_STREAM_BUFFER_SIZE]; ///< encoded, not written
+    size_t  bufPos;     ///< next byte of buf to write
+    size_t  bufLen;     ///< number of valid bytes in buf
+} RleCompressor_CompressStream;
+
+/**
+ * State of an incremental decoder, see RleCompressor_DecompressStream_init().
+ * The members are private.
+ */
+typedef struct
+{
+    bool    hasHeader;  ///< the header has been read
+    int     version;    ///< format version, as given by the header
+    size_t  olen;       ///< decompressed length, as given by the header
+    size_t  decoded;    ///< sum of the lengths of the runs read so far
+    size_t  runLeft;    ///< bytes of the current run not written yet
+    bool    literal;    ///< the current run is a literal run
+    bool    needSym;    ///< the symbol of the current run is still missing
+    uint8_t sym;        ///< symbol of the current run
+    uint8_t buf[RLECOMPRESSOR_STREAM_BUFFER_SIZE]; ///< partial header/symbol
+    size_t  bufLen;     ///< number of valid bytes in buf
+} RleCompressor_DecompressStream;
+
+/**
+ * A job of the block functions, processing the block with the given index.
+ * Jobs with different indices do not share any data and can run in parallel.
+ */
+typedef OS_Error_t (*RleCompressor_Job)(void* ctx, size_t index);
+
+/**
+ * Hook to run the jobs of the block functions, e.g. on a pool of worker
+ * threads. It has to call \p job with \p ctx once for every index from 0 to
+ * \p n - 1, in any order and on any thread, and return only when all calls
+ * have returned: OS_SUCCESS if all of them succeeded, otherwise the error of
+ * any of the failed ones.
+ */
+typedef OS_Error_t (*RleCompressor_Runner)(void* pool, size_t n,
+                                           RleCompressor_Job job, void* ctx);
+
 /**
  * @brief Compress a buffer with RLE encoder
  *
@@ -58,6 +139,36 @@ RleCompressor_compress(
     size_t*        olen,
     uint8_t**      obuf);
 
+/**
+ * @brief Compress a buffer with RLE encoder, using version 2 of the format
+ *
+ * Same as RleCompressor_compress(), but writes version 2 of the format, which
+ * bounds the growth of incompressible data. The output can only be read by
+ * decoders which know about version 2.
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer
+ * @param osz (optional) size of output buffer, set to 0 to let function allocate
+ *  correctly sized \p obuf
+ * @param olen (required) length of compressed data in \p obuf
+ * @param obuf (required) pointer to output buffer
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if any of the buffers was too small
+ * @retval OS_ERROR_INSUFFICIENT_SPACE if some allocation failed
+ * @retval OS_ERROR_ABORTED if encoding was aborted due to reaching limit
+ *  of \p obuf buffer
+ */
+OS_Error_t
+RleCompressor_compressV2(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    size_t*        olen,
+    uint8_t**      obuf);
+
 /**
  * @brief Decompress a buffer with RLE encoder
  *
@@ -75,8 +186,8 @@ RleCompressor_compress(
  * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
  * @retval OS_ERROR_BUFFER_TOO_SMALL if any of the buffers was too small
  * @retval OS_ERROR_INSUFFICIENT_SPACE if some allocation failed
- * @retval OS_ERROR_ABORTED if encoding was aborted due to reaching limit
- *  of \p obuf buffer
+ * @retval OS_ERROR_ABORTED if decoding was aborted due to reaching limit
+ *  of \p obuf buffer, or because \p ibuf is truncated or corrupted
  */
 OS_Error_t
 RleCompressor_decompress(
@@ -86,4 +197,371 @@ RleCompressor_decompress(
     size_t*        olen,
     uint8_t**      obuf);
 
+/**
+ * @brief Get the size of the RLE encoding of a buffer
+ *
+ * Runs over \p ibuf counting the bytes RleCompressor_compress() would write,
+ * header included, without writing anything. It allows to allocate the output
+ * buffer with the exact size.
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer
+ * @param olen (required) length of the compressed data
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ */
+OS_Error_t
+RleCompressor_getCompressedSize(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen);
+
+/**
+ * @brief Get the size of the version 2 RLE encoding of a buffer
+ *
+ * Same as RleCompressor_getCompressedSize(), for RleCompressor_compressV2().
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer
+ * @param olen (required) length of the compressed data
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ */
+OS_Error_t
+RleCompressor_getCompressedSizeV2(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen);
+
+/**
+ * @brief Get the decompressed size of RLE encoded data
+ *
+ * Reads the decompressed size from the header of \p ibuf.
+ *
+ * @param ilen (required) length of input buffer data, at least the header
+ * @param ibuf (required) input buffer with compressed data
+ * @param olen (required) length of the data after decompression
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if \p ibuf cannot hold the header
+ * @retval OS_ERROR_INVALID_STATE if the magic header is wrong
+ */
+OS_Error_t
+RleCompressor_getDecompressedSize(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen);
+
+/**
+ * @brief Get the buffer size needed to decompress RLE encoded data in place
+ *
+ * For RleCompressor_decompressInPlace() the compressed data is stored at the
+ * end of a buffer which then receives the decompressed data from its start.
+ * This function validates \p ibuf and computes the smallest buffer for which
+ * the output never overwrites input that has not been read yet. The result is
+ * never less than the decompressed size and usually only a few bytes more.
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer with compressed data
+ * @param bsz (required) minimum size of the buffer to decompress in place
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if \p ibuf cannot hold the header
+ * @retval OS_ERROR_INVALID_STATE if the magic header is wrong
+ * @retval OS_ERROR_ABORTED if \p ibuf is truncated or corrupted
+ */
+OS_Error_t
+RleCompressor_getInPlaceSize(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        bsz);
+
+/**
+ * @brief Decompress RLE encoded data in place
+ *
+ * Decompresses the \p ilen bytes of compressed data stored at the end of
+ * \p buf, i.e. at \p buf + \p bsz - \p ilen, to the start of \p buf. The
+ * whole input is validated before anything is written, so if the function
+ * fails the input is left intact.
+ *
+ * @param bsz (required) size of the buffer, see RleCompressor_getInPlaceSize()
+ * @param buf (required) buffer with the compressed data at its end
+ * @param ilen (required) length of the compressed data
+ * @param olen (required) length of the decompressed data at the start of
+ *  \p buf
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if the input is too short to hold the
+ *  header or \p bsz is too small to decompress in place
+ * @retval OS_ERROR_INVALID_STATE if the magic header is wrong
+ * @retval OS_ERROR_ABORTED if the input is truncated or corrupted
+ */
+OS_Error_t
+RleCompressor_decompressInPlace(
+    const size_t bsz,
+    uint8_t*     buf,
+    const size_t ilen,
+    size_t*      olen);
+
+/**
+ * @brief Compress a buffer into independent blocks
+ *
+ * Performs RLE encoding on \p ibuf with the block framed format, each block
+ * of \p bsize bytes (the last one may be shorter) is encoded with version 2
+ * of the format. The blocks are first sized and then encoded in two rounds of
+ * jobs passed to \p runner, so that the output is written in place with its
+ * exact size. Can allocate correctly sized output buffer \p obuf if \p osz is
+ * set to zero.
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer
+ * @param bsize (required) size of a block, small blocks give more parallelism
+ *  and faster random access but compress less
+ * @param runner (optional) hook running the jobs, set to NULL to run them one
+ *  after the other on the calling thread
+ * @param pool (optional) argument passed to \p runner
+ * @param osz (optional) size of output buffer, set to 0 to let function allocate
+ *  correctly sized \p obuf
+ * @param olen (required) length of compressed data in \p obuf
+ * @param obuf (required) pointer to output buffer
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid, or
+ *  the output would be too large for the offsets
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if any of the buffers was too small
+ * @retval OS_ERROR_INSUFFICIENT_SPACE if some allocation failed
+ * @retval other errors returned by \p runner are passed on
+ */
+OS_Error_t
+RleCompressor_compressBlocks(
+    const size_t         ilen,
+    const uint8_t*       ibuf,
+    const size_t         bsize,
+    RleCompressor_Runner runner,
+    void*                pool,
+    const size_t         osz,
+    size_t*              olen,
+    uint8_t**            obuf);
+
+/**
+ * @brief Decompress a buffer of independent blocks
+ *
+ * Performs RLE decoding on \p ibuf, which has to be in the block framed format,
+ * with one job per block passed to \p runner. Can allocate correctly sized
+ * output buffer \p obuf if \p osz is set to zero.
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer with compressed data
+ * @param runner (optional) hook running the jobs, set to NULL to run them one
+ *  after the other on the calling thread
+ * @param pool (optional) argument passed to \p runner
+ * @param osz (optional) size of output buffer, set to 0 to let function allocate
+ *  correctly sized \p obuf
+ * @param olen (required) length of decompressed data in \p obuf
+ * @param obuf (required) pointer to output buffer
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if any of the buffers was too small
+ * @retval OS_ERROR_INSUFFICIENT_SPACE if some allocation failed
+ * @retval OS_ERROR_INVALID_STATE if a magic header is wrong
+ * @retval OS_ERROR_ABORTED if \p ibuf is truncated or corrupted
+ * @retval other errors returned by \p runner are passed on
+ */
+OS_Error_t
+RleCompressor_decompressBlocks(
+    const size_t         ilen,
+    const uint8_t*       ibuf,
+    RleCompressor_Runner runner,
+    void*                pool,
+    const size_t         osz,
+    size_t*              olen,
+    uint8_t**            obuf);
+
+/**
+ * @brief Decompress a range of a buffer of independent blocks
+ *
+ * Decodes the \p len bytes of decompressed data starting at \p offset, only
+ * the blocks overlapping with this range are read.
+ *
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer with compressed data in the block
+ *  framed format
+ * @param offset (required) offset of the range in the decompressed data
+ * @param len (required) length of the range
+ * @param obuf (required) output buffer of at least \p len bytes
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid, or
+ *  the range exceeds the decompressed data
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if \p ibuf cannot hold the header
+ * @retval OS_ERROR_INVALID_STATE if a magic header is wrong
+ * @retval OS_ERROR_ABORTED if \p ibuf is truncated or corrupted
+ */
+OS_Error_t
+RleCompressor_decompressBlocksAt(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   offset,
+    const size_t   len,
+    uint8_t*       obuf);
+
+/**
+ * @brief Start incremental RLE encoding
+ *
+ * The stream API produces exactly the same output as RleCompressor_compress(),
+ * but the input can be passed in chunks as it becomes available and the output
+ * is written into buffers of any size, so that the memory needed is a small
+ * fixed state instead of buffers proportional to the input. As the header
+ * holds the decompressed size, the total length of the input has to be known
+ * in advance.
+ *
+ * @param self (required) stream state to initialize
+ * @param ilen (required) total length of the input that will be passed to
+ *  RleCompressor_CompressStream_update()
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ */
+OS_Error_t
+RleCompressor_CompressStream_init(
+    RleCompressor_CompressStream* self,
+    const size_t                  ilen);
+
+/**
+ * @brief Encode a chunk of input
+ *
+ * Encodes as much of \p ibuf as possible into \p obuf. A run may span any
+ * number of chunks, it is written only once it ends. If \p obuf gets full,
+ * then \p iused is less than \p ilen and the caller has to pass the rest of
+ * the input again along with a new output buffer.
+ *
+ * @param self (required) stream state
+ * @param ilen (required) length of input buffer data
+ * @param ibuf (required) input buffer
+ * @param iused (required) number of bytes consumed from \p ibuf
+ * @param osz (required) size of output buffer
+ * @param olen (required) number of bytes written to \p obuf
+ * @param obuf (required) output buffer
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid, or
+ *  the input exceeds the total length given to init
+ */
+OS_Error_t
+RleCompressor_CompressStream_update(
+    RleCompressor_CompressStream* self,
+    const size_t                  ilen,
+    const uint8_t*                ibuf,
+    size_t*                       iused,
+    const size_t                  osz,
+    size_t*                       olen,
+    uint8_t*                      obuf);
+
+/**
+ * @brief Finish incremental RLE encoding
+ *
+ * Writes the last run and any encoded data still held by the stream. If
+ * \p obuf is too small for all of it, the function has to be called again with
+ * a new output buffer.
+ *
+ * @param self (required) stream state
+ * @param osz (required) size of output buffer
+ * @param olen (required) number of bytes written to \p obuf
+ * @param obuf (required) output buffer
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if the encoding is complete
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_INVALID_STATE if less input than announced was passed
+ * @retval OS_ERROR_BUFFER_TOO_SMALL if \p obuf is full, call again
+ */
+OS_Error_t
+RleCompressor_CompressStream_finish(
+    RleCompressor_CompressStream* self,
+    const size_t                  osz,
+    size_t*                       olen,
+    uint8_t*                      obuf);
+
+/**
+ * @brief Start incremental RLE decoding
+ *
+ * The stream API accepts the output of RleCompressor_compress() or of the
+ * compress stream in chunks of any size and writes the decompressed data into
+ * output buffers of any size, e.g. a flash write window.
+ *
+ * @param self (required) stream state to initialize
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ */
+OS_Error_t
+RleCompressor_DecompressStream_init(
+    RleCompressor_DecompressStream* self);
+
+/**
+ * @brief Decode a chunk of compressed input
+ *
+ * Decodes as much of \p ibuf as possible into \p obuf. If \p obuf gets
+ * full, then \p iused may be less than \p ilen and the caller has to pass
+ * the rest of the input again along with a new output buffer; a pending run
+ * is continued even if no more input is passed.
+ *
+ * @param self (required) stream state
+ * @param ilen (required) length of input buffer data, may be 0
+ * @param ibuf (required) input buffer with compressed data
+ * @param iused (required) number of bytes consumed from \p ibuf
+ * @param osz (required) size of output buffer
+ * @param olen (required) number of bytes written to \p obuf
+ * @param obuf (required) output buffer
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if operation succeeded
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_INVALID_STATE if the magic header is wrong
+ * @retval OS_ERROR_ABORTED if the data exceeds the length in the header
+ */
+OS_Error_t
+RleCompressor_DecompressStream_update(
+    RleCompressor_DecompressStream* self,
+    const size_t                    ilen,
+    const uint8_t*                  ibuf,
+    size_t*                         iused,
+    const size_t                    osz,
+    size_t*                         olen,
+    uint8_t*                        obuf);
+
+/**
+ * @brief Finish incremental RLE decoding
+ *
+ * Checks that all the data announced by the header has been decoded and
+ * written.
+ *
+ * @param self (required) stream state
+ *
+ * @return an error code
+ * @retval OS_SUCCESS if the decoding is complete
+ * @retval OS_ERROR_INVALID_PARAMETER if a parameter was missing or invalid
+ * @retval OS_ERROR_ABORTED if the input was truncated or output is pending
+ */
+OS_Error_t
+RleCompressor_DecompressStream_finish(
+    RleCompressor_DecompressStream* self);
+
 ///@}
@@ -21,17 +21,79 @@
 extern "C" {
 #endif
 
+#include "lib_compiler/compiler.h"
 #include "lib_mem/Memory.h"
 #include "lib_debug/Debug.h"
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <limits.h>
 
 #if !defined(Vector_MAX_SIZE)
 #define Vector_MAX_SIZE INT_MAX
 #endif
 
+#if defined(LIB_UTILS_STATS)
+/**
+ * Counters of a vector, see VectorT_getStats(). They are reset by the
+ * constructors only.
+ */
+typedef struct
+{
+    size_t reallocations;   ///< grows, reserves and shrinks of the buffer
+    size_t failedGrowths;   ///< VectorT_resizeIfNeeded() could not make room
+}
+VectorT_Stats;
+
+#   define VectorT_STATS_FIELD_         VectorT_Stats stats_;
+#   define VectorT_STATS_(stmt__)       do { stmt__; } while (0)
+#   define VectorT_GETSTATS_DECL_(N)    VectorT_Stats N##_getStats(N const* v);
+#   define VectorT_GETSTATS_IMPL_(N)                                        \
+    VectorT_Stats N##_getStats(N const* v)                                  \
+    {                                                                       \
+        return v->stats_;                                                   \
+    }
+#else
+#   define VectorT_STATS_FIELD_
+#   define VectorT_STATS_(stmt__)       ((void) 0)
+#   define VectorT_GETSTATS_DECL_(N)
+#   define VectorT_GETSTATS_IMPL_(N)
+#endif
+
+#define VectorT_STATS_INIT_(v__)                                            \
+    VectorT_STATS_(memset(&(v__)->stats_, 0, sizeof((v__)->stats_)))
+
+// The declarations shared by the dynamic and the fixed vectors.
+#define VectorT_DECLARE_ELEMENTS_(T, N, SIZE_T)                             \
+typedef bool (*N##_applyFn)(void* context, T const* element, SIZE_T pos);   \
+typedef bool (*N##_mutApplyFn)(void* context, T* element, SIZE_T pos);      \
+bool N##_pushBack(N* v, T);                                                 \
+bool N##_pushBackMove(N* v, T);                                             \
+bool N##_pushBackByPtr(N* v, T const*);                                     \
+bool N##_pushBackMoveByPtr(N* v, T const*);                                 \
+T* N##_emplaceBack(N* v);                                                   \
+void N##_cancelEmplace(N* v);                                               \
+T N##_getFront(N const* v);                                                 \
+T N##_getBack(N const* v);                                                  \
+void N##_popBack(N* v);                                                     \
+T N##_getElementAt(N const* v, SIZE_T n);                                   \
+T const* N##_getPtrToElementAt(N const* v, SIZE_T n);                       \
+T* N##_getMutPtrAt(N* v, SIZE_T n);                                         \
+bool N##_replaceElementAt(N* v, SIZE_T n, T newElement);                    \
+void N##_removeAtSwap(N* v, SIZE_T n);                                      \
+T const* N##_getData(N const* v);                                           \
+T* N##_getMutData(N* v);                                                    \
+SIZE_T N##_constApply(N const* v, N##_applyFn fn, void* context);           \
+SIZE_T N##_apply(N* v, N##_mutApplyFn fn, void* context);                   \
+SIZE_T N##_constApplyRange(N const* v, SIZE_T begin, SIZE_T end,            \
+                           N##_applyFn fn, void* context);                  \
+SIZE_T N##_applyRange(N* v, SIZE_T begin, SIZE_T end,                       \
+                      N##_mutApplyFn fn, void* context);                    \
+SIZE_T N##_getSize(N const* v);                                             \
+bool N##_isEmpty(N const* v);                                               \
+void N##_clear(N* v)
+
 /**
  * VectorT declaration macro. Use this in your header files.
  *
@@ -44,6 +106,19 @@ extern "C" {
  * bool T##_ctorCopy(T*, T const*) - copy constructor
  * bool T##_ctorMove(T*, T const*) - move constructor
  * bool T##_assign(T*, T const*)   - assignment.
+ *
+ * When the vector grows, the elements are relocated with T##_ctorMove(), the
+ * moved-from elements are not destroyed afterwards.
+ *
+ * If T can be copied with memcpy() and T##_dtor() does nothing, then the
+ * vector can be defined with VectorT_DEFINE_TRIVIAL() instead of
+ * VectorT_DEFINE(). The interface is the same, but growing and copying the
+ * vector is done with a single memcpy() instead of a call per element.
+ *
+ * If LIB_UTILS_STATS is defined, each vector counts its reallocations, see
+ * VectorT_getStats(). Otherwise the counters are not compiled in.
+ *
+ * See VectorT_DECLARE_FIXED() for a vector which embeds its storage.
  */
 
 #define VectorT_DECLARE(T, N, SIZE_T)                                       \
@@ -53,27 +128,78 @@ typedef struct                                                              \
     SIZE_T size_;                                                           \
     SIZE_T nextFree_;                                                       \
     bool isStatic_;                                                         \
+    unsigned growthPercent_;                                                \
+    SIZE_T growthIncrement_;                                                \
+    VectorT_STATS_FIELD_                                                    \
 } N;                                                                        \
+VectorT_GETSTATS_DECL_(N)                                                   \
 bool N##_ctor(N* v, SIZE_T defaultSize);                                    \
 bool N##_ctorStatic(N* v, void* buffer, SIZE_T defaultSize);                \
 bool N##_ctorCopy(N* v, N const* s);                                        \
 void N##_dtor(N* v);                                                        \
 N* N##_new(SIZE_T defaultSize);                                             \
 void N##_del(N* v);                                                         \
-bool N##_pushBack(N* v, T);                                                 \
-bool N##_pushBackMove(N* v, T);                                             \
-bool N##_pushBackByPtr(N* v, T const*);                                     \
-bool N##_pushBackMoveByPtr(N* v, T const*);                                 \
-T N##_getFront(N const* v);                                                 \
-T N##_getBack(N const* v);                                                  \
-void N##_popBack(N* v);                                                     \
-T N##_getElementAt(N const* v, SIZE_T n);                                   \
-T const* N##_getPtrToElementAt(N const* v, SIZE_T n);                       \
-bool N##_replaceElementAt(N* v, SIZE_T n, T newElement);                    \
-SIZE_T N##_getSize(N const* v);                                             \
-bool N##_isEmpty(N const* v);                                               \
-void N##_clear(N* v);                                                       \
-bool N##_resizeIfNeeded(N* v)
+VectorT_DECLARE_ELEMENTS_(T, N, SIZE_T);                                    \
+bool N##_resizeIfNeeded(N* v);                                              \
+bool N##_reserve(N* v, SIZE_T n);                                           \
+bool N##_shrinkToFit(N* v);                                                 \
+void N##_setGrowth(N* v, unsigned percent, SIZE_T increment)
+
+/**
+ * Fixed capacity VectorT declaration macro. Use this in your header files.
+ *
+ * @param T the base type you want to define the vector type of.
+ * @param N the name for the newly defined type.
+ * @param SIZE_T the type of the indices.
+ * @param CAP the capacity of the vector, a constant expression greater than 0
+ *            that SIZE_T can represent.
+ *
+ * The elements are stored in an array of CAP elements embedded in the vector
+ * itself, so the vector never allocates memory and its capacity is known at
+ * compile time. A vector in static storage is zero initialized, which is a
+ * valid empty vector, and can be used without calling the constructor.
+ *
+ * The vector must be defined with VectorT_DEFINE_FIXED() or with
+ * VectorT_DEFINE_FIXED_TRIVIAL(). It provides the element access of VectorT,
+ * #VectorT_resizeIfNeeded() fails when the vector is full. It has no
+ * VectorT_new(), VectorT_ctorStatic(), VectorT_reserve(),
+ * VectorT_shrinkToFit() and VectorT_setGrowth(), the constructor takes no
+ * size. The counters of LIB_UTILS_STATS record the failed growths only.
+ */
+
+#define VectorT_DECLARE_FIXED(T, N, SIZE_T, CAP)                            \
+typedef struct                                                              \
+{                                                                           \
+    SIZE_T nextFree_;                                                       \
+    VectorT_STATS_FIELD_                                                    \
+    T vector_[CAP];                                                         \
+} N;                                                                        \
+VectorT_GETSTATS_DECL_(N)                                                   \
+void N##_ctor(N* v);                                                        \
+bool N##_ctorCopy(N* v, N const* s);                                        \
+void N##_dtor(N* v);                                                        \
+VectorT_DECLARE_ELEMENTS_(T, N, SIZE_T);                                    \
+bool N##_resizeIfNeeded(N* v);                                              \
+SIZE_T N##_getCapacity(N const* v);                                         \
+bool N##_isFull(N const* v)
+
+/**
+ * @fn int VectorT_getCapacity( VectorT const* v )
+ *
+ * Available for the vectors declared with VectorT_DECLARE_FIXED() only.
+ *
+ * @param v a pointer to the vector.
+ * @return the number of elements the vector can hold, i.e. CAP.
+ */
+
+/**
+ * @fn bool VectorT_isFull( VectorT const* v )
+ *
+ * Available for the vectors declared with VectorT_DECLARE_FIXED() only.
+ *
+ * @param v a pointer to the vector.
+ * @return true if the vector holds CAP elements.
+ */
 
 /**
  * @fn bool VectorT_ctor( VectorT* v )
@@ -141,6 +267,31 @@ bool N##_resizeIfNeeded(N* v)
  *               the same state it was prior to this call.
  */
 
+/**
+ * @fn T* VectorT_emplaceBack( VectorT* v )
+ *
+ * Adds an element to the end of the container without constructing it. The
+ * caller constructs the object in place through the returned pointer, this
+ * avoids the temporary copies of #VectorT_pushBack().
+ *
+ * If the in place construction fails, the element has to be removed with
+ * #VectorT_cancelEmplace() before any other call on the vector.
+ *
+ * @param v a pointer to the container.
+ * @return a pointer to the uninitialized storage of the new last element, or
+ *         NULL if the vector can not grow. In this case the container is left
+ *         in the same state it was prior to this call.
+ */
+
+/**
+ * @fn void VectorT_cancelEmplace( VectorT* v )
+ *
+ * Removes the last element added with #VectorT_emplaceBack() without invoking
+ * its destructor.
+ *
+ * @param v a pointer to the container.
+ */
+
 /**
  * @fn T VectorT_getFront( VectorT const* v )
  *
@@ -206,6 +357,18 @@ bool N##_resizeIfNeeded(N* v)
  * @return a pointer to the item at position 'n'.
  */
 
+/**
+ * @fn T* VectorT_getMutPtrAt( VectorT* v, int n )
+ *
+ * Same as #VectorT_getPtrToElementAt(), but the element can be modified in
+ * place through the returned pointer.
+ *
+ * @param v a pointer to the vector.
+ * @param n the index you want to retrieve. It is an error to require a non
+ *          existing or invalid index.
+ * @return a pointer to the item at position 'n'.
+ */
+
 /**
  * @fn bool VectorT_replaceElementAt( VectorT* v, int n, T newElement )
  *
@@ -219,6 +382,100 @@ bool N##_resizeIfNeeded(N* v)
  * @retval false the operation failed.
  */
 
+/**
+ * @fn void VectorT_removeAtSwap( VectorT* v, int n )
+ *
+ * Removes the element at the given position in O(1). The element is destroyed
+ * and the last element is moved into its place with T_ctorMove(), hence the
+ * ordering of the elements is not preserved.
+ *
+ * @param v a pointer to the vector.
+ * @param n the position to remove. It is an error to specify a non existing
+ *          position.
+ */
+
+/**
+ * @fn T const* VectorT_getData( VectorT const* v )
+ *
+ * Retrieves the elements of the vector as a contiguous array of
+ * #VectorT_getSize() elements. A loop over the array has no call per element,
+ * so the compiler is free to unroll or vectorize it. The reference is valid as
+ * long as the one returned by #VectorT_getPtrToElementAt().
+ *
+ * @param v a pointer to the vector.
+ * @return a pointer to the first element of the vector.
+ */
+
+/**
+ * @fn T* VectorT_getMutData( VectorT* v )
+ *
+ * Same as #VectorT_getData(), but the elements can be modified in place.
+ *
+ * @param v a pointer to the vector.
+ * @return a pointer to the first element of the vector.
+ */
+
+/**
+ * @fn int VectorT_constApply( VectorT const* v, VectorT_applyFn fn,
+ *                             void* context )
+ *
+ * Applies a given function to all the elements of the vector, starting from
+ * the one at position 0.
+ *
+ * @param v a pointer to the vector.
+ * @param fn the function to apply, it has the signature
+ *           bool fn(void* context, T const* element, SIZE_T pos), where pos
+ *           is the position of the element and the return value has the
+ *           "continue" semantic.
+ * @param context a context pointer that is passed along with each element.
+ * @return the number of elements processed.
+ */
+
+/**
+ * @fn int VectorT_apply( VectorT* v, VectorT_mutApplyFn fn, void* context )
+ *
+ * Same as #VectorT_constApply(), but the function can modify the elements in
+ * place. The function must not add or remove elements.
+ *
+ * @param v a pointer to the vector.
+ * @param fn the function to apply, see #VectorT_constApply().
+ * @param context a context pointer that is passed along with each element.
+ * @return the number of elements processed.
+ */
+
+/**
+ * @fn int VectorT_constApplyRange( VectorT const* v, int begin, int end,
+ *                                  VectorT_applyFn fn, void* context )
+ *
+ * Same as #VectorT_constApply(), limited to the elements at the positions in
+ * [begin, end), an empty or inverted range processes none. Splitting the
+ * vector in disjoint ranges allows to process it with several threads, as
+ * long as none of them changes the vector itself.
+ *
+ * @param v a pointer to the vector.
+ * @param begin the position of the first element to process.
+ * @param end the position after the last element to process, it is an error
+ *        to specify a range beyond #VectorT_getSize().
+ * @param fn the function to apply, see #VectorT_constApply().
+ * @param context a context pointer that is passed along with each element.
+ * @return the number of elements processed.
+ */
+
+/**
+ * @fn int VectorT_applyRange( VectorT* v, int begin, int end,
+ *                             VectorT_mutApplyFn fn, void* context )
+ *
+ * Same as #VectorT_constApplyRange(), but the function can modify the
+ * elements in place, see #VectorT_apply().
+ *
+ * @param v a pointer to the vector.
+ * @param begin the position of the first element to process.
+ * @param end the position after the last element to process.
+ * @param fn the function to apply, see #VectorT_constApply().
+ * @param context a context pointer that is passed along with each element.
+ * @return the number of elements processed.
+ */
+
 /**
  * @fn int VectorT_getSize( VectorT const* v )
  *
@@ -247,6 +504,60 @@ bool N##_resizeIfNeeded(N* v)
  * @param v a pointer to the vector.
  */
 
+/**
+ * @fn bool VectorT_reserve( VectorT* v, int n )
+ *
+ * Makes sure the vector can hold at least 'n' elements without growing. This
+ * avoids the repeated reallocations when the final size is known in advance.
+ *
+ * @param v a pointer to the vector.
+ * @param n the number of elements to reserve space for.
+ * With Memory_Config_STATIC every vector is static, so this only checks the
+ * capacity and returns false if 'n' is beyond the buffer.
+ *
+ * @retval true the vector can hold 'n' elements.
+ * @retval false the vector is static and too small, or the system ran out of
+ *               memory. In this case the container is left unchanged.
+ */
+
+/**
+ * @fn bool VectorT_shrinkToFit( VectorT* v )
+ *
+ * Releases the memory which is not used by the elements of the vector. This
+ * is not applicable to a static vector, whose buffer belongs to the caller:
+ * the method then does nothing and returns true. With Memory_Config_STATIC
+ * every vector is static, so the method never changes the vector.
+ *
+ * @param v a pointer to the vector.
+ * @retval true the operation has been successfully completed.
+ * @retval false the system ran out of memory. In this case the container is
+ *               left unchanged.
+ */
+
+/**
+ * @fn VectorT_Stats VectorT_getStats( VectorT const* v )
+ *
+ * Retrieves the counters of the vector, available only if LIB_UTILS_STATS is
+ * defined.
+ *
+ * @param v a pointer to the vector.
+ * @return a copy of the counters.
+ */
+
+/**
+ * @fn void VectorT_setGrowth( VectorT* v, unsigned percent, int increment )
+ *
+ * Sets how the vector grows when an element is added to a full vector. The new
+ * capacity is the old one, plus 'percent' percent of it, plus 'increment'
+ * elements, but at least one element more. The default is to double the
+ * capacity (percent 100, increment 0); use e.g. percent 50 for a factor 1.5 or
+ * percent 0 for a fixed increment.
+ *
+ * @param v a pointer to the vector.
+ * @param percent the relative growth, in percent of the current capacity.
+ * @param increment the absolute growth, in elements.
+ */
+
 #define VectorT_SIZE_OF_BUFFER(T__, numItems)   (sizeof(T__) * numItems)
 
 #define VectorT_ASSERTInvariants(T__, N__, V__, SIZE_T)                     \
@@ -266,12 +577,29 @@ bool N##_resizeIfNeeded(N* v)
 #if defined(Memory_Config_STATIC)
 #   define VectorT_DEFINE_CTOR(T, N, SIZE_T)
 #   define VectorT_DEFINE_CTOR_COPY(T, N, SIZE_T)
+#   define VectorT_DEFINE_CTOR_COPY_TRIVIAL(T, N, SIZE_T)
 #   define VectorT_DEFINE_NEW(T, N, SIZE_T)
 #   define VectorT_DEFINE_DEL(T, N, SIZE_T)
-#   define VectorT_DEFINE_RESIZE_IF_NEEDED(T, N, SIZE_T)                    \
+#   define VectorT_DEFINE_RELOCATE(T, N, SIZE_T)
+#   define VectorT_DEFINE_RELOCATE_TRIVIAL(T, N, SIZE_T)
+#   define VectorT_DEFINE_RESIZE(T, N, SIZE_T)                              \
     bool N##_resizeIfNeeded(N* v)                                           \
     {                                                                       \
-        return (v->nextFree_ < v->size_)                                    \
+        bool retval = (v->nextFree_ < v->size_);                            \
+                                                                            \
+        VectorT_STATS_(v->stats_.failedGrowths += !retval);                 \
+        return retval;                                                      \
+    }                                                                       \
+                                                                            \
+    bool N##_reserve(N* v, SIZE_T n)                                        \
+    {                                                                       \
+        return (n <= v->size_);                                             \
+    }                                                                       \
+                                                                            \
+    bool N##_shrinkToFit(N* v)                                              \
+    {                                                                       \
+        (void) v;                                                           \
+        return true;                                                        \
     }
 #else
 #   define VectorT_DEFINE_CTOR(T, N, SIZE_T)                                \
@@ -285,6 +613,9 @@ bool N##_resizeIfNeeded(N* v)
         v->size_        = defaultSize;                                      \
         v->nextFree_    = 0;                                                \
         v->isStatic_    = false;                                            \
+        v->growthPercent_   = 100;                                          \
+        v->growthIncrement_ = 0;                                            \
+        VectorT_STATS_INIT_(v);                                             \
         return true;                                                        \
     }
 #   define VectorT_DEFINE_CTOR_COPY(T, N, SIZE_T)                           \
@@ -297,13 +628,17 @@ bool N##_resizeIfNeeded(N* v)
         }                                                                   \
         v->size_ = s->size_;                                                \
         v->nextFree_ = s->nextFree_;                                        \
+        v->isStatic_ = false;                                               \
+        v->growthPercent_ = s->growthPercent_;                              \
+        v->growthIncrement_ = s->growthIncrement_;                          \
+        VectorT_STATS_INIT_(v);                                             \
                                                                             \
         for (SIZE_T i = 0; i < v->nextFree_; ++i)                           \
         {                                                                   \
             if (!T##_ctorCopy(&v->vector_[i], &s->vector_[i]))              \
             {                                                               \
                 /* rollback */                                              \
-                for (--i ; i>= 0; --i)                                      \
+                while (i-- > 0)                                             \
                 {                                                           \
                     T##_dtor(&v->vector_[i]);                               \
                 }                                                           \
@@ -313,6 +648,23 @@ bool N##_resizeIfNeeded(N* v)
         }                                                                   \
         return true;                                                        \
     }
+#   define VectorT_DEFINE_CTOR_COPY_TRIVIAL(T, N, SIZE_T)                   \
+    bool N##_ctorCopy(N* v, N const* s)                                     \
+    {                                                                       \
+        v->vector_ = Memory_alloc(s->size_ * sizeof(T));                    \
+        if (v->vector_ == NULL)                                             \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        v->size_ = s->size_;                                                \
+        v->nextFree_ = s->nextFree_;                                        \
+        v->isStatic_ = false;                                               \
+        v->growthPercent_ = s->growthPercent_;                              \
+        v->growthIncrement_ = s->growthIncrement_;                          \
+        VectorT_STATS_INIT_(v);                                             \
+        memcpy(v->vector_, s->vector_, s->nextFree_ * sizeof(T));           \
+        return true;                                                        \
+    }
 #   define VectorT_DEFINE_NEW(T, N, SIZE_T)                                 \
     N* N##_new(SIZE_T defaultSize)                                          \
     {                                                                       \
@@ -337,89 +689,124 @@ bool N##_resizeIfNeeded(N* v)
             Memory_free(v);                                                 \
         }                                                                   \
     }
-#   define VectorT_DEFINE_RESIZE_IF_NEEDED(T, N, SIZE_T)                    \
-    bool N##_resizeIfNeeded(N* v)                                           \
+#   define VectorT_DEFINE_RELOCATE(T, N, SIZE_T)                            \
+    static bool N##_relocate(N* v, size_t newSize)                          \
     {                                                                       \
-        bool retval = false;                                                \
+        T* newVector = NULL;                                                \
+        SIZE_T i = 0;                                                       \
+        bool retval = true;                                                 \
                                                                             \
-        if (v->nextFree_ < v->size_)                                        \
+        if (newSize <= Vector_MAX_SIZE)                                     \
+            newVector = Memory_alloc(newSize * sizeof(T));                  \
+                                                                            \
+        if (newVector == NULL)                                              \
         {                                                                   \
-            retval = true;                                                  \
+            return false;                                                   \
         }                                                                   \
-        else if (v->isStatic_)                                              \
+        /* relocate, moved-from elements are not destroyed */               \
+        for (; i < v->nextFree_ && retval; ++i)                             \
         {                                                                   \
-            retval = false;                                                 \
+            retval = T##_ctorMove(&newVector[i], &v->vector_[i]);           \
+        }                                                                   \
+        if (retval)                                                         \
+        {                                                                   \
+            Memory_free(v->vector_);                                        \
+            v->vector_  = newVector;                                        \
+            v->size_    = newSize;                                          \
+            VectorT_STATS_(v->stats_.reallocations++);                      \
         }                                                                   \
         else                                                                \
         {                                                                   \
-            T* newVector = NULL;                                            \
-            SIZE_T newSize = 2 * v->size_;                                  \
-                                                                            \
-            if (newSize <= Vector_MAX_SIZE)                                 \
-                newVector = Memory_alloc(newSize * sizeof(T));              \
-                                                                            \
-            if (newVector == NULL)                                          \
-            {                                                               \
-                retval = false;                                             \
-            }                                                               \
-            else                                                            \
+            /* move back what has been relocated so far */                  \
+            for (--i; i > 0; --i)                                           \
             {                                                               \
-                SIZE_T i = 0;                                               \
-                retval = true;                                              \
-                                                                            \
-                for (; i < v->size_ && retval; ++i)                         \
-                {                                                           \
-                    retval = T##_ctorCopy(&newVector[i], &v->vector_[i]);   \
-                    T##_dtor(&v->vector_[i]);                               \
-                }                                                           \
-                for (; i > 0 && !retval; i--)                               \
-                {                                                           \
-                    T##_dtor(&newVector[i]);                                \
-                }                                                           \
-                Memory_free(v->vector_);                                    \
-                v->vector_  = newVector;                                    \
-                v->size_    = newSize;                                      \
+                T##_ctorMove(&v->vector_[i-1], &newVector[i-1]);            \
             }                                                               \
+            Memory_free(newVector);                                         \
         }                                                                   \
         return retval;                                                      \
     }
-#endif
-
-#define VectorT_DEFINE(T, N, SIZE_T)                                        \
+#   define VectorT_DEFINE_RELOCATE_TRIVIAL(T, N, SIZE_T)                    \
+    static bool N##_relocate(N* v, size_t newSize)                          \
+    {                                                                       \
+        T* newVector = NULL;                                                \
                                                                             \
-    VectorT_DEFINE_CTOR(T, N, SIZE_T)                                       \
+        if (newSize <= Vector_MAX_SIZE)                                     \
+            newVector = Memory_alloc(newSize * sizeof(T));                  \
                                                                             \
-    bool N##_ctorStatic(N* v, void* buffer, SIZE_T defaultSize)             \
-    {                                                                       \
-        v->vector_ = buffer;                                                \
-        if (v->vector_ == NULL)                                             \
+        if (newVector == NULL)                                              \
         {                                                                   \
             return false;                                                   \
         }                                                                   \
-        v->size_        = defaultSize;                                      \
-        v->nextFree_    = 0;                                                \
-        v->isStatic_    = true;                                             \
+        memcpy(newVector, v->vector_, v->nextFree_ * sizeof(T));            \
+        Memory_free(v->vector_);                                            \
+        v->vector_  = newVector;                                            \
+        v->size_    = newSize;                                              \
+        VectorT_STATS_(v->stats_.reallocations++);                          \
         return true;                                                        \
-    }                                                                       \
-                                                                            \
-    VectorT_DEFINE_CTOR_COPY(T, N, SIZE_T)                                  \
-                                                                            \
-    void N##_dtor(N* v)                                                     \
+    }
+#   define VectorT_DEFINE_RESIZE(T, N, SIZE_T)                              \
+    bool N##_resizeIfNeeded(N* v)                                           \
     {                                                                       \
-        for (SIZE_T i = 0; i < v->nextFree_; ++i)                           \
+        bool retval = false;                                                \
+                                                                            \
+        if (v->nextFree_ < v->size_)                                        \
         {                                                                   \
-            T##_dtor(&v->vector_[i]);                                       \
+            retval = true;                                                  \
         }                                                                   \
-        if (!v->isStatic_)                                                  \
+        else if (v->isStatic_)                                              \
         {                                                                   \
-            Memory_free(v->vector_);                                        \
+            retval = false;                                                 \
         }                                                                   \
+        else                                                                \
+        {                                                                   \
+            size_t grow = ((size_t) v->size_ * v->growthPercent_) / 100     \
+                          + v->growthIncrement_;                            \
+                                                                            \
+            retval = N##_relocate(v, v->size_ + ((grow > 0) ? grow : 1));   \
+        }                                                                   \
+        VectorT_STATS_(v->stats_.failedGrowths += !retval);                 \
+        return retval;                                                      \
     }                                                                       \
                                                                             \
-    VectorT_DEFINE_NEW(T, N, SIZE_T)                                        \
+    bool N##_reserve(N* v, SIZE_T n)                                        \
+    {                                                                       \
+        if (n <= v->size_)                                                  \
+        {                                                                   \
+            return true;                                                    \
+        }                                                                   \
+        return !v->isStatic_ && N##_relocate(v, n);                         \
+    }                                                                       \
                                                                             \
-    VectorT_DEFINE_DEL(T, N, SIZE_T)                                        \
+    bool N##_shrinkToFit(N* v)                                              \
+    {                                                                       \
+        if (v->isStatic_ || v->nextFree_ == v->size_)                       \
+        {                                                                   \
+            return true;                                                    \
+        }                                                                   \
+        /* keep room for one element, an empty buffer can not grow */       \
+        return N##_relocate(v, (v->nextFree_ > 0) ? v->nextFree_ : 1);      \
+    }
+#endif
+
+// The range apply functions, CONST is either const or empty.
+#define VectorT_DEFINE_APPLY_RANGE_(T, N, SIZE_T, NAME, FN, CONST)          \
+    SIZE_T N##_##NAME(N CONST* v, SIZE_T begin, SIZE_T end,                 \
+                      N##_##FN fn, void* context)                           \
+    {                                                                       \
+        Debug_ASSERT(end <= v->nextFree_);                                  \
+        SIZE_T i = begin;                                                   \
+        bool cont = true;                                                   \
                                                                             \
+        for (; i < end && cont; ++i)                                        \
+        {                                                                   \
+            cont = fn(context, &v->vector_[i], i);                          \
+        }                                                                   \
+        return i - begin;                                                   \
+    }
+
+// The implementation shared by the dynamic and the fixed vectors.
+#define VectorT_DEFINE_ELEMENTS_(T, N, SIZE_T)                              \
     bool N##_pushBackByPtr(N* v, T const* item)                             \
     {                                                                       \
         bool retval = true;                                                 \
@@ -484,6 +871,21 @@ bool N##_resizeIfNeeded(N* v)
         return retval;                                                      \
     }                                                                       \
                                                                             \
+    T* N##_emplaceBack(N* v)                                                \
+    {                                                                       \
+        if (!N##_resizeIfNeeded(v))                                         \
+        {                                                                   \
+            return NULL;                                                    \
+        }                                                                   \
+        return &v->vector_[v->nextFree_++];                                 \
+    }                                                                       \
+                                                                            \
+    void N##_cancelEmplace(N* v)                                            \
+    {                                                                       \
+        Debug_ASSERT(v->nextFree_ > 0);                                     \
+        --v->nextFree_;                                                     \
+    }                                                                       \
+                                                                            \
     void N##_popBack(N* v)                                                  \
     {                                                                       \
         if (v->nextFree_ > 0)                                               \
@@ -518,6 +920,12 @@ bool N##_resizeIfNeeded(N* v)
     }                                                                       \
                                                                             \
     T const* N##_getPtrToElementAt(N const* v, SIZE_T n)                    \
+    {                                                                       \
+        Debug_ASSERT(n >= 0 && n < v->nextFree_);                           \
+        return &v->vector_[n];                                              \
+    }                                                                       \
+                                                                            \
+    T* N##_getMutPtrAt(N* v, SIZE_T n)                                      \
     {                                                                       \
         Debug_ASSERT(n >= 0 && n < v->nextFree_);                           \
         return &v->vector_[n];                                              \
@@ -529,6 +937,47 @@ bool N##_resizeIfNeeded(N* v)
         return T##_assign(&v->vector_[n], &newElement);                     \
     }                                                                       \
                                                                             \
+    void N##_removeAtSwap(N* v, SIZE_T n)                                   \
+    {                                                                       \
+        Debug_ASSERT(n >= 0 && n < v->nextFree_);                           \
+        SIZE_T last = v->nextFree_ - 1;                                     \
+                                                                            \
+        T##_dtor(&v->vector_[n]);                                           \
+        if (n != last)                                                      \
+        {                                                                   \
+            /* the moved-from last element is not destroyed */              \
+            DECL_UNUSED_VAR(const bool ok) =                                \
+                T##_ctorMove(&v->vector_[n], &v->vector_[last]);            \
+            Debug_ASSERT(ok);                                               \
+        }                                                                   \
+        v->nextFree_ = last;                                                \
+    }                                                                       \
+                                                                            \
+    T const* N##_getData(N const* v)                                        \
+    {                                                                       \
+        return v->vector_;                                                  \
+    }                                                                       \
+                                                                            \
+    T* N##_getMutData(N* v)                                                 \
+    {                                                                       \
+        return v->vector_;                                                  \
+    }                                                                       \
+                                                                            \
+    VectorT_DEFINE_APPLY_RANGE_(T, N, SIZE_T,                               \
+                                constApplyRange, applyFn, const)            \
+    VectorT_DEFINE_APPLY_RANGE_(T, N, SIZE_T,                               \
+                                applyRange, mutApplyFn, )                   \
+                                                                            \
+    SIZE_T N##_constApply(N const* v, N##_applyFn fn, void* context)        \
+    {                                                                       \
+        return N##_constApplyRange(v, 0, v->nextFree_, fn, context);        \
+    }                                                                       \
+                                                                            \
+    SIZE_T N##_apply(N* v, N##_mutApplyFn fn, void* context)                \
+    {                                                                       \
+        return N##_applyRange(v, 0, v->nextFree_, fn, context);             \
+    }                                                                       \
+                                                                            \
     SIZE_T N##_getSize(N const* v)                                          \
     {                                                                       \
         return v->nextFree_;                                                \
@@ -546,8 +995,149 @@ bool N##_resizeIfNeeded(N* v)
             T##_dtor(&v->vector_[i]);                                       \
         }                                                                   \
         v->nextFree_ = 0;                                                   \
+    }
+
+#define VectorT_DEFINE_(T, N, SIZE_T, CTOR_COPY__, RELOCATE__)              \
+                                                                            \
+    RELOCATE__(T, N, SIZE_T)                                                \
+                                                                            \
+    VectorT_DEFINE_CTOR(T, N, SIZE_T)                                       \
+                                                                            \
+    bool N##_ctorStatic(N* v, void* buffer, SIZE_T defaultSize)             \
+    {                                                                       \
+        v->vector_ = buffer;                                                \
+        if (v->vector_ == NULL)                                             \
+        {                                                                   \
+            return false;                                                   \
+        }                                                                   \
+        v->size_        = defaultSize;                                      \
+        v->nextFree_    = 0;                                                \
+        v->isStatic_    = true;                                             \
+        v->growthPercent_   = 100;                                          \
+        v->growthIncrement_ = 0;                                            \
+        VectorT_STATS_INIT_(v);                                             \
+        return true;                                                        \
     }                                                                       \
-    VectorT_DEFINE_RESIZE_IF_NEEDED(T, N, SIZE_T)
+                                                                            \
+    CTOR_COPY__(T, N, SIZE_T)                                               \
+                                                                            \
+    void N##_dtor(N* v)                                                     \
+    {                                                                       \
+        for (SIZE_T i = 0; i < v->nextFree_; ++i)                           \
+        {                                                                   \
+            T##_dtor(&v->vector_[i]);                                       \
+        }                                                                   \
+        if (!v->isStatic_)                                                  \
+        {                                                                   \
+            Memory_free(v->vector_);                                        \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    VectorT_DEFINE_NEW(T, N, SIZE_T)                                        \
+                                                                            \
+    VectorT_DEFINE_DEL(T, N, SIZE_T)                                        \
+                                                                            \
+    VectorT_DEFINE_ELEMENTS_(T, N, SIZE_T)                                  \
+                                                                            \
+    void N##_setGrowth(N* v, unsigned percent, SIZE_T increment)            \
+    {                                                                       \
+        v->growthPercent_   = percent;                                      \
+        v->growthIncrement_ = increment;                                    \
+    }                                                                       \
+                                                                            \
+    VectorT_GETSTATS_IMPL_(N)                                               \
+                                                                            \
+    VectorT_DEFINE_RESIZE(T, N, SIZE_T)
+
+#define VectorT_DEFINE(T, N, SIZE_T)                                        \
+    VectorT_DEFINE_(T, N, SIZE_T,                                           \
+                    VectorT_DEFINE_CTOR_COPY,                               \
+                    VectorT_DEFINE_RELOCATE)
+
+#define VectorT_DEFINE_TRIVIAL(T, N, SIZE_T)                                \
+    VectorT_DEFINE_(T, N, SIZE_T,                                           \
+                    VectorT_DEFINE_CTOR_COPY_TRIVIAL,                       \
+                    VectorT_DEFINE_RELOCATE_TRIVIAL)
+
+// The capacity of a fixed vector, it is a constant expression.
+#define VectorT_FIXED_CAPACITY_(v__)                                        \
+    (sizeof((v__)->vector_) / sizeof((v__)->vector_[0]))
+
+#define VectorT_DEFINE_FIXED_CTOR_COPY(T, N, SIZE_T)                        \
+    bool N##_ctorCopy(N* v, N const* s)                                     \
+    {                                                                       \
+        N##_ctor(v);                                                        \
+        for (SIZE_T i = 0; i < s->nextFree_; ++i)                           \
+        {                                                                   \
+            if (!T##_ctorCopy(&v->vector_[i], &s->vector_[i]))              \
+            {                                                               \
+                N##_clear(v);                                               \
+                return false;                                               \
+            }                                                               \
+            v->nextFree_++;                                                 \
+        }                                                                   \
+        return true;                                                        \
+    }
+
+#define VectorT_DEFINE_FIXED_CTOR_COPY_TRIVIAL(T, N, SIZE_T)                \
+    bool N##_ctorCopy(N* v, N const* s)                                     \
+    {                                                                       \
+        N##_ctor(v);                                                        \
+        memcpy(v->vector_, s->vector_, s->nextFree_ * sizeof(T));           \
+        v->nextFree_ = s->nextFree_;                                        \
+        return true;                                                        \
+    }
+
+#define VectorT_DEFINE_FIXED_(T, N, SIZE_T, CTOR_COPY__)                    \
+                                                                            \
+    void N##_ctor(N* v)                                                     \
+    {                                                                       \
+        v->nextFree_ = 0;                                                   \
+        VectorT_STATS_INIT_(v);                                             \
+    }                                                                       \
+                                                                            \
+    CTOR_COPY__(T, N, SIZE_T)                                               \
+                                                                            \
+    void N##_dtor(N* v)                                                     \
+    {                                                                       \
+        N##_clear(v);                                                       \
+    }                                                                       \
+                                                                            \
+    bool N##_resizeIfNeeded(N* v)                                           \
+    {                                                                       \
+        Debug_STATIC_ASSERT(VectorT_FIXED_CAPACITY_(v) ==                   \
+                            (size_t) (SIZE_T) VectorT_FIXED_CAPACITY_(v));  \
+        bool retval = (v->nextFree_ < (SIZE_T) VectorT_FIXED_CAPACITY_(v)); \
+        VectorT_STATS_(v->stats_.failedGrowths += !retval);                 \
+        return retval;                                                      \
+    }                                                                       \
+                                                                            \
+    SIZE_T N##_getCapacity(N const* v)                                      \
+    {                                                                       \
+        return (SIZE_T) VectorT_FIXED_CAPACITY_(v);                         \
+    }                                                                       \
+                                                                            \
+    bool N##_isFull(N const* v)                                             \
+    {                                                                       \
+        return v->nextFree_ == (SIZE_T) VectorT_FIXED_CAPACITY_(v);         \
+    }                                                                       \
+                                                                            \
+    VectorT_GETSTATS_IMPL_(N)                                               \
+                                                                            \
+    VectorT_DEFINE_ELEMENTS_(T, N, SIZE_T)
+
+/**
+ * VectorT definition macros of the vectors declared with
+ * VectorT_DECLARE_FIXED(). The capacity is taken from the declaration, the
+ * _TRIVIAL flavour copies the vector with memcpy(), as VectorT_DEFINE_TRIVIAL()
+ * does.
+ */
+#define VectorT_DEFINE_FIXED(T, N, SIZE_T)                                  \
+    VectorT_DEFINE_FIXED_(T, N, SIZE_T, VectorT_DEFINE_FIXED_CTOR_COPY)
+
+#define VectorT_DEFINE_FIXED_TRIVIAL(T, N, SIZE_T)                          \
+    VectorT_DEFINE_FIXED_(T, N, SIZE_T,                                     \
+                          VectorT_DEFINE_FIXED_CTOR_COPY_TRIVIAL)
 
 #if defined(__cplusplus)
 }
@@ -560,15 +1150,33 @@ void VectorT_dtor( VectorT* v );
 VectorT* VectorT_new( void );
 void VectorT_delete( VectorT* v );
 bool VectorT_pushBack( VectorT* v, T item );
+T* VectorT_emplaceBack( VectorT* v );
+void VectorT_cancelEmplace( VectorT* v );
 T VectorT_getFront( VectorT const* v );
 T VectorT_getBack( VectorT const* v );
 void VectorT_popBack( VectorT* v );
 T VectorT_getElementAt( VectorT const* v, int n );
 T const* VectorT_getPtrToElementAt( VectorT const* v, int n );
+T* VectorT_getMutPtrAt( VectorT* v, int n );
 bool VectorT_replaceElementAt( VectorT* v, int n, T newElement );
+void VectorT_removeAtSwap( VectorT* v, int n );
+T const* VectorT_getData( VectorT const* v );
+T* VectorT_getMutData( VectorT* v );
+int VectorT_constApply( VectorT const* v, VectorT_applyFn fn, void* context );
+int VectorT_apply( VectorT* v, VectorT_mutApplyFn fn, void* context );
+int VectorT_constApplyRange( VectorT const* v, int begin, int end,
+                             VectorT_applyFn fn, void* context );
+int VectorT_applyRange( VectorT* v, int begin, int end,
+                        VectorT_mutApplyFn fn, void* context );
 int VectorT_getSize( VectorT const* v );
 bool VectorT_isEmpty( VectorT const* v );
 void VectorT_clear( VectorT* v );
+bool VectorT_reserve( VectorT* v, int n );
+bool VectorT_shrinkToFit( VectorT* v );
+void VectorT_setGrowth( VectorT* v, unsigned percent, int increment );
+VectorT_Stats VectorT_getStats( VectorT const* v );
+int VectorT_getCapacity( VectorT const* v );
+bool VectorT_isFull( VectorT const* v );
 #endif
 
 #endif
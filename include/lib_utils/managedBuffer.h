@@ -10,6 +10,10 @@
 
 #pragma once
 
+#include "lib_debug/Debug.h"
+#include "lib_utils/BitConverter.h"
+
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -202,3 +206,571 @@ int managedBuffer_appendChar(
     managedBuffer->usedLen += 1;
     return 0;
 }
+
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+// One segment of a chain as exported by managedBufferChain_getIovec(), it has
+// the same layout as struct iovec
+typedef struct
+{
+    void*   base;
+    size_t  len;
+} managedBuffer_iovec_t;
+
+// A message assembled from several segments, e.g. dataport pages, without
+// flattening it. The segments are managedBuffer_t in an array provided by the
+// caller. The data is written into the segment 'current', the segments after it
+// are spare space added with managedBufferChain_addSpace(). A reference added
+// with managedBufferChain_appendRef() is a segment of its own which is full, so
+// it is never written to.
+typedef struct
+{
+    managedBuffer_t*    segments;
+    size_t              numSegments;
+    size_t              usedSegments;
+    size_t              current;
+} managedBufferChain_t;
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+void managedBufferChain_init(
+    managedBufferChain_t* chain,
+    managedBuffer_t* segments,
+    size_t numSegments
+)
+{
+    Debug_ASSERT( NULL != segments );
+
+    chain->segments     = segments;
+    chain->numSegments  = numSegments;
+    chain->usedSegments = 0;
+    chain->current      = 0;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+int managedBufferChain_addSpace(
+    managedBufferChain_t* chain,
+    void* buffer,
+    size_t bufferLen
+)
+{
+    if (chain->usedSegments == chain->numSegments)
+    {
+        return -1;
+    }
+
+    managedBuffer_init(&chain->segments[chain->usedSegments], buffer, bufferLen);
+    chain->usedSegments++;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+size_t managedBufferChain_getFreeSpace(
+    managedBufferChain_t* chain
+)
+{
+    size_t freeSpace = 0;
+
+    for (size_t i = chain->current; i < chain->usedSegments; i++)
+    {
+        freeSpace += managedBuffer_getFreeSpace(&chain->segments[i]);
+    }
+
+    return freeSpace;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+size_t managedBufferChain_getUsedLen(
+    managedBufferChain_t* chain
+)
+{
+    size_t usedLen = 0;
+
+    for (size_t i = 0; i < chain->usedSegments; i++)
+    {
+        usedLen += chain->segments[i].usedLen;
+    }
+
+    return usedLen;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+int managedBufferChain_append(
+    managedBufferChain_t* chain,
+    const void* buffer,
+    size_t bufferLen
+)
+{
+    const uint8_t* src = (const uint8_t*) buffer;
+
+    Debug_ASSERT( (NULL != buffer) || (0 == bufferLen) );
+
+    // all or nothing, the data may be spread over several segments
+    if (managedBufferChain_getFreeSpace(chain) < bufferLen)
+    {
+        return -1;
+    }
+
+    while (bufferLen > 0)
+    {
+        managedBuffer_t* segment = &chain->segments[chain->current];
+        size_t len = managedBuffer_getFreeSpace(segment);
+
+        if (len > bufferLen)
+        {
+            len = bufferLen;
+        }
+        memcpy(managedBuffer_getFreeSpacePtr(segment), src, len);
+        segment->usedLen += len;
+        src += len;
+        bufferLen -= len;
+
+        if ( (0 == managedBuffer_getFreeSpace(segment))
+             && (chain->current + 1 < chain->usedSegments) )
+        {
+            chain->current++;
+        }
+    }
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+int managedBufferChain_appendRef(
+    managedBufferChain_t* chain,
+    const void* buffer,
+    size_t bufferLen
+)
+{
+    Debug_ASSERT( NULL != buffer );
+
+    managedBuffer_t* segment = NULL;
+    size_t rest = 0;
+    size_t pos = 0;
+    size_t need;
+
+    if (chain->usedSegments > 0)
+    {
+        // the reference goes right after the data written so far, so the free
+        // part of the current segment is split off and stays available after
+        // the reference
+        segment = &chain->segments[chain->current];
+        rest = managedBuffer_getFreeSpace(segment);
+        pos = chain->current + 1;
+        if (0 == segment->usedLen)
+        {
+            // nothing written yet, the reference goes in front of it
+            pos = chain->current;
+            rest = 0;
+        }
+    }
+    need = (rest > 0) ? 2 : 1;
+
+    if (0 == bufferLen)
+    {
+        return 0;
+    }
+
+    if (chain->numSegments - chain->usedSegments < need)
+    {
+        return -1;
+    }
+
+    memmove(&chain->segments[pos + need], &chain->segments[pos],
+            (chain->usedSegments - pos) * sizeof(managedBuffer_t));
+    chain->usedSegments += need;
+
+    managedBuffer_init(&chain->segments[pos], (void*) buffer, bufferLen);
+    chain->segments[pos].usedLen = bufferLen;
+    if (rest > 0)
+    {
+        managedBuffer_init(&chain->segments[pos + 1],
+                           managedBuffer_getFreeSpacePtr(segment), rest);
+        segment->len = segment->usedLen;
+    }
+
+    // continue writing after the reference, if there is any space left
+    chain->current = (pos + 1 < chain->usedSegments) ? pos + 1 : pos;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+int managedBufferChain_getIovec(
+    managedBufferChain_t* chain,
+    managedBuffer_iovec_t* iov,
+    size_t iovLen
+)
+{
+    // returns the number of entries written to 'iov', the segments without
+    // any data are skipped; or -1 if 'iov' is too small
+    size_t n = 0;
+
+    for (size_t i = 0; i < chain->usedSegments; i++)
+    {
+        if (0 == chain->segments[i].usedLen)
+        {
+            continue;
+        }
+        if (n == iovLen)
+        {
+            return -1;
+        }
+        iov[n].base = chain->segments[i].buffer;
+        iov[n].len  = chain->segments[i].usedLen;
+        n++;
+    }
+
+    return (int) n;
+}
+
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+
+// Cursor to serialize a message into a managedBuffer_t. The space is checked
+// and reserved once by managedBufferWriter_begin(), the put functions then
+// write without any further checks, so the caller has to reserve enough for all
+// the fields, e.g. BitConverter_VARUINT64_MAX_SIZE for a varint.
+typedef struct
+{
+    managedBuffer_t*    managedBuffer;
+    uint8_t*            pos;
+    uint8_t*            end;
+} managedBufferWriter_t;
+
+// Cursor to deserialize a message from the used part of a managedBuffer_t. The
+// length is checked once by managedBufferReader_require(), the get functions
+// then read without any further checks. Only the varints, whose length is not
+// known in advance, are always checked.
+typedef struct
+{
+    const uint8_t*      pos;
+    const uint8_t*      end;
+} managedBufferReader_t;
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+int managedBufferWriter_begin(
+    managedBufferWriter_t* writer,
+    managedBuffer_t* managedBuffer,
+    size_t len
+)
+{
+    writer->managedBuffer = managedBuffer;
+    writer->pos = (uint8_t*) managedBuffer_getFreeSpacePtr(managedBuffer);
+
+    if (managedBuffer_reserveSpace(managedBuffer, len) != 0)
+    {
+        writer->end = writer->pos;
+        return -1;
+    }
+
+    writer->end = writer->pos + len;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+void managedBufferWriter_end(
+    managedBufferWriter_t* writer
+)
+{
+    // give back the reserved space that has not been written
+    writer->managedBuffer->usedLen -= writer->end - writer->pos;
+    writer->end = writer->pos;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putU16BE(
+    managedBufferWriter_t* writer,
+    uint16_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos >= (ptrdiff_t) sizeof(value) );
+
+    BitConverter_putUint16BEInline(value, writer->pos);
+    writer->pos += sizeof(value);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putU16LE(
+    managedBufferWriter_t* writer,
+    uint16_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos >= (ptrdiff_t) sizeof(value) );
+
+    BitConverter_putUint16LEInline(value, writer->pos);
+    writer->pos += sizeof(value);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putU32BE(
+    managedBufferWriter_t* writer,
+    uint32_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos >= (ptrdiff_t) sizeof(value) );
+
+    BitConverter_putUint32BEInline(value, writer->pos);
+    writer->pos += sizeof(value);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putU32LE(
+    managedBufferWriter_t* writer,
+    uint32_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos >= (ptrdiff_t) sizeof(value) );
+
+    BitConverter_putUint32LEInline(value, writer->pos);
+    writer->pos += sizeof(value);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putU64BE(
+    managedBufferWriter_t* writer,
+    uint64_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos >= (ptrdiff_t) sizeof(value) );
+
+    BitConverter_putUint64BEInline(value, writer->pos);
+    writer->pos += sizeof(value);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putU64LE(
+    managedBufferWriter_t* writer,
+    uint64_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos >= (ptrdiff_t) sizeof(value) );
+
+    BitConverter_putUint64LEInline(value, writer->pos);
+    writer->pos += sizeof(value);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putVarint(
+    managedBufferWriter_t* writer,
+    uint64_t value
+)
+{
+    Debug_ASSERT( writer->end - writer->pos
+                  >= (ptrdiff_t) BitConverter_getVarUint64Size(value) );
+
+    writer->pos += BitConverter_putVarUint64(value, writer->pos);
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferWriter_putBytes(
+    managedBufferWriter_t* writer,
+    const void* buffer,
+    size_t bufferLen
+)
+{
+    Debug_ASSERT( (size_t) (writer->end - writer->pos) >= bufferLen );
+
+    memcpy(writer->pos, buffer, bufferLen);
+    writer->pos += bufferLen;
+}
+
+
+//------------------------------------------------------------------------------
+static __attribute__((__unused__))
+void managedBufferReader_init(
+    managedBufferReader_t* reader,
+    const managedBuffer_t* managedBuffer
+)
+{
+    reader->pos = (const uint8_t*) managedBuffer->buffer;
+    reader->end = reader->pos + managedBuffer->usedLen;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+size_t managedBufferReader_getRemaining(
+    const managedBufferReader_t* reader
+)
+{
+    return reader->end - reader->pos;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+int managedBufferReader_require(
+    const managedBufferReader_t* reader,
+    size_t len
+)
+{
+    return (managedBufferReader_getRemaining(reader) < len) ? -1 : 0;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+uint16_t managedBufferReader_getU16BE(
+    managedBufferReader_t* reader
+)
+{
+    Debug_ASSERT( reader->end - reader->pos >= (ptrdiff_t) sizeof(uint16_t) );
+
+    const uint16_t value = BitConverter_getUint16BEInline(reader->pos);
+    reader->pos += sizeof(value);
+
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+uint16_t managedBufferReader_getU16LE(
+    managedBufferReader_t* reader
+)
+{
+    Debug_ASSERT( reader->end - reader->pos >= (ptrdiff_t) sizeof(uint16_t) );
+
+    const uint16_t value = BitConverter_getUint16LEInline(reader->pos);
+    reader->pos += sizeof(value);
+
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+uint32_t managedBufferReader_getU32BE(
+    managedBufferReader_t* reader
+)
+{
+    Debug_ASSERT( reader->end - reader->pos >= (ptrdiff_t) sizeof(uint32_t) );
+
+    const uint32_t value = BitConverter_getUint32BEInline(reader->pos);
+    reader->pos += sizeof(value);
+
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+uint32_t managedBufferReader_getU32LE(
+    managedBufferReader_t* reader
+)
+{
+    Debug_ASSERT( reader->end - reader->pos >= (ptrdiff_t) sizeof(uint32_t) );
+
+    const uint32_t value = BitConverter_getUint32LEInline(reader->pos);
+    reader->pos += sizeof(value);
+
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+uint64_t managedBufferReader_getU64BE(
+    managedBufferReader_t* reader
+)
+{
+    Debug_ASSERT( reader->end - reader->pos >= (ptrdiff_t) sizeof(uint64_t) );
+
+    const uint64_t value = BitConverter_getUint64BEInline(reader->pos);
+    reader->pos += sizeof(value);
+
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+uint64_t managedBufferReader_getU64LE(
+    managedBufferReader_t* reader
+)
+{
+    Debug_ASSERT( reader->end - reader->pos >= (ptrdiff_t) sizeof(uint64_t) );
+
+    const uint64_t value = BitConverter_getUint64LEInline(reader->pos);
+    reader->pos += sizeof(value);
+
+    return value;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+int managedBufferReader_getVarint(
+    managedBufferReader_t* reader,
+    uint64_t* value
+)
+{
+    const size_t len = BitConverter_getVarUint64(
+                           reader->pos,
+                           managedBufferReader_getRemaining(reader),
+                           value);
+    if (0 == len)
+    {
+        return -1;
+    }
+
+    reader->pos += len;
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+static inline __attribute__((__unused__))
+void managedBufferReader_getBytes(
+    managedBufferReader_t* reader,
+    void* buffer,
+    size_t bufferLen
+)
+{
+    Debug_ASSERT( managedBufferReader_getRemaining(reader) >= bufferLen );
+
+    memcpy(buffer, reader->pos, bufferLen);
+    reader->pos += bufferLen;
+}
@@ -14,173 +14,383 @@
  */
 
 /* Includes ------------------------------------------------------------------*/
+// The exported functions are defined here, so they must not be mapped
+#define BitConverter_Config_NO_INLINE
 #include "lib_utils/BitConverter.h"
 
+#include <string.h>
+
 /* Private define ------------------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
+static void
+copySwapped64(void* dst, const void* src, size_t n);
+static void
+copySwapped32(void* dst, const void* src, size_t n);
+static void
+copySwapped16(void* dst, const void* src, size_t n);
+
 /* Public functions ----------------------------------------------------------*/
 
 void
 BitConverter_putUint64BE(uint64_t arg, void* mem)
 {
-    char* bytes = (char*) mem;
-
-    bytes[0] = (arg & 0xff00000000000000) >> 56;
-    bytes[1] = (arg & 0x00ff000000000000) >> 48;
-    bytes[2] = (arg & 0x0000ff0000000000) >> 40;
-    bytes[3] = (arg & 0x000000ff00000000) >> 32;
-    bytes[4] = (arg & 0x00000000ff000000) >> 24;
-    bytes[5] = (arg & 0x0000000000ff0000) >> 16;
-    bytes[6] = (arg & 0x000000000000ff00) >> 8;
-    bytes[7] = (arg & 0x00000000000000ff);
+    BitConverter_putUint64BEInline(arg, mem);
 }
 
 void
 BitConverter_putUint64LE(uint64_t arg, void* mem)
 {
-    char* bytes = (char*) mem;
-
-    bytes[7] = (arg & 0xff00000000000000) >> 56;
-    bytes[6] = (arg & 0x00ff000000000000) >> 48;
-    bytes[5] = (arg & 0x0000ff0000000000) >> 40;
-    bytes[4] = (arg & 0x000000ff00000000) >> 32;
-    bytes[3] = (arg & 0x00000000ff000000) >> 24;
-    bytes[2] = (arg & 0x0000000000ff0000) >> 16;
-    bytes[1] = (arg & 0x000000000000ff00) >> 8;
-    bytes[0] = (arg & 0x00000000000000ff);
+    BitConverter_putUint64LEInline(arg, mem);
 }
 
 void
 BitConverter_putUint32BE(uint32_t arg, void* mem)
 {
-    char* bytes = (char*) mem;
-
-    bytes[0] = (arg & 0xff000000) >> 24;
-    bytes[1] = (arg & 0x00ff0000) >> 16;
-    bytes[2] = (arg & 0x0000ff00) >> 8;
-    bytes[3] = (arg & 0x000000ff);
+    BitConverter_putUint32BEInline(arg, mem);
 }
 
 void
 BitConverter_putUint32LE(uint32_t arg, void* mem)
 {
-    char* bytes = (char*) mem;
-
-    bytes[3] = (arg & 0xff000000) >> 24;
-    bytes[2] = (arg & 0x00ff0000) >> 16;
-    bytes[1] = (arg & 0x0000ff00) >> 8;
-    bytes[0] = (arg & 0x000000ff);
+    BitConverter_putUint32LEInline(arg, mem);
 }
 
 void
 BitConverter_putUint16BE(uint16_t arg, void* mem)
 {
-    char* bytes = (char*) mem;
-
-    bytes[0] = (arg & 0xff00) >> 8;
-    bytes[1] = (arg & 0x00ff);
+    BitConverter_putUint16BEInline(arg, mem);
 }
 
 void
 BitConverter_putUint16LE(uint16_t arg, void* mem)
 {
-    char* bytes = (char*) mem;
-
-    bytes[1] = (arg & 0xff00) >> 8;
-    bytes[0] = (arg & 0x00ff);
+    BitConverter_putUint16LEInline(arg, mem);
 }
 
 uint64_t
 BitConverter_getUint64BE(const void* mem)
 {
-    char* bytes = (char*) mem;
-    uint64_t retval = 0;
-
-    retval |= ((uint64_t) bytes[0]) << 56;
-    retval |= ((uint64_t) bytes[1]) << 48;
-    retval |= ((uint64_t) bytes[2]) << 40;
-    retval |= ((uint64_t) bytes[3]) << 32;
-    retval |= ((uint64_t) bytes[4]) << 24;
-    retval |= ((uint64_t) bytes[5]) << 16;
-    retval |= ((uint64_t) bytes[6]) << 8;
-    retval |= ((uint64_t) bytes[7]);
-
-    return retval;
+    return BitConverter_getUint64BEInline(mem);
 }
 
 uint64_t
 BitConverter_getUint64LE(const void* mem)
 {
-    char* bytes = (char*) mem;
-    uint64_t retval = 0;
-
-    retval |= ((uint64_t) bytes[7]) << 56;
-    retval |= ((uint64_t) bytes[6]) << 48;
-    retval |= ((uint64_t) bytes[5]) << 40;
-    retval |= ((uint64_t) bytes[4]) << 32;
-    retval |= ((uint64_t) bytes[3]) << 24;
-    retval |= ((uint64_t) bytes[2]) << 16;
-    retval |= ((uint64_t) bytes[1]) << 8;
-    retval |= ((uint64_t) bytes[0]);
-
-    return retval;
+    return BitConverter_getUint64LEInline(mem);
 }
 
 uint32_t
 BitConverter_getUint32BE(const void* mem)
 {
-    char* bytes = (char*) mem;
-    uint32_t retval = 0;
-
-    retval |= ((uint32_t) bytes[0]) << 24;
-    retval |= ((uint32_t) bytes[1]) << 16;
-    retval |= ((uint32_t) bytes[2]) << 8;
-    retval |= ((uint32_t) bytes[3]);
-
-    return retval;
+    return BitConverter_getUint32BEInline(mem);
 }
 
 uint32_t
 BitConverter_getUint32LE(const void* mem)
 {
-    char* bytes = (char*) mem;
-    uint32_t retval = 0;
-
-    retval |= ((uint32_t) bytes[3]) << 24;
-    retval |= ((uint32_t) bytes[2]) << 16;
-    retval |= ((uint32_t) bytes[1]) << 8;
-    retval |= ((uint32_t) bytes[0]);
-
-    return retval;
+    return BitConverter_getUint32LEInline(mem);
 }
 
 uint16_t
 BitConverter_getUint16BE(const void* mem)
 {
-    char* bytes = (char*) mem;
-    uint16_t retval = 0;
-
-    retval |= ((uint16_t) bytes[0]) << 8;
-    retval |= ((uint16_t) bytes[1]);
-
-    return retval;
+    return BitConverter_getUint16BEInline(mem);
 }
 
 uint16_t
 BitConverter_getUint16LE(const void* mem)
 {
-    char* bytes = (char*) mem;
-    uint16_t retval = 0;
+    return BitConverter_getUint16LEInline(mem);
+}
 
-    retval |= ((uint16_t) bytes[1]) << 8;
-    retval |= ((uint16_t) bytes[0]);
+void
+BitConverter_putUint64ArrayBE(const uint64_t* src, void* dst, size_t n)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint64_t));
+    }
+    else
+    {
+        copySwapped64(dst, src, n);
+    }
+}
 
-    return retval;
+void
+BitConverter_putUint64ArrayLE(const uint64_t* src, void* dst, size_t n)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint64_t));
+    }
+    else
+    {
+        copySwapped64(dst, src, n);
+    }
+}
+
+void
+BitConverter_getUint64ArrayBE(const void* src, uint64_t* dst, size_t n)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint64_t));
+    }
+    else
+    {
+        copySwapped64(dst, src, n);
+    }
+}
+
+void
+BitConverter_getUint64ArrayLE(const void* src, uint64_t* dst, size_t n)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint64_t));
+    }
+    else
+    {
+        copySwapped64(dst, src, n);
+    }
+}
+
+void
+BitConverter_putUint32ArrayBE(const uint32_t* src, void* dst, size_t n)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint32_t));
+    }
+    else
+    {
+        copySwapped32(dst, src, n);
+    }
+}
+
+void
+BitConverter_putUint32ArrayLE(const uint32_t* src, void* dst, size_t n)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint32_t));
+    }
+    else
+    {
+        copySwapped32(dst, src, n);
+    }
+}
+
+void
+BitConverter_getUint32ArrayBE(const void* src, uint32_t* dst, size_t n)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint32_t));
+    }
+    else
+    {
+        copySwapped32(dst, src, n);
+    }
+}
+
+void
+BitConverter_getUint32ArrayLE(const void* src, uint32_t* dst, size_t n)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint32_t));
+    }
+    else
+    {
+        copySwapped32(dst, src, n);
+    }
+}
+
+void
+BitConverter_putUint16ArrayBE(const uint16_t* src, void* dst, size_t n)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint16_t));
+    }
+    else
+    {
+        copySwapped16(dst, src, n);
+    }
+}
+
+void
+BitConverter_putUint16ArrayLE(const uint16_t* src, void* dst, size_t n)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint16_t));
+    }
+    else
+    {
+        copySwapped16(dst, src, n);
+    }
+}
+
+void
+BitConverter_getUint16ArrayBE(const void* src, uint16_t* dst, size_t n)
+{
+    if (BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint16_t));
+    }
+    else
+    {
+        copySwapped16(dst, src, n);
+    }
+}
+
+void
+BitConverter_getUint16ArrayLE(const void* src, uint16_t* dst, size_t n)
+{
+    if (!BitConverter_IS_BIG_ENDIAN())
+    {
+        memmove(dst, src, n * sizeof(uint16_t));
+    }
+    else
+    {
+        copySwapped16(dst, src, n);
+    }
+}
+
+size_t
+BitConverter_putVarUint64Array(const uint64_t* src, size_t n, void* mem)
+{
+    uint8_t* bytes = (uint8_t*) mem;
+    size_t pos = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        pos += BitConverter_putVarUint64(src[i], bytes + pos);
+    }
+
+    return pos;
+}
+
+size_t
+BitConverter_getVarUint64Array(
+    const void* mem,
+    size_t len,
+    uint64_t* dst,
+    size_t n)
+{
+    const uint8_t* bytes = (const uint8_t*) mem;
+    size_t pos = 0, used;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        used = BitConverter_getVarUint64(bytes + pos, len - pos, &dst[i]);
+        if (used == 0)
+        {
+            return 0;
+        }
+        pos += used;
+    }
+
+    return pos;
+}
+
+size_t
+BitConverter_putVarUint32Array(const uint32_t* src, size_t n, void* mem)
+{
+    uint8_t* bytes = (uint8_t*) mem;
+    size_t pos = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        pos += BitConverter_putVarUint32(src[i], bytes + pos);
+    }
+
+    return pos;
+}
+
+size_t
+BitConverter_getVarUint32Array(
+    const void* mem,
+    size_t len,
+    uint32_t* dst,
+    size_t n)
+{
+    const uint8_t* bytes = (const uint8_t*) mem;
+    size_t pos = 0, used;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        used = BitConverter_getVarUint32(bytes + pos, len - pos, &dst[i]);
+        if (used == 0)
+        {
+            return 0;
+        }
+        pos += used;
+    }
+
+    return pos;
 }
 
 /* Private Functions -------------------------------------------------------- */
+static void
+copySwapped64(void* dst, const void* src, size_t n)
+{
+    /*
+     * Load, swap and store every element through memcpy(), so neither buffer
+     * has to be aligned. This is a plain loop the compiler can vectorize into
+     * byte shuffles, and it also works if both buffers are the same.
+     */
+    uint8_t* d = (uint8_t*) dst;
+    const uint8_t* s = (const uint8_t*) src;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint64_t v;
+
+        memcpy(&v, s + i * sizeof(v), sizeof(v));
+        v = __builtin_bswap64(v);
+        memcpy(d + i * sizeof(v), &v, sizeof(v));
+    }
+}
+
+static void
+copySwapped32(void* dst, const void* src, size_t n)
+{
+    // Same as copySwapped64()
+    uint8_t* d = (uint8_t*) dst;
+    const uint8_t* s = (const uint8_t*) src;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint32_t v;
+
+        memcpy(&v, s + i * sizeof(v), sizeof(v));
+        v = __builtin_bswap32(v);
+        memcpy(d + i * sizeof(v), &v, sizeof(v));
+    }
+}
+
+static void
+copySwapped16(void* dst, const void* src, size_t n)
+{
+    // Same as copySwapped64()
+    uint8_t* d = (uint8_t*) dst;
+    const uint8_t* s = (const uint8_t*) src;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint16_t v;
+
+        memcpy(&v, s + i * sizeof(v), sizeof(v));
+        v = __builtin_bswap16(v);
+        memcpy(d + i * sizeof(v), &v, sizeof(v));
+    }
+}
+
 ///@}
 
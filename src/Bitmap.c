@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @addtogroup lib_utils
+ * @{
+ *
+ * @file Bitmap.c
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lib_utils/Bitmap.h"
+#include "lib_debug/Debug.h"
+
+#include <string.h>
+
+/* Private define ------------------------------------------------------------*/
+#define ALL_BITS    (~(uint64_t) 0)
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static size_t
+findFirst(BitmapN const* self, size_t from, uint64_t invert);
+static void
+applyRange(BitmapN* self, size_t first, size_t count, bool set);
+
+/* Public functions ----------------------------------------------------------*/
+
+bool
+BitmapN_ctor(BitmapN* self, uint64_t* words, size_t numBits)
+{
+    Debug_ASSERT_SELF(self);
+
+    if (NULL == words || 0 == numBits)
+    {
+        return false;
+    }
+    self->words     = words;
+    self->numBits   = numBits;
+    // The bits after the last one stay cleared, the searches rely on it
+    memset(words, 0, BitmapN_WORDS(numBits) * sizeof(uint64_t));
+
+    return true;
+}
+
+void
+BitmapN_dtor(BitmapN* self)
+{
+    Debug_ASSERT_SELF(self);
+
+    self->words     = NULL;
+    self->numBits   = 0;
+}
+
+size_t
+BitmapN_findFirstSet(BitmapN const* self, size_t from)
+{
+    Debug_ASSERT_SELF(self);
+
+    return findFirst(self, from, 0);
+}
+
+size_t
+BitmapN_findFirstClear(BitmapN const* self, size_t from)
+{
+    Debug_ASSERT_SELF(self);
+
+    return findFirst(self, from, ALL_BITS);
+}
+
+size_t
+BitmapN_countSet(BitmapN const* self)
+{
+    Debug_ASSERT_SELF(self);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < BitmapN_WORDS(self->numBits); i++)
+    {
+        count += __builtin_popcountll(self->words[i]);
+    }
+
+    return count;
+}
+
+void
+BitmapN_setRange(BitmapN* self, size_t first, size_t count)
+{
+    Debug_ASSERT_SELF(self);
+
+    applyRange(self, first, count, true);
+}
+
+void
+BitmapN_clearRange(BitmapN* self, size_t first, size_t count)
+{
+    Debug_ASSERT_SELF(self);
+
+    applyRange(self, first, count, false);
+}
+
+bool
+BitmapN_testAndSet(BitmapN* self, size_t bit)
+{
+    Debug_ASSERT_SELF(self);
+    Debug_ASSERT(bit < self->numBits);
+
+    const uint64_t mask = Bitmap_MASK_OF_BIT(bit % BitmapN_BITS_PER_WORD);
+
+    return (__atomic_fetch_or(&self->words[bit / BitmapN_BITS_PER_WORD], mask,
+                              __ATOMIC_ACQ_REL) & mask) != 0;
+}
+
+bool
+BitmapN_testAndClear(BitmapN* self, size_t bit)
+{
+    Debug_ASSERT_SELF(self);
+    Debug_ASSERT(bit < self->numBits);
+
+    const uint64_t mask = Bitmap_MASK_OF_BIT(bit % BitmapN_BITS_PER_WORD);
+
+    return (__atomic_fetch_and(&self->words[bit / BitmapN_BITS_PER_WORD],
+                               ~mask, __ATOMIC_ACQ_REL) & mask) != 0;
+}
+
+size_t
+BitmapN_claimFirstClear(BitmapN* self, size_t from)
+{
+    Debug_ASSERT_SELF(self);
+
+    const size_t numWords = BitmapN_WORDS(self->numBits);
+    const size_t tail = self->numBits % BitmapN_BITS_PER_WORD;
+    uint64_t word, valid, clear;
+
+    if (from >= self->numBits)
+    {
+        return BitmapN_NOT_FOUND;
+    }
+    for (size_t i = from / BitmapN_BITS_PER_WORD; i < numWords; i++)
+    {
+        // Only the bits from 'from' on, and not after the last bit, count
+        valid = (i == from / BitmapN_BITS_PER_WORD) ?
+                ALL_BITS << (from % BitmapN_BITS_PER_WORD) : ALL_BITS;
+        if (i == numWords - 1 && tail != 0)
+        {
+            valid &= Bitmap_MASK_OF_BIT(tail) - 1;
+        }
+        word = __atomic_load_n(&self->words[i], __ATOMIC_RELAXED);
+        while ((clear = ~word & valid) != 0)
+        {
+            // On failure the CAS updates 'word', so the search just goes on
+            const uint64_t mask = clear & (0 - clear);
+
+            if (__atomic_compare_exchange_n(&self->words[i], &word,
+                                            word | mask, true,
+                                            __ATOMIC_ACQ_REL,
+                                            __ATOMIC_RELAXED))
+            {
+                return i * BitmapN_BITS_PER_WORD + __builtin_ctzll(mask);
+            }
+        }
+    }
+
+    return BitmapN_NOT_FOUND;
+}
+
+/* Private Functions -------------------------------------------------------- */
+
+static size_t
+findFirst(BitmapN const* self, size_t from, uint64_t invert)
+{
+    /*
+     * Search for a set bit in the words xor'ed with 'invert', so the same loop
+     * finds the first clear bit. The bits before 'from' are masked out of the
+     * first word, then every word is tested at once.
+     */
+    const size_t numWords = BitmapN_WORDS(self->numBits);
+    size_t i = from / BitmapN_BITS_PER_WORD, bit;
+    uint64_t word;
+
+    if (from >= self->numBits)
+    {
+        return BitmapN_NOT_FOUND;
+    }
+    word = (self->words[i] ^ invert)
+           & (ALL_BITS << (from % BitmapN_BITS_PER_WORD));
+    while (0 == word)
+    {
+        if (++i == numWords)
+        {
+            return BitmapN_NOT_FOUND;
+        }
+        word = self->words[i] ^ invert;
+    }
+    bit = i * BitmapN_BITS_PER_WORD + __builtin_ctzll(word);
+
+    // The inverted bits after the last one are set, they do not count
+    return (bit < self->numBits) ? bit : BitmapN_NOT_FOUND;
+}
+
+static void
+applyRange(BitmapN* self, size_t first, size_t count, bool set)
+{
+    /*
+     * Apply a mask per word, it covers the whole word except for the first
+     * and the last word of the range
+     */
+    const size_t end = first + count;
+    size_t i = first / BitmapN_BITS_PER_WORD, n, shift;
+    uint64_t mask;
+
+    Debug_ASSERT(count <= self->numBits && first <= self->numBits - count);
+
+    while (first < end)
+    {
+        shift = first % BitmapN_BITS_PER_WORD;
+        n     = BitmapN_BITS_PER_WORD - shift;
+        n     = (n < end - first) ? n : end - first;
+        mask  = (n == BitmapN_BITS_PER_WORD) ?
+                ALL_BITS : ((Bitmap_MASK_OF_BIT(n) - 1) << shift);
+        if (set)
+        {
+            self->words[i] |= mask;
+        }
+        else
+        {
+            self->words[i] &= ~mask;
+        }
+        first += n;
+        i++;
+    }
+}
+
+///@}
@@ -53,31 +53,43 @@ char_ctorCopy(char* target, char const* source )
 
 /* Public functions ----------------------------------------------------------*/
 
-FifoT_DEFINE(char, CharFifo, size_t)
+FifoT_DEFINE_TRIVIAL(char, CharFifo, size_t)
+
+FifoT_SPSC_DEFINE_TRIVIAL(char, CharSpscFifo, size_t)
+
+FifoT_MPSC_DEFINE_TRIVIAL(char, CharMpscFifo, size_t)
 
 bool
 CharFifo_forcedPush(CharFifo* self, char const* c)
 {
-    bool retval = false;
+    return CharFifo_pushOverwrite(self, c);
+}
+
+char
+CharFifo_getAndPop(CharFifo* self)
+{
+    char c = * CharFifo_getFirst(self);
+    DECL_UNUSED_VAR(const bool ok) = CharFifo_pop(self);
+    Debug_ASSERT(ok);
 
-    if (CharFifo_isFull(self))
-    {
-        CharFifo_pop(self);
-        retval = true;
-    }
-    else { /* do nothing */ }
+    return c;
+}
 
-    DECL_UNUSED_VAR(const bool ok) = CharFifo_push(self, c);
+char
+CharSpscFifo_getAndPop(CharSpscFifo* self)
+{
+    char c = * CharSpscFifo_getFirst(self);
+    DECL_UNUSED_VAR(const bool ok) = CharSpscFifo_pop(self);
     Debug_ASSERT(ok);
 
-    return retval;
+    return c;
 }
 
 char
-CharFifo_getAndPop(CharFifo* self)
+CharMpscFifo_getAndPop(CharMpscFifo* self)
 {
-    char c = * CharFifo_getFirst(self);
-    DECL_UNUSED_VAR(const bool ok) = CharFifo_pop(self);
+    char c = * CharMpscFifo_getFirst(self);
+    DECL_UNUSED_VAR(const bool ok) = CharMpscFifo_pop(self);
     Debug_ASSERT(ok);
 
     return c;
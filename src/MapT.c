@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @addtogroup lib_utils
+ * @{
+ *
+ * @file MapT.c
+ *
+ * The integer key scan of MapT_DEFINE_SOA_INTKEY(), see MapT_scanKeys32().
+ */
+
+/* Includes ------------------------------------------------------------------*/
+#include "lib_utils/MapT.h"
+
+#if defined(MapT_SCAN_X86_)
+#   include <immintrin.h>
+#elif defined(MapT_SCAN_NEON_)
+#   include <arm_neon.h>
+#endif
+
+/* Private define ------------------------------------------------------------*/
+#define TARGET_SSE2     __attribute__((target("sse2")))
+#define TARGET_AVX2     __attribute__((target("avx2")))
+#define TARGET_AVX512   __attribute__((target("avx512f")))
+
+/* Private macro -------------------------------------------------------------*/
+/*
+ * Compares blocks of 'lanes' keys with 'match', which returns 'bits' bits per
+ * key, the keys after the last full block are compared one by one.
+ */
+#define SCAN(keys, size, needle, lanes, bits, match)                        \
+    do                                                                      \
+    {                                                                       \
+        int i = 0;                                                          \
+        for (; i + (lanes) <= (size); i += (lanes))                         \
+        {                                                                   \
+            uint64_t mask = match(&(keys)[i], needle);                      \
+            if (mask != 0)                                                  \
+            {                                                               \
+                return i + __builtin_ctzll(mask) / (bits);                  \
+            }                                                               \
+        }                                                                   \
+        for (; i < (size); ++i)                                             \
+        {                                                                   \
+            if ((keys)[i] == (needle))                                      \
+            {                                                               \
+                return i;                                                   \
+            }                                                               \
+        }                                                                   \
+        return -1;                                                          \
+    } while (0)
+
+/* Private functions ---------------------------------------------------------*/
+#if defined(MapT_SCAN_X86_)
+
+static inline TARGET_SSE2 uint64_t
+match32Sse2(MapT_Key32 const* keys, uint32_t needle)
+{
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const*) keys),
+                                 _mm_set1_epi32((int) needle));
+    return (uint64_t) _mm_movemask_ps(_mm_castsi128_ps(eq));
+}
+
+static inline TARGET_SSE2 uint64_t
+match64Sse2(MapT_Key64 const* keys, uint64_t needle)
+{
+    // SSE2 has no 64-bit compare, both halves of a key have to match
+    __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((__m128i const*) keys),
+                                 _mm_set1_epi64x((long long) needle));
+    eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (uint64_t) _mm_movemask_pd(_mm_castsi128_pd(eq));
+}
+
+static inline TARGET_AVX2 uint64_t
+match32Avx2(MapT_Key32 const* keys, uint32_t needle)
+{
+    __m256i eq = _mm256_cmpeq_epi32(
+                    _mm256_loadu_si256((__m256i const*) keys),
+                    _mm256_set1_epi32((int) needle));
+    return (uint64_t) _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+}
+
+static inline TARGET_AVX2 uint64_t
+match64Avx2(MapT_Key64 const* keys, uint64_t needle)
+{
+    __m256i eq = _mm256_cmpeq_epi64(
+                    _mm256_loadu_si256((__m256i const*) keys),
+                    _mm256_set1_epi64x((long long) needle));
+    return (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+}
+
+static inline TARGET_AVX512 uint64_t
+match32Avx512(MapT_Key32 const* keys, uint32_t needle)
+{
+    return (uint64_t) _mm512_cmpeq_epi32_mask(
+                        _mm512_loadu_si512((void const*) keys),
+                        _mm512_set1_epi32((int) needle));
+}
+
+static inline TARGET_AVX512 uint64_t
+match64Avx512(MapT_Key64 const* keys, uint64_t needle)
+{
+    return (uint64_t) _mm512_cmpeq_epi64_mask(
+                        _mm512_loadu_si512((void const*) keys),
+                        _mm512_set1_epi64((long long) needle));
+}
+
+#elif defined(MapT_SCAN_NEON_)
+
+/*
+ * NEON has no movemask, narrowing every lane to half its width gives a mask
+ * of 16 bits per 32-bit key and of 32 bits per 64-bit key.
+ */
+static inline uint64_t
+match32Neon(MapT_Key32 const* keys, uint32_t needle)
+{
+    uint32x4_t eq = vceqq_u32(vld1q_u32((uint32_t const*) keys),
+                              vdupq_n_u32(needle));
+    return vget_lane_u64(vreinterpret_u64_u16(vshrn_n_u32(eq, 16)), 0);
+}
+
+static inline uint64_t
+match64Neon(MapT_Key64 const* keys, uint64_t needle)
+{
+#if defined(__aarch64__)
+    uint64x2_t eq = vceqq_u64(vld1q_u64((uint64_t const*) keys),
+                              vdupq_n_u64(needle));
+#else
+    // ARMv7 has no 64-bit compare, both halves of a key have to match
+    uint32x4_t eq32 = vceqq_u32(vld1q_u32((uint32_t const*) keys),
+                                vreinterpretq_u32_u64(vdupq_n_u64(needle)));
+    uint64x2_t eq = vreinterpretq_u64_u32(vandq_u32(eq32, vrev64q_u32(eq32)));
+#endif
+    return vget_lane_u64(vreinterpret_u64_u32(vshrn_n_u64(eq, 32)), 0);
+}
+
+#endif /* MapT_SCAN_NEON_ */
+
+/* Public functions ----------------------------------------------------------*/
+
+int
+MapT_scanKeys32Scalar(MapT_Key32 const* keys, int size, uint32_t needle)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        if (keys[i] == needle)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int
+MapT_scanKeys64Scalar(MapT_Key64 const* keys, int size, uint64_t needle)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        if (keys[i] == needle)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#if defined(MapT_SCAN_X86_)
+
+TARGET_SSE2 int
+MapT_scanKeys32Sse2(MapT_Key32 const* keys, int size, uint32_t needle)
+{
+    SCAN(keys, size, needle, 4, 1, match32Sse2);
+}
+
+TARGET_SSE2 int
+MapT_scanKeys64Sse2(MapT_Key64 const* keys, int size, uint64_t needle)
+{
+    SCAN(keys, size, needle, 2, 1, match64Sse2);
+}
+
+TARGET_AVX2 int
+MapT_scanKeys32Avx2(MapT_Key32 const* keys, int size, uint32_t needle)
+{
+    SCAN(keys, size, needle, 8, 1, match32Avx2);
+}
+
+TARGET_AVX2 int
+MapT_scanKeys64Avx2(MapT_Key64 const* keys, int size, uint64_t needle)
+{
+    SCAN(keys, size, needle, 4, 1, match64Avx2);
+}
+
+TARGET_AVX512 int
+MapT_scanKeys32Avx512(MapT_Key32 const* keys, int size, uint32_t needle)
+{
+    SCAN(keys, size, needle, 16, 1, match32Avx512);
+}
+
+TARGET_AVX512 int
+MapT_scanKeys64Avx512(MapT_Key64 const* keys, int size, uint64_t needle)
+{
+    SCAN(keys, size, needle, 8, 1, match64Avx512);
+}
+
+#elif defined(MapT_SCAN_NEON_)
+
+int
+MapT_scanKeys32Neon(MapT_Key32 const* keys, int size, uint32_t needle)
+{
+    SCAN(keys, size, needle, 4, 16, match32Neon);
+}
+
+int
+MapT_scanKeys64Neon(MapT_Key64 const* keys, int size, uint64_t needle)
+{
+    SCAN(keys, size, needle, 2, 32, match64Neon);
+}
+
+#endif /* MapT_SCAN_X86_, MapT_SCAN_NEON_ */
+
+int
+MapT_scanKeys32(MapT_Key32 const* keys, int size, uint32_t needle)
+{
+#if defined(MapT_SCAN_X86_) && defined(__AVX512F__)
+    return MapT_scanKeys32Avx512(keys, size, needle);
+#elif defined(MapT_SCAN_X86_) && defined(__AVX2__)
+    return MapT_scanKeys32Avx2(keys, size, needle);
+#elif defined(MapT_SCAN_X86_) && defined(__SSE2__)
+    return MapT_scanKeys32Sse2(keys, size, needle);
+#elif defined(MapT_SCAN_NEON_)
+    return MapT_scanKeys32Neon(keys, size, needle);
+#else
+    return MapT_scanKeys32Scalar(keys, size, needle);
+#endif
+}
+
+int
+MapT_scanKeys64(MapT_Key64 const* keys, int size, uint64_t needle)
+{
+#if defined(MapT_SCAN_X86_) && defined(__AVX512F__)
+    return MapT_scanKeys64Avx512(keys, size, needle);
+#elif defined(MapT_SCAN_X86_) && defined(__AVX2__)
+    return MapT_scanKeys64Avx2(keys, size, needle);
+#elif defined(MapT_SCAN_X86_) && defined(__SSE2__)
+    return MapT_scanKeys64Sse2(keys, size, needle);
+#elif defined(MapT_SCAN_NEON_)
+    return MapT_scanKeys64Neon(keys, size, needle);
+#else
+    return MapT_scanKeys64Scalar(keys, size, needle);
+#endif
+}
+
+///@}
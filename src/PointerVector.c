@@ -8,7 +8,7 @@
 
 #include "lib_utils/PointerVector.h"
 
-VectorT_DEFINE(Pointer, PointerVector, size_t);
+VectorT_DEFINE_TRIVIAL(Pointer, PointerVector, size_t);
 
 void
 Pointer_dtor(Pointer* el)
@@ -40,3 +40,16 @@ Pointer_isEqual(Pointer const* a, Pointer const* b)
 {
     return (*a == *b);
 }
+
+uint32_t
+Pointer_hash(Pointer const* key)
+{
+    uint64_t k = (uint64_t) (uintptr_t) *key;
+    return (uint32_t) (k ^ (k >> 32));
+}
+
+int
+Pointer_compare(Pointer const* a, Pointer const* b)
+{
+    return (*a > *b) - (*a < *b);
+}
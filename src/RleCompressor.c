@@ -29,6 +29,21 @@
 // Length of header we always have, i.e., "RLE" and four length bytes indicating
 // decompressed length
 #define HEADER_LENGTH (sizeof(uint32_t) + 3)
+// Magic bytes at the start of the header, one per version of the format
+#define MAGIC_LENGTH 3
+#define MAGIC_V1 "RLE"
+#define MAGIC_V2 "RL2"
+#define MAGIC_BLOCKS "RLB"
+// Length of the header of the block framed format, i.e., "RLB", the
+// decompressed length and the block size; the block offsets follow
+#define BLOCKS_HEADER_LENGTH (HEADER_LENGTH + sizeof(uint32_t))
+// In the v2 format the lowest bit of the length field tells whether raw bytes
+// ("literal run") or a symbol follow, so a token covers at most 2^29-1 bytes
+#define V2_MAX_COUNT ((1ul << 29) - 1)
+// Runs shorter than this are kept in a literal run by the v2 encoder. A run
+// token for 8 bytes takes 2 bytes and the literal run after it needs its own
+// length field of at most 4 bytes, so every run token saves space
+#define V2_MIN_RUN 8
 
 // Private functions -----------------------------------------------------------
 
@@ -58,28 +73,9 @@ serializeLen(
      * used in the encoding.
      */
 
-    switch (sz)
-    {
-    case 1:
-        *(p++) = 0b00000000 |  (len & 0x3F);
-        break;
-    case 2:
-        *(p++) = 0b01000000 | ((len >>  8) & 0x3F);
-        *(p++) =               (len >>  0) & 0xFF;
-        break;
-    case 3:
-        *(p++) = 0b10000000 | ((len >> 16) & 0x3F);
-        *(p++) =               (len >>  8) & 0xFF;
-        *(p++) =               (len >>  0) & 0xFF;
-        break;
-    default:
-        *(p++) = 0b11000000 | ((len >> 24) & 0x3F);
-        *(p++) =               (len >> 16) & 0xFF;
-        *(p++) =               (len >>  8) & 0xFF;
-        *(p++) =               (len >>  0) & 0xFF;
-    }
+    BitConverter_putUintNBE(((uint64_t) (sz - 1) << (8 * sz - 2)) | len, sz, p);
 
-    return p;
+    return p + sz;
 }
 
 static uint8_t*
@@ -92,29 +88,51 @@ deserializeLen(
      * field to figure out how many bytes were used to encode the length
      */
 
-    switch ((*p) >> 6)
+    const size_t sz = ((*p) >> 6) + 1;
+
+    *len = BitConverter_getUintNBE(p, sz) & ((1ul << (8 * sz - 2)) - 1);
+
+    return ((uint8_t*)p + sz);
+}
+
+static size_t
+getRunLength(
+    const uint8_t* p,
+    const uint8_t* end,
+    const uint8_t  sym)
+{
+    /*
+     * Count how often the symbol is found in sequence. Instead of comparing
+     * byte by byte, we compare 8 bytes at a time against the symbol copied to
+     * all bytes of a word; the first non-zero byte of the XOR of both is where
+     * the run ends. Only the tail which does not fill a word is compared byte
+     * by byte.
+     */
+
+    const uint8_t* start = p;
+    const uint64_t pattern = 0x0101010101010101ull * sym;
+    uint64_t word, diff;
+
+    while ((size_t) (end - p) >= sizeof(word))
+    {
+        // Use memcpy() for the load, as p may not be aligned
+        memcpy(&word, p, sizeof(word));
+        if ((diff = word ^ pattern) != 0)
+        {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+            return (p - start) + (__builtin_clzll(diff) / 8);
+#else
+            return (p - start) + (__builtin_ctzll(diff) / 8);
+#endif
+        }
+        p += sizeof(word);
+    }
+    while (p < end && *p == sym)
     {
-    case 0b11:
-        *len = (size_t) ((*(p + 0)) & 0x3f) << 24 |
-               (size_t)  (*(p + 1))         << 16 |
-               (size_t)  (*(p + 2))         <<  8 |
-               (size_t)  (*(p + 3))         <<  0;
-        return ((uint8_t*)p + 4);
-    case 0b10:
-        *len = (size_t) ((*(p + 0)) & 0x3f) << 16 |
-               (size_t)  (*(p + 1))         <<  8 |
-               (size_t)  (*(p + 2))         <<  0;
-        return ((uint8_t*)p + 3);
-    case 0b01:
-        *len = (size_t) ((*(p + 0)) & 0x3f) <<  8 |
-               (size_t)  (*(p + 1))         <<  0;
-        return ((uint8_t*)p + 2);
-    case 0b00:
-        *len = (size_t) ((*(p + 0)) & 0x3f) <<  0;
-        return ((uint8_t*)p + 1);
+        p++;
     }
 
-    return NULL;
+    return p - start;
 }
 
 static inline OS_Error_t
@@ -132,15 +150,11 @@ compress(
     while (ip < (ibuf + ilen))
     {
         sym  = *ip;
-        slen = 1;
-        // Check how often the symbol is found in sequence
-        while (++ip < (ibuf + ilen) && *ip == sym)
-        {
-            slen++;
-        }
+        slen = 1 + getRunLength(ip + 1, ibuf + ilen, sym);
+        ip  += slen;
         // Make sure we can fit the serialized len bytes and the symbol
         sz = getLenSize(slen);
-        if ((op + sz + 1) < (obuf + osz))
+        if ((op + sz + 1) <= (obuf + osz))
         {
             op = serializeLen(sz, slen, op);
             *(op++) = sym;
@@ -156,41 +170,397 @@ compress(
     return OS_SUCCESS;
 }
 
+static size_t
+getEncodedSize(
+    const size_t   ilen,
+    const uint8_t* ibuf)
+{
+    /*
+     * Same as compress(), but only count the bytes we would write
+     */
+
+    const uint8_t* ip = ibuf;
+    size_t slen, osz = 0;
+
+    while (ip < (ibuf + ilen))
+    {
+        slen = 1 + getRunLength(ip + 1, ibuf + ilen, *ip);
+        ip  += slen;
+        osz += getLenSize(slen) + 1;
+    }
+
+    return osz;
+}
+
+static bool
+putTokenV2(
+    const bool     literal,
+    const size_t   count,
+    const uint8_t* src,
+    const size_t   osz,
+    size_t*        olen,
+    uint8_t*       obuf)
+{
+    /*
+     * Write a v2 token at obuf + *olen, which is either a literal run of count
+     * raw bytes or a run of count times the symbol *src. If obuf is NULL, only
+     * the size is counted.
+     */
+
+    const size_t val = (count << 1) | (literal ? 1 : 0);
+    const size_t sz  = getLenSize(val);
+    const size_t len = sz + (literal ? count : 1);
+    uint8_t* p;
+
+    if (len > osz - *olen)
+    {
+        return false;
+    }
+    if (obuf != NULL)
+    {
+        p = serializeLen(sz, val, obuf + *olen);
+        memcpy(p, src, literal ? count : 1);
+    }
+    *olen += len;
+
+    return true;
+}
+
+static bool
+putLiteralV2(
+    const uint8_t* lit,
+    const uint8_t* end,
+    const size_t   osz,
+    size_t*        olen,
+    uint8_t*       obuf)
+{
+    size_t n;
+
+    while (lit < end)
+    {
+        n = ((size_t) (end - lit) < V2_MAX_COUNT) ? (size_t) (end - lit) :
+            (size_t) V2_MAX_COUNT;
+        if (!putTokenV2(true, n, lit, osz, olen, obuf))
+        {
+            return false;
+        }
+        lit += n;
+    }
+
+    return true;
+}
+
 static inline OS_Error_t
-decompress(
+compressV2(
     const size_t   ilen,
     const uint8_t* ibuf,
     const size_t   osz,
+    size_t*        olen,
     uint8_t*       obuf)
 {
-    const uint8_t* ip = ibuf;
-    uint8_t sym, *op = obuf;
-    size_t slen;
+    /*
+     * Same as compress(), but for the v2 format: short runs are collected into
+     * literal runs, so that incompressible data grows by a few bytes at most.
+     * If obuf is NULL, only the size is counted.
+     */
+
+    const uint8_t* ip = ibuf, *lit = ibuf;
+    size_t slen, n;
 
+    *olen = 0;
     while (ip < (ibuf + ilen))
     {
-        // Read number of occurences of symbol and the symbol itself
-        ip  = deserializeLen(ip, &slen);
-        sym = *(ip++);
-        // Make sure we don't exceed the expected length
-        if (slen + (op - obuf) > osz)
+        slen = 1 + getRunLength(ip + 1, ibuf + ilen, *ip);
+        if (slen >= V2_MIN_RUN)
+        {
+            if (!putLiteralV2(lit, ip, osz, olen, obuf))
+            {
+                return OS_ERROR_ABORTED;
+            }
+            for (lit = ip + slen; ip < lit; ip += n)
+            {
+                n = ((size_t) (lit - ip) < V2_MAX_COUNT) ? (size_t) (lit - ip) :
+                    (size_t) V2_MAX_COUNT;
+                if (!putTokenV2(false, n, ip, osz, olen, obuf))
+                {
+                    return OS_ERROR_ABORTED;
+                }
+            }
+        }
+        else
+        {
+            ip += slen;
+        }
+    }
+
+    return putLiteralV2(lit, ip, osz, olen, obuf) ?
+           OS_SUCCESS : OS_ERROR_ABORTED;
+}
+
+static inline size_t
+getEncodedLenSize(
+    const uint8_t first)
+{
+    /*
+     * The first two bits of the first byte tell how many bytes were used to
+     * serialize the length, see serializeLen()
+     */
+
+    return (first >> 6) + 1;
+}
+
+static inline OS_Error_t
+expandRun(
+    const uint8_t** ip,
+    uint8_t**       op,
+    const uint8_t*  oend)
+{
+    uint8_t sym;
+    size_t slen;
+
+    // Read number of occurences of symbol and the symbol itself
+    *ip = deserializeLen(*ip, &slen);
+    sym = *((*ip)++);
+    // Make sure we don't exceed the expected length
+    if (slen > (size_t) (oend - *op))
+    {
+        return OS_ERROR_ABORTED;
+    }
+    // Write symbol as often as we found it
+    memset(*op, sym, slen);
+    *op += slen;
+
+    return OS_SUCCESS;
+}
+
+static inline OS_Error_t
+decompress(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    uint8_t*       obuf)
+{
+    const uint8_t* ip = ibuf, *iend = ibuf + ilen;
+    uint8_t* op = obuf, *oend = obuf + osz;
+    OS_Error_t err;
+    size_t n;
+
+    // As long as the remaining input can hold n encoded symbols of maximum
+    // size, the next n symbols can be decoded without checking the bounds of
+    // the input for each of them
+    while ((n = (iend - ip) / ENCODED_SYMBOL_MAX_SIZE) > 0)
+    {
+        while (n-- > 0)
+        {
+            if ((err = expandRun(&ip, &op, oend)) != OS_SUCCESS)
+            {
+                return err;
+            }
+        }
+    }
+    // The last few symbols are checked one by one, so that a truncated input
+    // is never read beyond its end
+    while (ip < iend)
+    {
+        if ((size_t) (iend - ip) < getEncodedLenSize(*ip) + 1)
         {
             return OS_ERROR_ABORTED;
         }
-        // Write symbol as often as we found it
-        while (slen-- > 0)
+        if ((err = expandRun(&ip, &op, oend)) != OS_SUCCESS)
         {
-            *(op++) = sym;
+            return err;
         }
     }
+    // An input truncated at a symbol boundary yields less data than expected
+    if (op != oend)
+    {
+        return OS_ERROR_ABORTED;
+    }
 
     return OS_SUCCESS;
 }
 
-// Public functions ------------------------------------------------------------
+static inline OS_Error_t
+decompressV2(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    uint8_t*       obuf)
+{
+    /*
+     * Same as decompress(), but for the v2 format. Literal runs are copied
+     * with memmove(), as with in place decompression the output may get close
+     * to the input.
+     */
 
-OS_Error_t
-RleCompressor_compress(
+    const uint8_t* ip = ibuf, *iend = ibuf + ilen;
+    uint8_t* op = obuf, *oend = obuf + osz;
+    size_t val, slen;
+
+    while (ip < iend)
+    {
+        if ((size_t) (iend - ip) < getEncodedLenSize(*ip))
+        {
+            return OS_ERROR_ABORTED;
+        }
+        ip   = deserializeLen(ip, &val);
+        slen = val >> 1;
+        if (slen > (size_t) (oend - op))
+        {
+            return OS_ERROR_ABORTED;
+        }
+        if (val & 1)
+        {
+            if (slen > (size_t) (iend - ip))
+            {
+                return OS_ERROR_ABORTED;
+            }
+            memmove(op, ip, slen);
+            ip += slen;
+        }
+        else
+        {
+            if (ip == iend)
+            {
+                return OS_ERROR_ABORTED;
+            }
+            memset(op, *(ip++), slen);
+        }
+        op += slen;
+    }
+    if (op != oend)
+    {
+        return OS_ERROR_ABORTED;
+    }
+
+    return OS_SUCCESS;
+}
+
+static OS_Error_t
+readHeader(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    int*           version,
+    size_t*        olen)
+{
+    if (ilen < HEADER_LENGTH)
+    {
+        return OS_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Check magic header
+    if (!memcmp(ibuf, MAGIC_V1, MAGIC_LENGTH))
+    {
+        *version = 1;
+    }
+    else if (!memcmp(ibuf, MAGIC_V2, MAGIC_LENGTH))
+    {
+        *version = 2;
+    }
+    else
+    {
+        return OS_ERROR_INVALID_STATE;
+    }
+    // Get the expected length after decompression
+    *olen = BitConverter_getUint32LE(ibuf + MAGIC_LENGTH);
+
+    return OS_SUCCESS;
+}
+
+static void
+flushStream(
+    RleCompressor_CompressStream* self,
+    uint8_t**                     op,
+    const uint8_t*                oend)
+{
+    /*
+     * Write as much of the buffered encoded data as fits into the output
+     */
+
+    size_t n = self->bufLen - self->bufPos;
+
+    if (n > (size_t) (oend - *op))
+    {
+        n = oend - *op;
+    }
+    memcpy(*op, self->buf + self->bufPos, n);
+    *op          += n;
+    self->bufPos += n;
+    if (self->bufPos == self->bufLen)
+    {
+        self->bufPos = self->bufLen = 0;
+    }
+}
+
+static void
+endStreamRun(
+    RleCompressor_CompressStream* self)
+{
+    /*
+     * Encode the current run into the stream buffer, which must be empty
+     */
+
+    uint8_t* p;
+
+    p = serializeLen(getLenSize(self->runLen), self->runLen, self->buf);
+    *(p++) = self->sym;
+    self->bufPos = 0;
+    self->bufLen = p - self->buf;
+    self->runLen = 0;
+}
+
+static OS_Error_t
+getInPlaceMargin(
+    const int      version,
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    size_t*        margin)
+{
+    /*
+     * Walk the encoded symbols without writing anything, to validate them and
+     * to find by how much the output would overtake the input if both started
+     * at the same address: the largest difference between the bytes written
+     * and the bytes read after any symbol.
+     */
+
+    const uint8_t* ip = ibuf;
+    size_t val, slen, data, produced = 0, consumed;
+
+    *margin = 0;
+    while (ip < (ibuf + ilen))
+    {
+        if ((size_t) ((ibuf + ilen) - ip) < getEncodedLenSize(*ip))
+        {
+            return OS_ERROR_ABORTED;
+        }
+        ip   = deserializeLen(ip, &val);
+        slen = (version == 1) ? val : val >> 1;
+        // A literal run is followed by its bytes, a run by its symbol
+        data = (version != 1 && (val & 1)) ? slen : 1;
+        if (data > (size_t) ((ibuf + ilen) - ip))
+        {
+            return OS_ERROR_ABORTED;
+        }
+        ip += data;
+        if (slen > osz - produced)
+        {
+            return OS_ERROR_ABORTED;
+        }
+        produced += slen;
+        consumed  = ip - ibuf;
+        if (produced > consumed && produced - consumed > *margin)
+        {
+            *margin = produced - consumed;
+        }
+    }
+
+    return (produced == osz) ? OS_SUCCESS : OS_ERROR_ABORTED;
+}
+
+static OS_Error_t
+compressVersion(
+    const int      version,
     const size_t   ilen,
     const uint8_t* ibuf,
     const size_t   osz,
@@ -222,10 +592,17 @@ RleCompressor_compress(
     }
     else
     {
-        // If we didn't get a buffer we allocate one with maximum possible size,
-        // i.e., every symbol is encoded into two bytes + the header. We will
-        // shrink the buffer later once the final size is known
-        sz = (2 * ilen) + HEADER_LENGTH;
+        // If we didn't get a buffer we allocate one with the exact size, which
+        // a counting pass over the input gives us
+        if (version == 1)
+        {
+            sz = getEncodedSize(ilen, ibuf);
+        }
+        else
+        {
+            compressV2(ilen, ibuf, SIZE_MAX, &sz, NULL);
+        }
+        sz += HEADER_LENGTH;
         if ((my_obuf = malloc(sz)) == NULL)
         {
             return OS_ERROR_INSUFFICIENT_SPACE;
@@ -233,12 +610,16 @@ RleCompressor_compress(
     }
 
     // Write some magic bytes as header
-    memcpy(my_obuf, "RLE", 3);
+    memcpy(my_obuf, (version == 1) ? MAGIC_V1 : MAGIC_V2, MAGIC_LENGTH);
     // Write the uncompressed length
-    BitConverter_putUint32LE(ilen, my_obuf + 3);
+    BitConverter_putUint32LE(ilen, my_obuf + MAGIC_LENGTH);
 
-    if ((err = compress(ilen, ibuf, sz - HEADER_LENGTH, &my_olen,
-                        my_obuf + HEADER_LENGTH)) != OS_SUCCESS)
+    err = (version == 1) ?
+          compress(ilen, ibuf, sz - HEADER_LENGTH, &my_olen,
+                   my_obuf + HEADER_LENGTH) :
+          compressV2(ilen, ibuf, sz - HEADER_LENGTH, &my_olen,
+                     my_obuf + HEADER_LENGTH);
+    if (err != OS_SUCCESS)
     {
         *olen = 0;
         if (!osz)
@@ -250,48 +631,375 @@ RleCompressor_compress(
     else
     {
         *olen = my_olen + HEADER_LENGTH;
-        if (!osz)
-        {
-            // If we allocated a buffer, shrink it to the final size
-            *obuf  = realloc(my_obuf, *olen);
-        }
+        *obuf = my_obuf;
     }
 
     return err;
 }
 
-OS_Error_t
-RleCompressor_decompress(
+static OS_Error_t
+decompressRange(
+    const int      version,
     const size_t   ilen,
     const uint8_t* ibuf,
+    const size_t   skip,
     const size_t   osz,
-    size_t*        olen,
-    uint8_t**      obuf)
+    uint8_t*       obuf)
 {
-    OS_Error_t err;
-    size_t my_olen;
-    uint8_t* my_obuf;
+    /*
+     * Decode only the output bytes from 'skip' to 'skip' + 'osz', the symbols
+     * in front of them are walked without writing anything and the walk stops
+     * after the last byte of the range.
+     */
 
-    if (NULL == ibuf || NULL == olen || NULL == obuf)
-    {
-        return OS_ERROR_INVALID_PARAMETER;
-    }
-    if (ilen < HEADER_LENGTH)
+    const uint8_t* ip = ibuf, *iend = ibuf + ilen;
+    const size_t end = skip + osz;
+    size_t val, slen, data, from, to, pos = 0;
+    bool literal;
+
+    while (pos < end)
     {
-        return OS_ERROR_BUFFER_TOO_SMALL;
+        if (ip == iend || (size_t) (iend - ip) < getEncodedLenSize(*ip))
+        {
+            return OS_ERROR_ABORTED;
+        }
+        ip      = deserializeLen(ip, &val);
+        literal = (version != 1) && (val & 1);
+        slen    = (version == 1) ? val : val >> 1;
+        data    = literal ? slen : 1;
+        if (data > (size_t) (iend - ip))
+        {
+            return OS_ERROR_ABORTED;
+        }
+        // Write the part of the run which overlaps with the range
+        from = (pos > skip) ? pos : skip;
+        to   = (pos + slen < end) ? pos + slen : end;
+        if (from < to)
+        {
+            if (literal)
+            {
+                memcpy(obuf + (from - skip), ip + (from - pos), to - from);
+            }
+            else
+            {
+                memset(obuf + (from - skip), *ip, to - from);
+            }
+        }
+        pos += slen;
+        ip  += data;
     }
 
-    // Check magic header
-    if (memcmp(ibuf, "RLE", 3))
+    return OS_SUCCESS;
+}
+
+static OS_Error_t
+runJobs(
+    void*             pool,
+    size_t            n,
+    RleCompressor_Job job,
+    void*             ctx)
+{
+    /*
+     * Default runner of the block functions, runs the jobs one after the
+     * other and stops at the first error; it has no use for a pool
+     */
+
+    OS_Error_t err = OS_SUCCESS;
+
+    (void) pool;
+
+    for (size_t i = 0; i < n && err == OS_SUCCESS; i++)
     {
-        return OS_ERROR_INVALID_STATE;
+        err = job(ctx, i);
     }
-    // Get the expected length after decompression
-    my_olen = BitConverter_getUint32LE(ibuf + 3);
 
-    // If we have given an output size, check it would fit; if the output
-    // size is set to 0, that means we should allocate a buffer with the
-    // expected size
+    return err;
+}
+
+// State shared by the jobs of RleCompressor_compressBlocks()
+typedef struct
+{
+    size_t         ilen;
+    const uint8_t* ibuf;
+    size_t         bsize;
+    size_t*        offs;    ///< n + 1 offsets of the blocks in obuf
+    uint8_t*       obuf;    ///< start of the encoded blocks
+} CompressBlocksCtx;
+
+// State shared by the jobs of RleCompressor_decompressBlocks()
+typedef struct
+{
+    size_t         ilen;
+    const uint8_t* ibuf;
+    size_t         olen;
+    size_t         bsize;
+    size_t         n;
+    uint8_t*       obuf;
+} DecompressBlocksCtx;
+
+static size_t
+getBlockLength(
+    const size_t len,
+    const size_t bsize,
+    const size_t index)
+{
+    /*
+     * All blocks are of the same size, except for the last one
+     */
+
+    return (len - index * bsize < bsize) ? len - index * bsize : bsize;
+}
+
+static OS_Error_t
+sizeBlockJob(
+    void*  ctx,
+    size_t index)
+{
+    CompressBlocksCtx* self = ctx;
+
+    // Store the size after the start offset, the sizes are summed up later
+    return RleCompressor_getCompressedSizeV2(
+               getBlockLength(self->ilen, self->bsize, index),
+               self->ibuf + index * self->bsize,
+               &self->offs[index + 1]);
+}
+
+static OS_Error_t
+compressBlockJob(
+    void*  ctx,
+    size_t index)
+{
+    CompressBlocksCtx* self = ctx;
+    uint8_t* p = self->obuf + self->offs[index];
+    size_t len;
+
+    return compressVersion(2, getBlockLength(self->ilen, self->bsize, index),
+                           self->ibuf + index * self->bsize,
+                           self->offs[index + 1] - self->offs[index],
+                           &len, &p);
+}
+
+static OS_Error_t
+readBlocksHeader(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen,
+    size_t*        bsize,
+    size_t*        n)
+{
+    if (ilen < BLOCKS_HEADER_LENGTH)
+    {
+        return OS_ERROR_BUFFER_TOO_SMALL;
+    }
+    if (memcmp(ibuf, MAGIC_BLOCKS, MAGIC_LENGTH))
+    {
+        return OS_ERROR_INVALID_STATE;
+    }
+    *olen  = BitConverter_getUint32LE(ibuf + MAGIC_LENGTH);
+    *bsize = BitConverter_getUint32LE(ibuf + HEADER_LENGTH);
+    if (*bsize == 0)
+    {
+        return OS_ERROR_ABORTED;
+    }
+    // Make sure all the offsets are there
+    *n = (*olen / *bsize) + ((*olen % *bsize) ? 1 : 0);
+    if ((ilen - BLOCKS_HEADER_LENGTH) / sizeof(uint32_t) < *n)
+    {
+        return OS_ERROR_ABORTED;
+    }
+
+    return OS_SUCCESS;
+}
+
+static OS_Error_t
+getBlock(
+    const size_t    ilen,
+    const uint8_t*  ibuf,
+    const size_t    n,
+    const size_t    index,
+    size_t*         clen,
+    const uint8_t** cbuf)
+{
+    /*
+     * Find the encoded block with the given index, the offsets are the ends
+     * of the blocks counted from the end of the offsets
+     */
+
+    const uint8_t* offs = ibuf + BLOCKS_HEADER_LENGTH;
+    const uint8_t* data = offs + n * sizeof(uint32_t);
+    size_t start, end;
+
+    start = (index > 0) ?
+            BitConverter_getUint32LE(offs + (index - 1) * sizeof(uint32_t)) : 0;
+    end   = BitConverter_getUint32LE(offs + index * sizeof(uint32_t));
+    if (start > end || end > (size_t) ((ibuf + ilen) - data))
+    {
+        return OS_ERROR_ABORTED;
+    }
+    *clen = end - start;
+    *cbuf = data + start;
+
+    return OS_SUCCESS;
+}
+
+static OS_Error_t
+decompressBlockJob(
+    void*  ctx,
+    size_t index)
+{
+    DecompressBlocksCtx* self = ctx;
+    const size_t blen = getBlockLength(self->olen, self->bsize, index);
+    uint8_t* p = self->obuf + index * self->bsize;
+    const uint8_t* cbuf;
+    size_t clen, len;
+    OS_Error_t err;
+
+    if ((err = getBlock(self->ilen, self->ibuf, self->n, index, &clen,
+                        &cbuf)) != OS_SUCCESS)
+    {
+        return err;
+    }
+    err = RleCompressor_decompress(clen, cbuf, blen, &len, &p);
+    // The block has to decode to exactly its part of the output, if it does
+    // not fit the input is corrupted
+    if (err == OS_ERROR_BUFFER_TOO_SMALL || (err == OS_SUCCESS && len != blen))
+    {
+        err = OS_ERROR_ABORTED;
+    }
+
+    return err;
+}
+
+static OS_Error_t
+compressBlocks(
+    CompressBlocksCtx*   ctx,
+    const size_t         n,
+    RleCompressor_Runner runner,
+    void*                pool,
+    const size_t         osz,
+    size_t*              olen,
+    uint8_t**            obuf)
+{
+    OS_Error_t err;
+    size_t limit, sz;
+    uint8_t* my_obuf;
+
+    // First round: size every block, so that all blocks can be encoded in
+    // parallel right to their final place
+    ctx->offs[0] = 0;
+    if ((err = runner(pool, n, sizeBlockJob, ctx)) != OS_SUCCESS)
+    {
+        return err;
+    }
+
+    // The offsets are uint32, and so is the total length
+    if (n > (UINT32_MAX - BLOCKS_HEADER_LENGTH) / sizeof(uint32_t))
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    limit = UINT32_MAX - BLOCKS_HEADER_LENGTH - n * sizeof(uint32_t);
+    for (size_t i = 1; i <= n; i++)
+    {
+        if (ctx->offs[i] > limit - ctx->offs[i - 1])
+        {
+            return OS_ERROR_INVALID_PARAMETER;
+        }
+        ctx->offs[i] += ctx->offs[i - 1];
+    }
+    sz = BLOCKS_HEADER_LENGTH + n * sizeof(uint32_t) + ctx->offs[n];
+
+    if (osz)
+    {
+        if (osz < sz)
+        {
+            return OS_ERROR_BUFFER_TOO_SMALL;
+        }
+        my_obuf = *obuf;
+    }
+    else if ((my_obuf = malloc(sz)) == NULL)
+    {
+        return OS_ERROR_INSUFFICIENT_SPACE;
+    }
+
+    memcpy(my_obuf, MAGIC_BLOCKS, MAGIC_LENGTH);
+    BitConverter_putUint32LE(ctx->ilen, my_obuf + MAGIC_LENGTH);
+    BitConverter_putUint32LE(ctx->bsize, my_obuf + HEADER_LENGTH);
+    for (size_t i = 0; i < n; i++)
+    {
+        BitConverter_putUint32LE(ctx->offs[i + 1],
+                                 my_obuf + BLOCKS_HEADER_LENGTH +
+                                 i * sizeof(uint32_t));
+    }
+
+    // Second round: encode the blocks
+    ctx->obuf = my_obuf + BLOCKS_HEADER_LENGTH + n * sizeof(uint32_t);
+    if ((err = runner(pool, n, compressBlockJob, ctx)) != OS_SUCCESS)
+    {
+        *olen = 0;
+        if (!osz)
+        {
+            free(my_obuf);
+            *obuf = NULL;
+        }
+    }
+    else
+    {
+        *olen = sz;
+        *obuf = my_obuf;
+    }
+
+    return err;
+}
+
+// Public functions ------------------------------------------------------------
+
+OS_Error_t
+RleCompressor_compress(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    size_t*        olen,
+    uint8_t**      obuf)
+{
+    return compressVersion(1, ilen, ibuf, osz, olen, obuf);
+}
+
+OS_Error_t
+RleCompressor_compressV2(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    size_t*        olen,
+    uint8_t**      obuf)
+{
+    return compressVersion(2, ilen, ibuf, osz, olen, obuf);
+}
+
+OS_Error_t
+RleCompressor_decompress(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   osz,
+    size_t*        olen,
+    uint8_t**      obuf)
+{
+    OS_Error_t err;
+    size_t my_olen;
+    uint8_t* my_obuf;
+    int version;
+
+    if (NULL == ibuf || NULL == olen || NULL == obuf)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if ((err = readHeader(ilen, ibuf, &version, &my_olen)) != OS_SUCCESS)
+    {
+        return err;
+    }
+
+    // If we have given an output size, check it would fit; if the output
+    // size is set to 0, that means we should allocate a buffer with the
+    // expected size
     if (osz)
     {
         if (my_olen > osz)
@@ -305,8 +1013,12 @@ RleCompressor_decompress(
         return OS_ERROR_INSUFFICIENT_SPACE;
     }
 
-    if ((err = decompress(ilen - HEADER_LENGTH, ibuf + HEADER_LENGTH, my_olen,
-                          my_obuf)) != OS_SUCCESS)
+    err = (version == 1) ?
+          decompress(ilen - HEADER_LENGTH, ibuf + HEADER_LENGTH, my_olen,
+                     my_obuf) :
+          decompressV2(ilen - HEADER_LENGTH, ibuf + HEADER_LENGTH, my_olen,
+                       my_obuf);
+    if (err != OS_SUCCESS)
     {
         *olen = 0;
         if (!osz)
@@ -324,4 +1036,555 @@ RleCompressor_decompress(
     return err;
 }
 
+OS_Error_t
+RleCompressor_CompressStream_init(
+    RleCompressor_CompressStream* self,
+    const size_t                  ilen)
+{
+    if (NULL == self)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if (ilen > RLECOMPRESSOR_MAX_INPUT_SIZE)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    memset(self, 0, sizeof(*self));
+    self->ilen = ilen;
+    // The header is the first thing to write
+    memcpy(self->buf, MAGIC_V1, MAGIC_LENGTH);
+    BitConverter_putUint32LE(ilen, self->buf + MAGIC_LENGTH);
+    self->bufLen = HEADER_LENGTH;
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_CompressStream_update(
+    RleCompressor_CompressStream* self,
+    const size_t                  ilen,
+    const uint8_t*                ibuf,
+    size_t*                       iused,
+    const size_t                  osz,
+    size_t*                       olen,
+    uint8_t*                      obuf)
+{
+    const uint8_t* ip = ibuf;
+    uint8_t* op = obuf;
+    size_t n;
+
+    if (NULL == self || NULL == ibuf || NULL == iused || NULL == olen ||
+        NULL == obuf)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if (ilen > self->ilen - self->consumed)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    flushStream(self, &op, obuf + osz);
+    // Stop as soon as the encoded data does not fit the output anymore, the
+    // rest stays in the buffer of the stream
+    while (ip < (ibuf + ilen) && self->bufLen == 0)
+    {
+        if (self->runLen == 0)
+        {
+            self->sym    = *(ip++);
+            self->runLen = 1;
+        }
+        n = getRunLength(ip, ibuf + ilen, self->sym);
+        self->runLen += n;
+        ip           += n;
+        // If we did not reach the end of the input, the run is over
+        if (ip < (ibuf + ilen))
+        {
+            endStreamRun(self);
+            flushStream(self, &op, obuf + osz);
+        }
+    }
+
+    *iused          = ip - ibuf;
+    *olen           = op - obuf;
+    self->consumed += *iused;
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_CompressStream_finish(
+    RleCompressor_CompressStream* self,
+    const size_t                  osz,
+    size_t*                       olen,
+    uint8_t*                      obuf)
+{
+    uint8_t* op = obuf;
+
+    if (NULL == self || NULL == olen || NULL == obuf)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if (self->consumed != self->ilen)
+    {
+        return OS_ERROR_INVALID_STATE;
+    }
+
+    flushStream(self, &op, obuf + osz);
+    if (self->bufLen == 0 && self->runLen > 0)
+    {
+        endStreamRun(self);
+        flushStream(self, &op, obuf + osz);
+    }
+    *olen = op - obuf;
+
+    return (self->bufLen == 0) ? OS_SUCCESS : OS_ERROR_BUFFER_TOO_SMALL;
+}
+
+OS_Error_t
+RleCompressor_DecompressStream_init(
+    RleCompressor_DecompressStream* self)
+{
+    if (NULL == self)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    memset(self, 0, sizeof(*self));
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_DecompressStream_update(
+    RleCompressor_DecompressStream* self,
+    const size_t                    ilen,
+    const uint8_t*                  ibuf,
+    size_t*                         iused,
+    const size_t                    osz,
+    size_t*                         olen,
+    uint8_t*                        obuf)
+{
+    const uint8_t* ip = ibuf, *iend = ibuf + ilen, *p;
+    uint8_t* op = obuf, *oend = obuf + osz;
+    OS_Error_t err = OS_SUCCESS;
+    size_t n, need, val;
+
+    if (NULL == self || NULL == ibuf || NULL == iused || NULL == olen ||
+        NULL == obuf)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    for (;;)
+    {
+        // A run token is followed by its symbol
+        if (self->needSym)
+        {
+            if (ip == iend)
+            {
+                break;
+            }
+            self->sym     = *(ip++);
+            self->needSym = false;
+        }
+        // Continue the current run as far as the output allows, the bytes of
+        // a literal run are copied straight from the input
+        n = (self->runLeft < (size_t) (oend - op)) ?
+            self->runLeft : (size_t) (oend - op);
+        if (self->literal)
+        {
+            n = (n < (size_t) (iend - ip)) ? n : (size_t) (iend - ip);
+            memcpy(op, ip, n);
+            ip += n;
+        }
+        else
+        {
+            memset(op, self->sym, n);
+        }
+        op            += n;
+        self->runLeft -= n;
+        if (self->runLeft > 0 || ip == iend)
+        {
+            break;
+        }
+        // Get the header or the length field of the next token. Unless it is
+        // split between two chunks, it is read straight from the input
+        if (!self->hasHeader)
+        {
+            need = HEADER_LENGTH;
+        }
+        else
+        {
+            need = getEncodedLenSize((self->bufLen > 0) ? self->buf[0] : *ip);
+        }
+        if (self->bufLen == 0 && (size_t) (iend - ip) >= need)
+        {
+            p   = ip;
+            ip += need;
+        }
+        else
+        {
+            n = need - self->bufLen;
+            if (n > (size_t) (iend - ip))
+            {
+                n = iend - ip;
+            }
+            memcpy(self->buf + self->bufLen, ip, n);
+            ip           += n;
+            self->bufLen += n;
+            if (self->bufLen < need)
+            {
+                break;
+            }
+            p            = self->buf;
+            self->bufLen = 0;
+        }
+        if (!self->hasHeader)
+        {
+            if ((err = readHeader(need, p, &self->version,
+                                  &self->olen)) != OS_SUCCESS)
+            {
+                break;
+            }
+            self->hasHeader = true;
+        }
+        else
+        {
+            deserializeLen(p, &val);
+            self->literal = (self->version != 1) && (val & 1);
+            self->runLeft = (self->version == 1) ? val : val >> 1;
+            self->needSym = !self->literal;
+            // Make sure we don't exceed the expected length
+            if (self->runLeft > self->olen - self->decoded)
+            {
+                err = OS_ERROR_ABORTED;
+                break;
+            }
+            self->decoded += self->runLeft;
+        }
+    }
+
+    *iused = ip - ibuf;
+    *olen  = op - obuf;
+
+    return err;
+}
+
+OS_Error_t
+RleCompressor_DecompressStream_finish(
+    RleCompressor_DecompressStream* self)
+{
+    if (NULL == self)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    // Anything missing means the input was truncated or the caller did not
+    // provide enough output space to write everything
+    if (!self->hasHeader || self->bufLen > 0 || self->runLeft > 0 ||
+        self->needSym || self->decoded != self->olen)
+    {
+        return OS_ERROR_ABORTED;
+    }
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_getCompressedSize(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen)
+{
+    if (NULL == ibuf || NULL == olen)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if (ilen > RLECOMPRESSOR_MAX_INPUT_SIZE)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    *olen = getEncodedSize(ilen, ibuf) + HEADER_LENGTH;
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_getCompressedSizeV2(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen)
+{
+    if (NULL == ibuf || NULL == olen)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if (ilen > RLECOMPRESSOR_MAX_INPUT_SIZE)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    compressV2(ilen, ibuf, SIZE_MAX, olen, NULL);
+    *olen += HEADER_LENGTH;
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_getDecompressedSize(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        olen)
+{
+    int version;
+
+    if (NULL == ibuf || NULL == olen)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    return readHeader(ilen, ibuf, &version, olen);
+}
+
+OS_Error_t
+RleCompressor_getInPlaceSize(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    size_t*        bsz)
+{
+    OS_Error_t err;
+    size_t my_olen, margin;
+    int version;
+
+    if (NULL == ibuf || NULL == bsz)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if ((err = readHeader(ilen, ibuf, &version, &my_olen)) != OS_SUCCESS)
+    {
+        return err;
+    }
+    if ((err = getInPlaceMargin(version, ilen - HEADER_LENGTH,
+                                ibuf + HEADER_LENGTH, my_olen,
+                                &margin)) != OS_SUCCESS)
+    {
+        return err;
+    }
+
+    // The header is read before anything is written, so the output may
+    // overtake the input by its length without harm
+    *bsz = ilen + ((margin > HEADER_LENGTH) ? margin - HEADER_LENGTH : 0);
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_decompressInPlace(
+    const size_t bsz,
+    uint8_t*     buf,
+    const size_t ilen,
+    size_t*      olen)
+{
+    OS_Error_t err;
+    size_t my_olen, margin;
+    uint8_t* ibuf;
+    int version;
+
+    if (NULL == buf || NULL == olen || ilen > bsz)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    ibuf = buf + (bsz - ilen);
+    if ((err = readHeader(ilen, ibuf, &version, &my_olen)) != OS_SUCCESS)
+    {
+        return err;
+    }
+    // Validate everything before the first write, so that the input is left
+    // intact if the layout does not allow to decompress in place
+    if ((err = getInPlaceMargin(version, ilen - HEADER_LENGTH,
+                                ibuf + HEADER_LENGTH, my_olen,
+                                &margin)) != OS_SUCCESS)
+    {
+        return err;
+    }
+    if (margin > (size_t) (ibuf - buf) + HEADER_LENGTH)
+    {
+        return OS_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    err = (version == 1) ?
+          decompress(ilen - HEADER_LENGTH, ibuf + HEADER_LENGTH, my_olen,
+                     buf) :
+          decompressV2(ilen - HEADER_LENGTH, ibuf + HEADER_LENGTH, my_olen,
+                       buf);
+    if (err != OS_SUCCESS)
+    {
+        *olen = 0;
+        return err;
+    }
+    *olen = my_olen;
+
+    return OS_SUCCESS;
+}
+
+OS_Error_t
+RleCompressor_compressBlocks(
+    const size_t         ilen,
+    const uint8_t*       ibuf,
+    const size_t         bsize,
+    RleCompressor_Runner runner,
+    void*                pool,
+    const size_t         osz,
+    size_t*              olen,
+    uint8_t**            obuf)
+{
+    OS_Error_t err;
+    CompressBlocksCtx ctx;
+    size_t n;
+
+    if (NULL == obuf || NULL == ibuf || NULL == olen)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if (ilen > RLECOMPRESSOR_MAX_INPUT_SIZE || bsize == 0 ||
+        bsize > RLECOMPRESSOR_MAX_INPUT_SIZE)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    n = (ilen / bsize) + ((ilen % bsize) ? 1 : 0);
+    ctx.ilen  = ilen;
+    ctx.ibuf  = ibuf;
+    ctx.bsize = bsize;
+    if ((ctx.offs = malloc((n + 1) * sizeof(size_t))) == NULL)
+    {
+        return OS_ERROR_INSUFFICIENT_SPACE;
+    }
+    err = compressBlocks(&ctx, n, (NULL == runner) ? runJobs : runner, pool,
+                         osz, olen, obuf);
+    free(ctx.offs);
+
+    return err;
+}
+
+OS_Error_t
+RleCompressor_decompressBlocks(
+    const size_t         ilen,
+    const uint8_t*       ibuf,
+    RleCompressor_Runner runner,
+    void*                pool,
+    const size_t         osz,
+    size_t*              olen,
+    uint8_t**            obuf)
+{
+    OS_Error_t err;
+    DecompressBlocksCtx ctx;
+
+    if (NULL == ibuf || NULL == olen || NULL == obuf)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if ((err = readBlocksHeader(ilen, ibuf, &ctx.olen, &ctx.bsize,
+                                &ctx.n)) != OS_SUCCESS)
+    {
+        return err;
+    }
+
+    if (osz)
+    {
+        if (ctx.olen > osz)
+        {
+            return OS_ERROR_BUFFER_TOO_SMALL;
+        }
+        ctx.obuf = *obuf;
+    }
+    else if ((ctx.obuf = malloc(ctx.olen)) == NULL)
+    {
+        return OS_ERROR_INSUFFICIENT_SPACE;
+    }
+
+    ctx.ilen = ilen;
+    ctx.ibuf = ibuf;
+    err = ((NULL == runner) ? runJobs : runner)(pool, ctx.n,
+                                                 decompressBlockJob, &ctx);
+    if (err != OS_SUCCESS)
+    {
+        *olen = 0;
+        if (!osz)
+        {
+            free(ctx.obuf);
+            *obuf = NULL;
+        }
+    }
+    else
+    {
+        *olen = ctx.olen;
+        *obuf = ctx.obuf;
+    }
+
+    return err;
+}
+
+OS_Error_t
+RleCompressor_decompressBlocksAt(
+    const size_t   ilen,
+    const uint8_t* ibuf,
+    const size_t   offset,
+    const size_t   len,
+    uint8_t*       obuf)
+{
+    OS_Error_t err;
+    const uint8_t* cbuf;
+    size_t olen, bsize, n, clen, hlen, blen, start, skip, part, pos = offset;
+    int version;
+
+    if (NULL == ibuf || NULL == obuf)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+    if ((err = readBlocksHeader(ilen, ibuf, &olen, &bsize, &n)) != OS_SUCCESS)
+    {
+        return err;
+    }
+    if (len > olen || offset > olen - len)
+    {
+        return OS_ERROR_INVALID_PARAMETER;
+    }
+
+    // Only decode the blocks which overlap with the range
+    while (pos < offset + len)
+    {
+        start = (pos / bsize) * bsize;
+        skip  = pos - start;
+        blen  = getBlockLength(olen, bsize, pos / bsize);
+        part  = (blen - skip < offset + len - pos) ?
+                blen - skip : offset + len - pos;
+        if ((err = getBlock(ilen, ibuf, n, pos / bsize, &clen,
+                            &cbuf)) != OS_SUCCESS)
+        {
+            return err;
+        }
+        if ((err = readHeader(clen, cbuf, &version, &hlen)) != OS_SUCCESS)
+        {
+            return (err == OS_ERROR_BUFFER_TOO_SMALL) ? OS_ERROR_ABORTED : err;
+        }
+        if (hlen != blen)
+        {
+            return OS_ERROR_ABORTED;
+        }
+        if ((err = decompressRange(version, clen - HEADER_LENGTH,
+                                   cbuf + HEADER_LENGTH, skip, part,
+                                   obuf + (pos - offset))) != OS_SUCCESS)
+        {
+            return err;
+        }
+        pos += part;
+    }
+
+    return OS_SUCCESS;
+}
+
 ///@}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/*
+ * Usage: lib_utils_bench [FILTER]
+ *
+ * Runs the benchmarks whose name contains FILTER, all of them if it is not
+ * given, and writes the results as JSON lines on stdout.
+ */
+
+#include "Bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+volatile uint64_t Bench_sink;
+
+static char const* filter;
+
+static uint64_t
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static int
+cmp_u64(void const* a, void const* b)
+{
+    uint64_t x = *(uint64_t const*) a;
+    uint64_t y = *(uint64_t const*) b;
+
+    return (x > y) - (x < y);
+}
+
+bool
+Bench_isSelected(char const* name)
+{
+    return (filter == NULL) || (strstr(name, filter) != NULL);
+}
+
+uint64_t
+Bench_random(uint64_t* state)
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+void
+Bench_run(
+    char const* name,
+    size_t      n,
+    size_t      ops,
+    char const* unit,
+    Bench_Fn    fn,
+    void*       ctx)
+{
+    uint64_t ns[Bench_RUNS];
+
+    if (!Bench_isSelected(name))
+    {
+        return;
+    }
+    fn(ctx);
+    for (int i = 0; i < Bench_RUNS; ++i)
+    {
+        uint64_t start = now_ns();
+        fn(ctx);
+        ns[i] = now_ns() - start;
+    }
+    qsort(ns, Bench_RUNS, sizeof(ns[0]), cmp_u64);
+    printf("{\"benchmark\":\"%s\",\"n\":%zu,\"ops\":%zu,\"runs\":%d,"
+           "\"unit\":\"%s\",\"ns_min\":%llu,\"ns_median\":%llu,"
+           "\"ns_per_op\":%.3f}\n",
+           name, n, ops, Bench_RUNS, unit,
+           (unsigned long long) ns[0],
+           (unsigned long long) ns[Bench_RUNS / 2],
+           (double) ns[0] / (double) (ops ? ops : 1));
+    fflush(stdout);
+}
+
+int
+main(int argc, char* argv[])
+{
+    if (argc > 1)
+    {
+        filter = argv[1];
+    }
+    Bench_FifoT();
+    Bench_VectorT();
+    Bench_MapT();
+    Bench_RleCompressor();
+    Bench_BitConverter();
+    return 0;
+}
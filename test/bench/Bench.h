@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/**
+ * @file Bench.h
+ *
+ * @brief Benchmark runner of lib_utils
+ *
+ * Each benchmark is a function which performs a given number of operations on
+ * a prepared context. #Bench_run() times a few runs of it and prints one JSON
+ * object per line on stdout, e.g.
+ *
+ * @code
+ * {"benchmark":"MapT_HASHED/getIndexOf","n":1024,"ops":1048576,"runs":5,
+ *  "unit":"op","ns_min":...,"ns_median":...,"ns_per_op":...}
+ * @endcode
+ *
+ * 'n' is the size of the data set, 'ns_per_op' is derived from the fastest
+ * run. The output is meant to be collected by the performance dashboard.
+ */
+
+#if !defined(BENCH_H)
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef void (*Bench_Fn)(void* ctx);
+
+/**
+ * @brief times 'fn' and reports the result as benchmark 'name'
+ *
+ * 'fn' is called once to warm up, then Bench_RUNS times. It is skipped if
+ * 'name' does not match the filter given on the command line.
+ *
+ * @param name the name of the benchmark, "<container>/<operation>".
+ * @param n the size of the data set.
+ * @param ops the number of operations performed by a call of 'fn'.
+ * @param unit the unit of an operation, e.g. "op" or "byte".
+ * @param fn the benchmark.
+ * @param ctx the context passed to 'fn'.
+ */
+void
+Bench_run(
+    char const* name,
+    size_t      n,
+    size_t      ops,
+    char const* unit,
+    Bench_Fn    fn,
+    void*       ctx);
+
+/**
+ * @brief tells if the benchmark 'name' is selected by the command line filter,
+ *  it allows to skip the preparation of the context as well
+ */
+bool
+Bench_isSelected(char const* name);
+
+/**
+ * @brief deterministic pseudo random numbers (xorshift64)
+ */
+uint64_t
+Bench_random(uint64_t* state);
+
+/**
+ * @brief sink for results, it keeps the compiler from dropping the work
+ */
+extern volatile uint64_t Bench_sink;
+
+#define Bench_RUNS  5
+
+// Suites ---------------------------------------------------------------------
+
+void Bench_FifoT(void);
+void Bench_VectorT(void);
+void Bench_MapT(void);
+void Bench_RleCompressor(void);
+void Bench_BitConverter(void);
+
+// Element type of the containers ---------------------------------------------
+
+typedef uint32_t BenchU32;
+
+static inline bool
+BenchU32_ctorCopy(BenchU32* dst, BenchU32 const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+static inline bool
+BenchU32_ctorMove(BenchU32* dst, BenchU32 const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+static inline bool
+BenchU32_assign(BenchU32* dst, BenchU32 const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+static inline void
+BenchU32_dtor(BenchU32* el)
+{
+    (void) el;
+}
+
+static inline bool
+BenchU32_isEqual(BenchU32 const* a, BenchU32 const* b)
+{
+    return (*a == *b);
+}
+
+static inline uint32_t
+BenchU32_hash(BenchU32 const* key)
+{
+    /* finalizer of MurmurHash3, the keys of the benchmarks are sequential */
+    uint32_t h = *key;
+
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static inline int
+BenchU32_compare(BenchU32 const* a, BenchU32 const* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Bench.h"
+#include "lib_utils/BitConverter.h"
+
+#include <stdlib.h>
+
+#define ELEMENTS    4096u
+#define REPS        256u
+
+typedef struct
+{
+    uint32_t*   u32;
+    uint64_t*   u64;
+    uint8_t*    bytes;
+}
+Ctx;
+
+#define ARRAY_FN(name__, stmt__)                                            \
+    static void name__(void* arg)                                           \
+    {                                                                       \
+        Ctx* ctx = arg;                                                     \
+        for (size_t r = 0; r < REPS; ++r)                                   \
+        {                                                                   \
+            stmt__;                                                         \
+        }                                                                   \
+        Bench_sink += ctx->bytes[0];                                        \
+    }
+
+ARRAY_FN(putU32BE, BitConverter_putUint32ArrayBE(ctx->u32, ctx->bytes,
+                                                 ELEMENTS))
+ARRAY_FN(getU32BE, BitConverter_getUint32ArrayBE(ctx->bytes, ctx->u32,
+                                                 ELEMENTS))
+ARRAY_FN(putU32LE, BitConverter_putUint32ArrayLE(ctx->u32, ctx->bytes,
+                                                 ELEMENTS))
+ARRAY_FN(putU64BE, BitConverter_putUint64ArrayBE(ctx->u64, ctx->bytes,
+                                                 ELEMENTS))
+ARRAY_FN(getU64BE, BitConverter_getUint64ArrayBE(ctx->bytes, ctx->u64,
+                                                 ELEMENTS))
+ARRAY_FN(putVarU64, Bench_sink += BitConverter_putVarUint64Array(
+                                      ctx->u64, ELEMENTS, ctx->bytes))
+
+static void
+getVarU64(void* arg)
+{
+    Ctx* ctx = arg;
+    size_t len = BitConverter_putVarUint64Array(ctx->u64, ELEMENTS,
+                                                ctx->bytes);
+
+    for (size_t r = 0; r < REPS; ++r)
+    {
+        /* decoding into a scratch array keeps the encoded input intact */
+        Bench_sink += BitConverter_getVarUint64Array(ctx->bytes, len,
+                                                     ctx->u64 + ELEMENTS,
+                                                     ELEMENTS);
+    }
+}
+
+void
+Bench_BitConverter(void)
+{
+    uint64_t seed = 0xd1b54a32d192ed03ull;
+    Ctx ctx = {
+        .u32    = malloc(ELEMENTS * sizeof(uint32_t)),
+        .u64    = malloc(2 * ELEMENTS * sizeof(uint64_t)),
+        .bytes  = malloc(ELEMENTS * BitConverter_VARUINT64_MAX_SIZE)
+    };
+
+    if (ctx.u32 == NULL || ctx.u64 == NULL || ctx.bytes == NULL)
+    {
+        abort();
+    }
+    for (size_t i = 0; i < ELEMENTS; ++i)
+    {
+        uint64_t r = Bench_random(&seed);
+        ctx.u32[i] = (uint32_t) r;
+        /* values of every varint length */
+        ctx.u64[i] = r >> (r % 64);
+    }
+
+    const size_t ops = ELEMENTS * REPS;
+    Bench_run("BitConverter/putUint32ArrayBE", ELEMENTS, ops, "op",
+              putU32BE, &ctx);
+    Bench_run("BitConverter/getUint32ArrayBE", ELEMENTS, ops, "op",
+              getU32BE, &ctx);
+    Bench_run("BitConverter/putUint32ArrayLE", ELEMENTS, ops, "op",
+              putU32LE, &ctx);
+    Bench_run("BitConverter/putUint64ArrayBE", ELEMENTS, ops, "op",
+              putU64BE, &ctx);
+    Bench_run("BitConverter/getUint64ArrayBE", ELEMENTS, ops, "op",
+              getU64BE, &ctx);
+    Bench_run("BitConverter/putVarUint64Array", ELEMENTS, ops, "op",
+              putVarU64, &ctx);
+    Bench_run("BitConverter/getVarUint64Array", ELEMENTS, ops, "op",
+              getVarU64, &ctx);
+
+    free(ctx.bytes);
+    free(ctx.u64);
+    free(ctx.u32);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Bench.h"
+#include "lib_utils/FifoT.h"
+
+#include <stdlib.h>
+
+typedef FifoT_TYPE(BenchU32, size_t) BenchFifo;
+FifoT_DECLARE(BenchU32, BenchFifo, size_t);
+FifoT_DEFINE_TRIVIAL(BenchU32, BenchFifo, size_t)
+
+typedef FifoT_TYPE(BenchU32, size_t) BenchPow2Fifo;
+FifoT_DECLARE(BenchU32, BenchPow2Fifo, size_t);
+FifoT_DEFINE_POW2_TRIVIAL(BenchU32, BenchPow2Fifo, size_t)
+
+typedef FifoT_SPSC_TYPE(BenchU32, size_t) BenchSpscFifo;
+FifoT_SPSC_DECLARE(BenchU32, BenchSpscFifo, size_t);
+FifoT_SPSC_DEFINE_TRIVIAL(BenchU32, BenchSpscFifo, size_t)
+
+#define CHUNK   64
+
+typedef struct
+{
+    void*       fifo;
+    size_t      capacity;
+    size_t      ops;
+}
+Ctx;
+
+/* fills the FIFO up and drains it again, ops pushes and pops in total */
+#define PUSH_POP_FN(N)                                                      \
+    static void N##_pushPop(void* arg)                                      \
+    {                                                                       \
+        Ctx* ctx = arg;                                                     \
+        N* fifo = ctx->fifo;                                                \
+        uint64_t sum = 0;                                                   \
+                                                                            \
+        for (size_t done = 0; done < ctx->ops; done += ctx->capacity)       \
+        {                                                                   \
+            for (BenchU32 i = 0; i < ctx->capacity; ++i)                    \
+            {                                                               \
+                N##_push(fifo, &i);                                         \
+            }                                                               \
+            while (!N##_isEmpty(fifo))                                      \
+            {                                                               \
+                sum += *N##_getFirst(fifo);                                 \
+                N##_pop(fifo);                                              \
+            }                                                               \
+        }                                                                   \
+        Bench_sink += sum;                                                  \
+    }
+
+PUSH_POP_FN(BenchFifo)
+PUSH_POP_FN(BenchPow2Fifo)
+PUSH_POP_FN(BenchSpscFifo)
+
+#define BULK_FN(N)                                                          \
+    static void N##_bulk(void* arg)                                         \
+    {                                                                       \
+        Ctx* ctx = arg;                                                     \
+        N* fifo = ctx->fifo;                                                \
+        BenchU32 chunk[CHUNK] = {0};                                        \
+        uint64_t sum = 0;                                                   \
+                                                                            \
+        for (size_t done = 0; done < ctx->ops; done += ctx->capacity)       \
+        {                                                                   \
+            while (N##_pushMany(fifo, chunk, CHUNK) == CHUNK)               \
+            {                                                               \
+            }                                                               \
+            while (N##_popMany(fifo, chunk, CHUNK) > 0)                     \
+            {                                                               \
+                sum += chunk[0];                                            \
+            }                                                               \
+        }                                                                   \
+        Bench_sink += sum;                                                  \
+    }
+
+BULK_FN(BenchFifo)
+BULK_FN(BenchPow2Fifo)
+
+static void
+BenchFifo_overwrite(void* arg)
+{
+    Ctx* ctx = arg;
+    BenchFifo* fifo = ctx->fifo;
+
+    for (BenchU32 i = 0; i < ctx->ops; ++i)
+    {
+        BenchFifo_pushOverwrite(fifo, &i);
+    }
+    Bench_sink += BenchFifo_getSize(fifo);
+    BenchFifo_clear(fifo);
+}
+
+void
+Bench_FifoT(void)
+{
+    static const size_t capacities[] = { 16, 1024, 65536 };
+    const size_t ops = 1u << 20;
+
+    for (size_t c = 0; c < sizeof(capacities) / sizeof(capacities[0]); ++c)
+    {
+        size_t capacity = capacities[c];
+        BenchU32* buffer = malloc(capacity * sizeof(BenchU32));
+        BenchFifo fifo;
+        BenchPow2Fifo pow2Fifo;
+        BenchSpscFifo spscFifo;
+        Ctx ctx = { .capacity = capacity, .ops = ops };
+
+        if (buffer == NULL)
+        {
+            abort();
+        }
+
+        BenchFifo_ctor(&fifo, buffer, capacity);
+        ctx.fifo = &fifo;
+        Bench_run("FifoT/push_pop", capacity, 2 * ops, "op",
+                  BenchFifo_pushPop, &ctx);
+        Bench_run("FifoT/pushMany_popMany", capacity, 2 * ops, "op",
+                  BenchFifo_bulk, &ctx);
+        Bench_run("FifoT/pushOverwrite", capacity, ops, "op",
+                  BenchFifo_overwrite, &ctx);
+        BenchFifo_dtor(&fifo);
+
+        BenchPow2Fifo_ctor(&pow2Fifo, buffer, capacity);
+        ctx.fifo = &pow2Fifo;
+        Bench_run("FifoT_POW2/push_pop", capacity, 2 * ops, "op",
+                  BenchPow2Fifo_pushPop, &ctx);
+        Bench_run("FifoT_POW2/pushMany_popMany", capacity, 2 * ops, "op",
+                  BenchPow2Fifo_bulk, &ctx);
+        BenchPow2Fifo_dtor(&pow2Fifo);
+
+        /* single threaded, it measures the cost of the atomics only */
+        BenchSpscFifo_ctor(&spscFifo, buffer, capacity);
+        ctx.fifo = &spscFifo;
+        Bench_run("FifoT_SPSC/push_pop", capacity, 2 * ops, "op",
+                  BenchSpscFifo_pushPop, &ctx);
+        BenchSpscFifo_dtor(&spscFifo);
+
+        free(buffer);
+    }
+}
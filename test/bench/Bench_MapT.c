@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Bench.h"
+#include "lib_utils/MapT.h"
+
+#include <stdlib.h>
+
+MapT_DECLARE(BenchU32, BenchU32, BenchMap);
+MapT_DEFINE(BenchU32, BenchU32, BenchMap)
+
+MapT_DECLARE_HASHED(BenchU32, BenchU32, BenchHashedMap);
+MapT_DEFINE_HASHED(BenchU32, BenchU32, BenchHashedMap)
+
+MapT_DECLARE_SORTED(BenchU32, BenchU32, BenchSortedMap);
+MapT_DEFINE_SORTED(BenchU32, BenchU32, BenchSortedMap)
+
+MapT_DECLARE_SOA(BenchU32, BenchU32, BenchSoaMap);
+MapT_DEFINE_SOA(BenchU32, BenchU32, BenchSoaMap)
+
+MapT_DECLARE_SOA(BenchU32, BenchU32, BenchIntKeyMap);
+MapT_DEFINE_SOA_INTKEY(BenchU32, BenchU32, BenchIntKeyMap)
+
+/* the linear flavours take O(N^2) to build, larger sizes are skipped */
+#define LINEAR_MAX_N    16384
+#define LOOKUPS         (1u << 20)
+
+/* odd keys in ascending order, the sorted flavour appends in O(1) */
+#define KEY(i__)        ((BenchU32) (2 * (i__) + 1))
+
+typedef struct
+{
+    BenchU32 const* lookups;
+    size_t          ops;
+    void*           map;
+    size_t          n;
+}
+Ctx;
+
+#define MAP_FNS(N)                                                          \
+    static void N##_build(N* map, size_t n)                                 \
+    {                                                                       \
+        if (!N##_ctor(map, 16))                                             \
+        {                                                                   \
+            abort();                                                        \
+        }                                                                   \
+        for (size_t i = 0; i < n; ++i)                                      \
+        {                                                                   \
+            BenchU32 key = KEY(i);                                          \
+            BenchU32 value = (BenchU32) i;                                  \
+            N##_insert(map, &key, &value);                                  \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    static void N##_lookup(void* arg)                                       \
+    {                                                                       \
+        Ctx* ctx = arg;                                                     \
+        uint64_t sum = 0;                                                   \
+                                                                            \
+        for (size_t i = 0; i < ctx->ops; ++i)                               \
+        {                                                                   \
+            sum += N##_getIndexOf(ctx->map, &ctx->lookups[i]);              \
+        }                                                                   \
+        Bench_sink += sum;                                                  \
+    }                                                                       \
+                                                                            \
+    static void N##_insert_(void* arg)                                      \
+    {                                                                       \
+        Ctx* ctx = arg;                                                     \
+                                                                            \
+        for (size_t done = 0; done < ctx->ops; done += ctx->n)              \
+        {                                                                   \
+            N map;                                                          \
+            N##_build(&map, ctx->n);                                        \
+            Bench_sink += N##_getSize(&map);                                \
+            N##_dtor(&map);                                                 \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+    static void N##_bench(char const* name, char const* insertName,         \
+                          Ctx* ctx)                                         \
+    {                                                                       \
+        if (Bench_isSelected(name))                                         \
+        {                                                                   \
+            N map;                                                          \
+            N##_build(&map, ctx->n);                                        \
+            ctx->map = &map;                                                \
+            Bench_run(name, ctx->n, ctx->ops, "op", N##_lookup, ctx);       \
+            N##_dtor(&map);                                                 \
+        }                                                                   \
+        Bench_run(insertName, ctx->n, ctx->ops, "op", N##_insert_, ctx);    \
+    }
+
+MAP_FNS(BenchMap)
+MAP_FNS(BenchHashedMap)
+MAP_FNS(BenchSortedMap)
+MAP_FNS(BenchSoaMap)
+MAP_FNS(BenchIntKeyMap)
+
+void
+Bench_MapT(void)
+{
+    static const size_t sizes[] = { 16, 64, 256, 1024, 4096, 16384, 100000 };
+    BenchU32* lookups = malloc(LOOKUPS * sizeof(BenchU32));
+    uint64_t seed = 0x2545f4914f6cdd1dull;
+
+    if (lookups == NULL)
+    {
+        abort();
+    }
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        size_t n = sizes[s];
+        Ctx ctx = { .lookups = lookups, .n = n };
+
+        /* hits only, in a random order */
+        for (size_t i = 0; i < LOOKUPS; ++i)
+        {
+            lookups[i] = KEY(Bench_random(&seed) % n);
+        }
+
+        /* at least as many operations as keys, for the insert benchmarks */
+        ctx.ops = (LOOKUPS / n) * n;
+        BenchHashedMap_bench("MapT_HASHED/getIndexOf", "MapT_HASHED/insert",
+                             &ctx);
+        BenchSortedMap_bench("MapT_SORTED/getIndexOf", "MapT_SORTED/insert",
+                             &ctx);
+
+        if (n > LINEAR_MAX_N)
+        {
+            continue;
+        }
+        /* keep the quadratic cost of the linear search bounded */
+        ctx.ops = (LOOKUPS * 16) / n;
+        ctx.ops = (ctx.ops > LOOKUPS) ? LOOKUPS : ctx.ops;
+        ctx.ops = (ctx.ops < n) ? n : (ctx.ops / n) * n;
+        BenchMap_bench("MapT/getIndexOf", "MapT/insert", &ctx);
+        BenchSoaMap_bench("MapT_SOA/getIndexOf", "MapT_SOA/insert", &ctx);
+        BenchIntKeyMap_bench("MapT_SOA_INTKEY/getIndexOf",
+                             "MapT_SOA_INTKEY/insert", &ctx);
+    }
+    free(lookups);
+}
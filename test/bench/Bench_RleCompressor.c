@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Bench.h"
+#include "lib_utils/RleCompressor.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INPUT_SIZE  (256u * 1024u)
+
+typedef OS_Error_t (*Codec)(size_t, uint8_t const*, size_t, size_t*,
+                            uint8_t**);
+
+typedef struct
+{
+    Codec           codec;
+    uint8_t const*  in;
+    size_t          inLen;
+    uint8_t*        out;
+    size_t          outSize;
+}
+Ctx;
+
+static void
+run(void* arg)
+{
+    Ctx* ctx = arg;
+    uint8_t* out = ctx->out;
+    size_t len = 0;
+
+    if (ctx->codec(ctx->inLen, ctx->in, ctx->outSize, &len, &out)
+        != OS_SUCCESS)
+    {
+        abort();
+    }
+    Bench_sink += len;
+}
+
+/* entropy profiles: a single run, runs of 1 to 32 bytes, random bytes */
+static void
+fill(uint8_t* buf, size_t len, int profile)
+{
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    size_t i = 0;
+
+    while (i < len)
+    {
+        uint64_t r = Bench_random(&seed);
+        size_t run = (profile == 0) ? len
+                   : (profile == 1) ? 1 + (r >> 32) % 32
+                   : 1;
+        uint8_t value = (profile == 0) ? 0 : (uint8_t) r;
+
+        for (; run > 0 && i < len; --run)
+        {
+            buf[i++] = value;
+        }
+    }
+}
+
+void
+Bench_RleCompressor(void)
+{
+    static char const* const profiles[] = { "constant", "runs", "random" };
+    /* the worst case of the encoding doubles the input, plus the header */
+    size_t bufSize = 2 * INPUT_SIZE + 64;
+    uint8_t* in = malloc(INPUT_SIZE);
+    uint8_t* packed = malloc(bufSize);
+    uint8_t* out = malloc(bufSize);
+
+    if (in == NULL || packed == NULL || out == NULL)
+    {
+        abort();
+    }
+    for (int p = 0; p < 3; ++p)
+    {
+        char name[64];
+        uint8_t* dst = packed;
+        size_t packedLen = 0;
+
+        fill(in, INPUT_SIZE, p);
+        if (RleCompressor_compress(INPUT_SIZE, in, bufSize, &packedLen, &dst)
+            != OS_SUCCESS)
+        {
+            abort();
+        }
+
+        Ctx ctx = { RleCompressor_compress, in, INPUT_SIZE, out, bufSize };
+        snprintf(name, sizeof(name), "RleCompressor/compress/%s",
+                 profiles[p]);
+        Bench_run(name, INPUT_SIZE, INPUT_SIZE, "byte", run, &ctx);
+
+        ctx.codec = RleCompressor_compressV2;
+        snprintf(name, sizeof(name), "RleCompressor/compressV2/%s",
+                 profiles[p]);
+        Bench_run(name, INPUT_SIZE, INPUT_SIZE, "byte", run, &ctx);
+
+        ctx = (Ctx) { RleCompressor_decompress, packed, packedLen, out,
+                      bufSize };
+        snprintf(name, sizeof(name), "RleCompressor/decompress/%s",
+                 profiles[p]);
+        Bench_run(name, INPUT_SIZE, INPUT_SIZE, "byte", run, &ctx);
+    }
+    free(out);
+    free(packed);
+    free(in);
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Bench.h"
+#include "lib_utils/VectorT.h"
+
+#include <stdlib.h>
+
+VectorT_DECLARE(BenchU32, BenchVector, size_t);
+VectorT_DEFINE_TRIVIAL(BenchU32, BenchVector, size_t)
+
+typedef struct
+{
+    size_t  n;
+    size_t  reps;
+    bool    reserve;
+}
+Ctx;
+
+/* builds a vector of n elements from a capacity of one, reps times */
+static void
+pushBack(void* arg)
+{
+    Ctx* ctx = arg;
+
+    for (size_t r = 0; r < ctx->reps; ++r)
+    {
+        BenchVector v;
+
+        if (!BenchVector_ctor(&v, 1) ||
+            (ctx->reserve && !BenchVector_reserve(&v, ctx->n)))
+        {
+            abort();
+        }
+        for (BenchU32 i = 0; i < ctx->n; ++i)
+        {
+            BenchVector_pushBack(&v, i);
+        }
+        Bench_sink += BenchVector_getSize(&v);
+        BenchVector_dtor(&v);
+    }
+}
+
+static bool
+sum(void* context, BenchU32 const* element, size_t pos)
+{
+    (void) pos;
+    *(uint64_t*) context += *element;
+    return true;
+}
+
+typedef struct
+{
+    BenchVector vector;
+    size_t      reps;
+}
+ApplyCtx;
+
+static void
+constApply(void* arg)
+{
+    ApplyCtx* ctx = arg;
+    uint64_t total = 0;
+
+    for (size_t r = 0; r < ctx->reps; ++r)
+    {
+        BenchVector_constApply(&ctx->vector, sum, &total);
+    }
+    Bench_sink += total;
+}
+
+void
+Bench_VectorT(void)
+{
+    static const size_t sizes[] = { 16, 1024, 65536, 1u << 20 };
+    const size_t ops = 1u << 22;
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+    {
+        size_t n = sizes[s];
+        Ctx ctx = { .n = n, .reps = ops / n, .reserve = false };
+
+        Bench_run("VectorT/pushBack_growth", n, n * ctx.reps, "op",
+                  pushBack, &ctx);
+        ctx.reserve = true;
+        Bench_run("VectorT/pushBack_reserved", n, n * ctx.reps, "op",
+                  pushBack, &ctx);
+
+        if (Bench_isSelected("VectorT/constApply"))
+        {
+            ApplyCtx applyCtx = { .reps = ops / n };
+
+            if (!BenchVector_ctor(&applyCtx.vector, n))
+            {
+                abort();
+            }
+            for (BenchU32 i = 0; i < n; ++i)
+            {
+                BenchVector_pushBack(&applyCtx.vector, i);
+            }
+            Bench_run("VectorT/constApply", n, n * applyCtx.reps, "op",
+                      constApply, &applyCtx);
+            BenchVector_dtor(&applyCtx.vector);
+        }
+    }
+}
@@ -120,3 +120,160 @@ TEST(Test_BitConverter, toUint)
     value64 = BitConverter_getUint64(array64);
     ASSERT_TRUE(value64 == isBE ? 0x1234567890123456 : 0x5634129078563412);
 }
+
+TEST(Test_BitConverter, toUint_high_bytes)
+{
+    // Bytes with the highest bit set must not be sign extended
+    uint8_t array16[2] = { 0x89, 0xab };
+    uint8_t array32[4] = { 0x89, 0xab, 0xcd, 0xef };
+    uint8_t array64[8] = { 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98 };
+
+    ASSERT_EQ(0x89ab, BitConverter_getUint16BE(array16));
+    ASSERT_EQ(0xab89, BitConverter_getUint16LE(array16));
+    ASSERT_EQ(0x89abcdefu, BitConverter_getUint32BE(array32));
+    ASSERT_EQ(0xefcdab89u, BitConverter_getUint32LE(array32));
+    ASSERT_EQ(0x89abcdeffedcba98ull, BitConverter_getUint64BE(array64));
+    ASSERT_EQ(0x98badcfeefcdab89ull, BitConverter_getUint64LE(array64));
+}
+
+TEST(Test_BitConverter, arrays)
+{
+    const uint16_t values16[] = { 0x1234, 0x89ab, 0x0001 };
+    const uint32_t values32[] = { 0x12345678, 0x89abcdef, 0x00000001 };
+    const uint64_t values64[] = { 0x1234567890123456, 0x89abcdeffedcba98 };
+    uint16_t out16[3];
+    uint32_t out32[3];
+    uint64_t out64[2];
+    // One more byte, to test an unaligned buffer
+    uint8_t bytes[sizeof(values64) + 1];
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        BitConverter_putUint32ArrayBE(values32, bytes + 1, 3);
+        ASSERT_EQ(values32[i], BitConverter_getUint32BE(bytes + 1 + i * 4));
+        BitConverter_putUint32ArrayLE(values32, bytes + 1, 3);
+        ASSERT_EQ(values32[i], BitConverter_getUint32LE(bytes + 1 + i * 4));
+        BitConverter_putUint16ArrayBE(values16, bytes + 1, 3);
+        ASSERT_EQ(values16[i], BitConverter_getUint16BE(bytes + 1 + i * 2));
+        BitConverter_putUint16ArrayLE(values16, bytes + 1, 3);
+        ASSERT_EQ(values16[i], BitConverter_getUint16LE(bytes + 1 + i * 2));
+    }
+    for (size_t i = 0; i < 2; i++)
+    {
+        BitConverter_putUint64ArrayBE(values64, bytes, 2);
+        ASSERT_EQ(values64[i], BitConverter_getUint64BE(bytes + i * 8));
+        BitConverter_putUint64ArrayLE(values64, bytes, 2);
+        ASSERT_EQ(values64[i], BitConverter_getUint64LE(bytes + i * 8));
+    }
+
+    BitConverter_putUint32ArrayBE(values32, bytes + 1, 3);
+    BitConverter_getUint32ArrayBE(bytes + 1, out32, 3);
+    ASSERT_EQ(0, memcmp(out32, values32, sizeof(values32)));
+    BitConverter_putUint32ArrayLE(values32, bytes + 1, 3);
+    BitConverter_getUint32ArrayLE(bytes + 1, out32, 3);
+    ASSERT_EQ(0, memcmp(out32, values32, sizeof(values32)));
+    BitConverter_putUint16ArrayBE(values16, bytes + 1, 3);
+    BitConverter_getUint16ArrayBE(bytes + 1, out16, 3);
+    ASSERT_EQ(0, memcmp(out16, values16, sizeof(values16)));
+    BitConverter_putUint64ArrayLE(values64, bytes, 2);
+    BitConverter_getUint64ArrayLE(bytes, out64, 2);
+    ASSERT_EQ(0, memcmp(out64, values64, sizeof(values64)));
+
+    // In place conversion
+    memcpy(out32, values32, sizeof(values32));
+    BitConverter_putUint32ArrayBE(out32, out32, 3);
+    BitConverter_getUint32ArrayBE(out32, out32, 3);
+    ASSERT_EQ(0, memcmp(out32, values32, sizeof(values32)));
+}
+
+TEST(Test_BitConverter, inline_and_exported)
+{
+    // The parentheses suppress the mapping to the inline functions
+    uint8_t inl[8], exp[8];
+
+    BitConverter_putUint64BE(0x0123456789abcdef, inl);
+    (BitConverter_putUint64BE)(0x0123456789abcdef, exp);
+    ASSERT_EQ(0, memcmp(inl, exp, sizeof(inl)));
+    ASSERT_EQ(0x0123456789abcdefull, (BitConverter_getUint64BE)(inl));
+    BitConverter_putUint32LE(0x89abcdef, inl);
+    (BitConverter_putUint32LE)(0x89abcdef, exp);
+    ASSERT_EQ(0, memcmp(inl, exp, 4));
+    ASSERT_EQ(0x89abcdefu, (BitConverter_getUint32LE)(inl));
+    BitConverter_putUint16BE(0x89ab, inl);
+    (BitConverter_putUint16BE)(0x89ab, exp);
+    ASSERT_EQ(0, memcmp(inl, exp, 2));
+    ASSERT_EQ(0x89ab, (BitConverter_getUint16BE)(inl));
+    ASSERT_EQ(BitConverter_IS_BIG_ENDIAN(),
+              (*(uint16_t *)"\0\xff" < 0x100));
+}
+
+TEST(Test_BitConverter, varint)
+{
+    const uint64_t values64[] =
+    {
+        0, 1, 0x7f, 0x80, 0x3fff, 0x4000, 0xffffffff, 0x00ffffffffffffff,
+        0x0100000000000000, 0xffffffffffffffff
+    };
+    const size_t sizes64[] = { 1, 1, 1, 2, 2, 3, 5, 8, 9, 9 };
+    const uint32_t values32[] = { 0, 0x7f, 0x80, 0x0fffffff, 0xffffffff };
+    uint8_t bytes[sizeof(values64) / sizeof(values64[0])
+                  * BitConverter_VARUINT64_MAX_SIZE];
+    uint64_t out64[sizeof(values64) / sizeof(values64[0])];
+    uint32_t out32[sizeof(values32) / sizeof(values32[0])], value32;
+    int64_t svalue64;
+    int32_t svalue32;
+    size_t len, n;
+
+    // Single values, the size is given by the first byte
+    for (size_t i = 0; i < sizeof(values64) / sizeof(values64[0]); i++)
+    {
+        ASSERT_EQ(sizes64[i], BitConverter_getVarUint64Size(values64[i]));
+        ASSERT_EQ(sizes64[i], BitConverter_putVarUint64(values64[i], bytes));
+        ASSERT_EQ(0u, BitConverter_getVarUint64(bytes, sizes64[i] - 1,
+                                                 &out64[0]));
+        ASSERT_EQ(sizes64[i], BitConverter_getVarUint64(bytes, sizeof(bytes),
+                                                         &out64[0]));
+        ASSERT_EQ(values64[i], out64[0]);
+    }
+    BitConverter_putVarUint64(0x80, bytes);
+    ASSERT_EQ(0x80, bytes[0]);
+    ASSERT_EQ(0x80, bytes[1]);
+
+    // Whole arrays
+    len = BitConverter_putVarUint64Array(values64, 10, bytes);
+    ASSERT_EQ(len, (size_t) 1 + 1 + 1 + 2 + 2 + 3 + 5 + 8 + 9 + 9);
+    ASSERT_EQ(0u, BitConverter_getVarUint64Array(bytes, len - 1, out64, 10));
+    ASSERT_EQ(len, BitConverter_getVarUint64Array(bytes, len, out64, 10));
+    ASSERT_EQ(0, memcmp(out64, values64, sizeof(values64)));
+
+    len = BitConverter_putVarUint32Array(values32, 5, bytes);
+    ASSERT_EQ(len, (size_t) 1 + 1 + 2 + 4 + 5);
+    ASSERT_EQ(len, BitConverter_getVarUint32Array(bytes, len, out32, 5));
+    ASSERT_EQ(0, memcmp(out32, values32, sizeof(values32)));
+
+    // A uint32_t can not hold a value of more than 32 bits
+    n = BitConverter_putVarUint64(0x100000000, bytes);
+    ASSERT_EQ(0u, BitConverter_getVarUint32(bytes, n, &value32));
+
+    // Signed values are zigzag encoded
+    ASSERT_EQ(0u, BitConverter_zigzagEncode32(0));
+    ASSERT_EQ(1u, BitConverter_zigzagEncode32(-1));
+    ASSERT_EQ(2u, BitConverter_zigzagEncode32(1));
+    ASSERT_EQ(0xffffffffu, BitConverter_zigzagEncode32(INT32_MIN));
+    ASSERT_EQ(INT32_MIN, BitConverter_zigzagDecode32(0xffffffffu));
+    ASSERT_EQ(1u, BitConverter_putVarInt32(-64, bytes));
+    ASSERT_EQ(1u, BitConverter_getVarInt32(bytes, 1, &svalue32));
+    ASSERT_EQ(-64, svalue32);
+    ASSERT_EQ(9u, BitConverter_putVarInt64(INT64_MIN, bytes));
+    ASSERT_EQ(9u, BitConverter_getVarInt64(bytes, 9, &svalue64));
+    ASSERT_EQ(INT64_MIN, svalue64);
+
+    // A truncated signed value is not decoded, the output is left unchanged
+    ASSERT_EQ(0u, BitConverter_getVarInt64(bytes, 8, &svalue64));
+    ASSERT_EQ(INT64_MIN, svalue64);
+    ASSERT_EQ(0u, BitConverter_getVarInt64(bytes, 0, &svalue64));
+    ASSERT_EQ(INT64_MIN, svalue64);
+    ASSERT_EQ(3u, BitConverter_putVarInt32(100000, bytes));
+    ASSERT_EQ(0u, BitConverter_getVarInt32(bytes, 2, &svalue32));
+    ASSERT_EQ(-64, svalue32);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "lib_utils/Bitmap.h"
+#include <stdint.h>
+#include <limits.h>
+}
+
+class Test_Bitmap : public testing::Test
+{
+    protected:
+};
+
+TEST(Test_Bitmap, mask_of_bit)
+{
+    Bitmap64 bitmap = 0;
+
+    Bitmap_SET_BIT(bitmap, 40);
+    ASSERT_EQ(0x0000010000000000ull, bitmap);
+    ASSERT_TRUE(Bitmap_GET_BIT(bitmap, 40));
+    ASSERT_FALSE(Bitmap_GET_BIT(bitmap, 8));
+    Bitmap_CLR_BIT(bitmap, 40);
+    ASSERT_TRUE(Bitmap_IS_EMPTY(bitmap));
+}
+
+TEST(Test_Bitmap, bitmapN)
+{
+    uint64_t words[BitmapN_WORDS(200)];
+    BitmapN bitmap;
+
+    ASSERT_EQ(4u, sizeof(words) / sizeof(words[0]));
+    ASSERT_FALSE(BitmapN_ctor(&bitmap, NULL, 200));
+    ASSERT_FALSE(BitmapN_ctor(&bitmap, words, 0));
+    memset(words, 0xff, sizeof(words));
+    ASSERT_TRUE(BitmapN_ctor(&bitmap, words, 200));
+    ASSERT_EQ(200u, BitmapN_getSize(&bitmap));
+    ASSERT_EQ(0u, BitmapN_countSet(&bitmap));
+    ASSERT_EQ(BitmapN_NOT_FOUND, BitmapN_findFirstSet(&bitmap, 0));
+    ASSERT_EQ(0u, BitmapN_findFirstClear(&bitmap, 0));
+    ASSERT_EQ(199u, BitmapN_findFirstClear(&bitmap, 199));
+    ASSERT_EQ(BitmapN_NOT_FOUND, BitmapN_findFirstClear(&bitmap, 200));
+
+    BitmapN_setBit(&bitmap, 130);
+    ASSERT_TRUE(BitmapN_getBit(&bitmap, 130));
+    ASSERT_FALSE(BitmapN_getBit(&bitmap, 129));
+    ASSERT_EQ(130u, BitmapN_findFirstSet(&bitmap, 0));
+    ASSERT_EQ(130u, BitmapN_findFirstSet(&bitmap, 130));
+    ASSERT_EQ(BitmapN_NOT_FOUND, BitmapN_findFirstSet(&bitmap, 131));
+    BitmapN_clearBit(&bitmap, 130);
+    ASSERT_EQ(0u, BitmapN_countSet(&bitmap));
+
+    // A range over several words
+    BitmapN_setRange(&bitmap, 3, 190);
+    ASSERT_EQ(190u, BitmapN_countSet(&bitmap));
+    ASSERT_EQ(3u, BitmapN_findFirstSet(&bitmap, 0));
+    ASSERT_EQ(0u, BitmapN_findFirstClear(&bitmap, 0));
+    ASSERT_EQ(193u, BitmapN_findFirstClear(&bitmap, 3));
+    BitmapN_clearRange(&bitmap, 64, 64);
+    ASSERT_EQ(126u, BitmapN_countSet(&bitmap));
+    ASSERT_EQ(64u, BitmapN_findFirstClear(&bitmap, 3));
+    ASSERT_EQ(128u, BitmapN_findFirstSet(&bitmap, 64));
+    ASSERT_TRUE(BitmapN_getBit(&bitmap, 63));
+    ASSERT_FALSE(BitmapN_getBit(&bitmap, 127));
+
+    // All set, the bits after the last one are not found
+    BitmapN_setRange(&bitmap, 0, 200);
+    ASSERT_EQ(200u, BitmapN_countSet(&bitmap));
+    ASSERT_EQ(BitmapN_NOT_FOUND, BitmapN_findFirstClear(&bitmap, 0));
+    BitmapN_clearRange(&bitmap, 199, 1);
+    ASSERT_EQ(199u, BitmapN_findFirstClear(&bitmap, 0));
+    BitmapN_clearRange(&bitmap, 0, 0);
+    ASSERT_EQ(199u, BitmapN_countSet(&bitmap));
+    BitmapN_dtor(&bitmap);
+}
+
+TEST(Test_Bitmap, bitmapN_atomic)
+{
+    uint64_t words[BitmapN_WORDS(70)];
+    BitmapN bitmap;
+
+    ASSERT_TRUE(BitmapN_ctor(&bitmap, words, 70));
+    ASSERT_FALSE(BitmapN_testAndSet(&bitmap, 65));
+    ASSERT_TRUE(BitmapN_testAndSet(&bitmap, 65));
+    ASSERT_TRUE(BitmapN_getBit(&bitmap, 65));
+    ASSERT_TRUE(BitmapN_testAndClear(&bitmap, 65));
+    ASSERT_FALSE(BitmapN_testAndClear(&bitmap, 65));
+    ASSERT_EQ(0u, BitmapN_countSet(&bitmap));
+
+    // Claim all the bits, starting in the middle of the first word
+    BitmapN_setRange(&bitmap, 0, 3);
+    ASSERT_EQ(3u, BitmapN_claimFirstClear(&bitmap, 0));
+    ASSERT_EQ(10u, BitmapN_claimFirstClear(&bitmap, 10));
+    for (size_t i = 4; i < 70; i++)
+    {
+        if (i != 10)
+        {
+            ASSERT_EQ(i, BitmapN_claimFirstClear(&bitmap, 0));
+        }
+    }
+    // The bits after the last one are never claimed
+    ASSERT_EQ(BitmapN_NOT_FOUND, BitmapN_claimFirstClear(&bitmap, 0));
+    ASSERT_EQ(70u, BitmapN_countSet(&bitmap));
+    ASSERT_TRUE(BitmapN_testAndClear(&bitmap, 42));
+    ASSERT_EQ(42u, BitmapN_claimFirstClear(&bitmap, 0));
+}
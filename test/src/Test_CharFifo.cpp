@@ -7,11 +7,15 @@
  */
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <thread>
+#include <algorithm>
+#include <vector>
 
 extern "C"
 {
 #include "lib_utils/CharFifo.h"
+#include "Test_Types.h"
 }
 
 constexpr unsigned int kFifoSize = 10;
@@ -216,3 +220,758 @@ TEST_F(Test_CharFifo, tail_chases_head_concurrently)
     EXPECT_TRUE(CharFifo_isEmpty(&cf))
         << CharFifo_getSize(&cf);
 }
+
+// Once the fifo is full, overwriting pushes drop the oldest elements
+TEST_F(Test_CharFifo_extendedSetUp, push_overwrite)
+{
+    char c = (char) kFifoSize;
+    ASSERT_TRUE(CharFifo_pushOverwrite(&cf, &c));
+    ASSERT_EQ(CharFifo_getSize(&cf), kFifoSize);
+    ASSERT_EQ(*CharFifo_getFirst(&cf), 1);
+
+    const char data[] = { 20, 21, 22 };
+    ASSERT_EQ(CharFifo_pushManyOverwrite(&cf, data, sizeof(data)), 3);
+    ASSERT_EQ(CharFifo_getSize(&cf), kFifoSize);
+    for (unsigned int i = 4; i <= kFifoSize; i++)
+    {
+        ASSERT_EQ(CharFifo_getAndPop(&cf), (char) i);
+    }
+    ASSERT_EQ(0, memcmp(CharFifo_getFirst(&cf), data, 1));
+
+    // Nothing is dropped while there is room
+    ASSERT_FALSE(CharFifo_pushOverwrite(&cf, &c));
+    ASSERT_EQ(CharFifo_pushManyOverwrite(&cf, data, sizeof(data)), 0);
+    ASSERT_EQ(CharFifo_getSize(&cf), 7);
+}
+
+// Pushing more than the capacity keeps only the last items
+TEST_F(Test_CharFifo, push_many_overwrite_more_than_capacity)
+{
+    const char data[] = "0123456789abcdef";
+    char out[kFifoSize];
+
+    ASSERT_EQ(CharFifo_pushMany(&cf, data, 3), 3);
+    ASSERT_EQ(CharFifo_pushManyOverwrite(&cf, data, 16), 3 + 16 - kFifoSize);
+    ASSERT_TRUE(CharFifo_isFull(&cf));
+    ASSERT_EQ(CharFifo_popMany(&cf, out, sizeof(out)), kFifoSize);
+    ASSERT_EQ(0, memcmp(out, &data[16 - kFifoSize], kFifoSize));
+}
+
+// Drop elements in blocks, wrapping around the end of the buffer
+TEST_F(Test_CharFifo_extendedSetUp, drop_first)
+{
+    ASSERT_EQ(CharFifo_dropFirst(&cf, 0), 0);
+    ASSERT_EQ(CharFifo_dropFirst(&cf, 6), 6);
+    ASSERT_EQ(CharFifo_getSize(&cf), kFifoSize - 6);
+    ASSERT_EQ(*CharFifo_getFirst(&cf), 6);
+
+    const char data[] = { 10, 11, 12, 13, 14 };
+    ASSERT_EQ(CharFifo_pushMany(&cf, data, sizeof(data)), sizeof(data));
+    ASSERT_EQ(CharFifo_dropFirst(&cf, 7), 7);
+    ASSERT_EQ(*CharFifo_getFirst(&cf), 13);
+    ASSERT_EQ(CharFifo_dropFirst(&cf, 100), 2);
+    ASSERT_TRUE(CharFifo_isEmpty(&cf));
+
+    ASSERT_EQ(CharFifo_pushMany(&cf, data, sizeof(data)), sizeof(data));
+    CharFifo_clear(&cf);
+    ASSERT_TRUE(CharFifo_isEmpty(&cf));
+    ASSERT_TRUE(CharFifo_getFirst(&cf) == NULL);
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_CharSpscFifo : public testing::Test
+{
+    protected:
+        CharSpscFifo cf;
+        char fifoBuff[kFifoSize];
+        void SetUp()
+        {
+            ASSERT_TRUE(CharSpscFifo_ctor(&cf, fifoBuff, kFifoSize));
+        }
+
+        void TearDown()
+        {
+            CharSpscFifo_dtor(&cf);
+        }
+};
+
+// Verify the CharSpscFifo constructor
+TEST_F(Test_CharSpscFifo, construction)
+{
+    ASSERT_TRUE(CharSpscFifo_isEmpty(&cf));
+    ASSERT_FALSE(CharSpscFifo_isFull(&cf));
+    ASSERT_EQ(CharSpscFifo_getSize(&cf), 0);
+    ASSERT_TRUE(CharSpscFifo_getFirst(&cf) == NULL);
+    ASSERT_EQ(CharSpscFifo_getCapacity(&cf), kFifoSize);
+}
+
+// Fill and drain the fifo several times, so that the indexes wrap around
+TEST_F(Test_CharSpscFifo, push_pop_wrap_around)
+{
+    for (unsigned int round = 0; round < 3; round++)
+    {
+        for (unsigned int i = 0; i < kFifoSize; i++)
+        {
+            char c = (char) (round + i);
+            ASSERT_TRUE(CharSpscFifo_push(&cf, &c));
+            ASSERT_EQ(CharSpscFifo_getSize(&cf), i + 1);
+        }
+        ASSERT_TRUE(CharSpscFifo_isFull(&cf));
+        char c = 0;
+        ASSERT_FALSE(CharSpscFifo_push(&cf, &c));
+
+        for (unsigned int i = 0; i < kFifoSize; i++)
+        {
+            ASSERT_EQ(CharSpscFifo_getAndPop(&cf), (char) (round + i));
+        }
+        ASSERT_TRUE(CharSpscFifo_isEmpty(&cf));
+        ASSERT_FALSE(CharSpscFifo_pop(&cf));
+
+        // Shift the start position for the next round
+        ASSERT_TRUE(CharSpscFifo_push(&cf, &c));
+        ASSERT_TRUE(CharSpscFifo_pop(&cf));
+    }
+}
+
+TEST_F(Test_CharSpscFifo, producer_consumer_concurrently)
+{
+    // Big enough to cause many rounds of the ring buffer while producer and
+    // consumer run without any lock.
+    const size_t iterations = 1 << 20;
+
+    std::thread producer
+    {[this, iterations]
+        {
+            for(size_t i = 0; i < iterations; i++)
+            {
+                while (!CharSpscFifo_push(&cf, (const char*) &i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    };
+
+    std::thread consumer
+    {[this, iterations]
+        {
+            for(size_t i = 0; i < iterations; i++)
+            {
+                while (CharSpscFifo_isEmpty(&cf))
+                {
+                    std::this_thread::yield();
+                }
+                ASSERT_EQ((char)i, CharSpscFifo_getAndPop(&cf));
+            }
+        }
+    };
+
+    producer.join();
+    consumer.join();
+
+    EXPECT_TRUE(CharSpscFifo_isEmpty(&cf))
+        << CharSpscFifo_getSize(&cf);
+}
+
+/*----------------------------------------------------------------------------*/
+// Push and pop blocks of data, wrapping around the end of the buffer
+TEST_F(Test_CharFifo, push_pop_many)
+{
+    const char data[] = "0123456789abcdef";
+    char out[sizeof(data)];
+
+    // Only as much as the capacity can be pushed
+    ASSERT_EQ(CharFifo_pushMany(&cf, data, sizeof(data)), kFifoSize);
+    ASSERT_TRUE(CharFifo_isFull(&cf));
+    ASSERT_EQ(CharFifo_popMany(&cf, out, 4), 4);
+    ASSERT_EQ(0, memcmp(out, data, 4));
+
+    // This wraps around the end of the buffer
+    ASSERT_EQ(CharFifo_pushMany(&cf, &data[10], 4), 4);
+    ASSERT_TRUE(CharFifo_isFull(&cf));
+
+    // Only as much as is in the fifo can be popped
+    ASSERT_EQ(CharFifo_popMany(&cf, out, sizeof(out)), kFifoSize);
+    ASSERT_EQ(0, memcmp(out, &data[4], kFifoSize));
+    ASSERT_TRUE(CharFifo_isEmpty(&cf));
+    ASSERT_EQ(CharFifo_popMany(&cf, out, sizeof(out)), 0);
+}
+
+// Peek at the content of the fifo without copying it
+TEST_F(Test_CharFifo, peek_spans)
+{
+    const char data[] = "0123456789";
+    CharFifo_Span spans[2];
+    char out[4];
+
+    ASSERT_EQ(CharFifo_peekSpans(&cf, spans), 0);
+    ASSERT_EQ(spans[0].len, 0);
+    ASSERT_EQ(spans[1].len, 0);
+
+    ASSERT_EQ(CharFifo_pushMany(&cf, data, 6), 6);
+    ASSERT_EQ(CharFifo_peekSpans(&cf, spans), 1);
+    ASSERT_EQ(spans[0].ptr, CharFifo_getFirst(&cf));
+    ASSERT_EQ(spans[0].len, 6);
+    ASSERT_EQ(0, memcmp(spans[0].ptr, data, 6));
+
+    ASSERT_EQ(CharFifo_popMany(&cf, out, 4), 4);
+    ASSERT_EQ(CharFifo_pushMany(&cf, &data[6], 4), 4);
+    ASSERT_EQ(CharFifo_peekSpans(&cf, spans), 1);
+    ASSERT_EQ(spans[0].len, 6);
+    ASSERT_EQ(0, memcmp(spans[0].ptr, &data[4], 6));
+
+    ASSERT_EQ(CharFifo_pushMany(&cf, data, 3), 3);
+    ASSERT_EQ(CharFifo_peekSpans(&cf, spans), 2);
+    ASSERT_EQ(spans[1].ptr, fifoBuff);
+    ASSERT_EQ(spans[1].len, 3);
+    ASSERT_EQ(0, memcmp(spans[1].ptr, data, 3));
+}
+
+TEST_F(Test_CharSpscFifo, push_pop_many_concurrently)
+{
+    const size_t iterations = 1 << 20;
+
+    std::thread producer
+    {[this, iterations]
+        {
+            char block[7];
+            size_t i = 0;
+            while (i < iterations)
+            {
+                size_t n = std::min(sizeof(block), iterations - i);
+                for (size_t k = 0; k < n; k++)
+                {
+                    block[k] = (char) (i + k);
+                }
+                size_t done = 0;
+                while (done < n)
+                {
+                    done += CharSpscFifo_pushMany(&cf, &block[done], n - done);
+                    std::this_thread::yield();
+                }
+                i += n;
+            }
+        }
+    };
+
+    std::thread consumer
+    {[this, iterations]
+        {
+            char block[5];
+            size_t i = 0;
+            while (i < iterations)
+            {
+                size_t n = CharSpscFifo_popMany(&cf, block, sizeof(block));
+                for (size_t k = 0; k < n; k++)
+                {
+                    ASSERT_EQ((char) (i + k), block[k]);
+                }
+                if (n == 0)
+                {
+                    std::this_thread::yield();
+                }
+                i += n;
+            }
+        }
+    };
+
+    producer.join();
+    consumer.join();
+
+    EXPECT_TRUE(CharSpscFifo_isEmpty(&cf))
+        << CharSpscFifo_getSize(&cf);
+}
+
+/*----------------------------------------------------------------------------*/
+constexpr unsigned int kMpscFifoSize = 16;
+
+class Test_CharMpscFifo : public testing::Test
+{
+    protected:
+        CharMpscFifo cf;
+        // the elements, followed by the sequence numbers of the slots
+        alignas(size_t) char fifoBuff[
+            FifoT_MPSC_SIZE_OF_BUFFER(char, size_t, kMpscFifoSize)];
+        void SetUp()
+        {
+            ASSERT_TRUE(CharMpscFifo_ctor(&cf, fifoBuff, kMpscFifoSize));
+        }
+
+        void TearDown()
+        {
+            CharMpscFifo_dtor(&cf);
+        }
+};
+
+// Verify the CharMpscFifo constructor
+TEST_F(Test_CharMpscFifo, construction)
+{
+    CharMpscFifo other;
+
+    ASSERT_TRUE(CharMpscFifo_isEmpty(&cf));
+    ASSERT_FALSE(CharMpscFifo_isFull(&cf));
+    ASSERT_EQ(CharMpscFifo_getSize(&cf), 0);
+    ASSERT_TRUE(CharMpscFifo_getFirst(&cf) == NULL);
+    ASSERT_EQ(CharMpscFifo_getCapacity(&cf), kMpscFifoSize);
+
+    // The capacity must be a power of two
+    ASSERT_FALSE(CharMpscFifo_ctor(&other, fifoBuff, kFifoSize));
+}
+
+// Fill and drain the fifo several times, so that the indexes wrap around
+TEST_F(Test_CharMpscFifo, push_pop_wrap_around)
+{
+    for (unsigned int round = 0; round < 3; round++)
+    {
+        for (unsigned int i = 0; i < kMpscFifoSize; i++)
+        {
+            char c = (char) (round + i);
+            ASSERT_TRUE(CharMpscFifo_push(&cf, &c));
+            ASSERT_EQ(CharMpscFifo_getSize(&cf), i + 1);
+        }
+        ASSERT_TRUE(CharMpscFifo_isFull(&cf));
+        char c = 0;
+        ASSERT_FALSE(CharMpscFifo_push(&cf, &c));
+
+        for (unsigned int i = 0; i < kMpscFifoSize; i++)
+        {
+            ASSERT_EQ(CharMpscFifo_getAndPop(&cf), (char) (round + i));
+        }
+        ASSERT_TRUE(CharMpscFifo_isEmpty(&cf));
+        ASSERT_FALSE(CharMpscFifo_pop(&cf));
+
+        // Shift the start position for the next round
+        ASSERT_TRUE(CharMpscFifo_push(&cf, &c));
+        ASSERT_TRUE(CharMpscFifo_pop(&cf));
+    }
+}
+
+// Reserved slots are only visible to the consumer once they have been
+// committed, and only after the reservations before them
+TEST_F(Test_CharMpscFifo, reserve_commit)
+{
+    CharMpscFifo_MutSpan first[2];
+    CharMpscFifo_MutSpan second[2];
+    char out[kMpscFifoSize];
+
+    ASSERT_EQ(CharMpscFifo_pushMany(&cf, "0123456789", 10), 10);
+    ASSERT_EQ(CharMpscFifo_popMany(&cf, out, 10), 10);
+
+    // Not enough room, nothing is reserved
+    ASSERT_FALSE(CharMpscFifo_reserve(&cf, kMpscFifoSize + 1, first));
+    ASSERT_TRUE(CharMpscFifo_isEmpty(&cf));
+
+    ASSERT_TRUE(CharMpscFifo_reserve(&cf, 4, first));
+    ASSERT_EQ(first[0].ptr, &fifoBuff[10]);
+    ASSERT_EQ(first[0].len, 4);
+    ASSERT_EQ(first[1].len, 0);
+
+    // This one wraps around the end of the buffer
+    ASSERT_TRUE(CharMpscFifo_reserve(&cf, 5, second));
+    ASSERT_EQ(second[0].ptr, &fifoBuff[14]);
+    ASSERT_EQ(second[0].len, 2);
+    ASSERT_EQ(second[1].ptr, &fifoBuff[0]);
+    ASSERT_EQ(second[1].len, 3);
+    ASSERT_EQ(CharMpscFifo_getSize(&cf), 9);
+
+    // The second one is committed first, it waits behind the first one
+    memcpy(second[0].ptr, "ef", 2);
+    memcpy(second[1].ptr, "ghi", 3);
+    CharMpscFifo_commit(&cf, second);
+    ASSERT_TRUE(CharMpscFifo_getFirst(&cf) == NULL);
+    ASSERT_EQ(CharMpscFifo_popMany(&cf, out, sizeof(out)), 0);
+
+    // Committing the first one makes both visible
+    memcpy(first[0].ptr, "abcd", 4);
+    CharMpscFifo_commit(&cf, first);
+    ASSERT_EQ(*CharMpscFifo_getFirst(&cf), 'a');
+    ASSERT_EQ(CharMpscFifo_popMany(&cf, out, sizeof(out)), 9);
+    ASSERT_EQ(0, memcmp(out, "abcdefghi", 9));
+    ASSERT_TRUE(CharMpscFifo_isEmpty(&cf));
+
+    // Committing a failed reservation does nothing
+    ASSERT_FALSE(CharMpscFifo_reserve(&cf, kMpscFifoSize + 1, first));
+    CharMpscFifo_commit(&cf, first);
+    ASSERT_TRUE(CharMpscFifo_isEmpty(&cf));
+}
+
+// A producer holding a reservation does not hold back the elements committed
+// before it, and the producers which reserved after it do not wait for it
+TEST_F(Test_CharMpscFifo, pending_reservation)
+{
+    CharMpscFifo_MutSpan held[2];
+    char out[kMpscFifoSize];
+
+    ASSERT_EQ(CharMpscFifo_pushMany(&cf, "abc", 3), 3);
+    ASSERT_TRUE(CharMpscFifo_reserve(&cf, 4, held));
+
+    // Another producer pushes behind the pending reservation, it returns
+    // without waiting for the commit
+    std::thread producer([this]
+    {
+        ASSERT_EQ(CharMpscFifo_pushMany(&cf, "xyz", 3), 3);
+    });
+    producer.join();
+    ASSERT_EQ(CharMpscFifo_getSize(&cf), 10);
+
+    // The data committed before the reservation is drained
+    ASSERT_EQ(*CharMpscFifo_getFirst(&cf), 'a');
+    ASSERT_EQ(CharMpscFifo_popMany(&cf, out, sizeof(out)), 3);
+    ASSERT_EQ(0, memcmp(out, "abc", 3));
+    ASSERT_TRUE(CharMpscFifo_getFirst(&cf) == NULL);
+    ASSERT_EQ(CharMpscFifo_getSize(&cf), 7);
+
+    memcpy(held[0].ptr, "defg", 4);
+    CharMpscFifo_commit(&cf, held);
+    ASSERT_EQ(CharMpscFifo_popMany(&cf, out, sizeof(out)), 7);
+    ASSERT_EQ(0, memcmp(out, "defgxyz", 7));
+    ASSERT_TRUE(CharMpscFifo_isEmpty(&cf));
+}
+
+// A slot of the previous round must not be taken as committed, the sequence
+// numbers tell the rounds apart
+TEST_F(Test_CharMpscFifo, pending_after_wrap_around)
+{
+    CharMpscFifo_MutSpan held[2];
+    char out[kMpscFifoSize];
+
+    for (unsigned int round = 0; round < 3; round++)
+    {
+        ASSERT_TRUE(CharMpscFifo_reserve(&cf, kMpscFifoSize, held));
+        ASSERT_TRUE(CharMpscFifo_getFirst(&cf) == NULL);
+        ASSERT_EQ(CharMpscFifo_popMany(&cf, out, sizeof(out)), 0);
+        memset(held[0].ptr, 'a' + round, held[0].len);
+        if (held[1].len > 0)
+        {
+            memset(held[1].ptr, 'a' + round, held[1].len);
+        }
+        CharMpscFifo_commit(&cf, held);
+        ASSERT_TRUE(CharMpscFifo_isFull(&cf));
+        ASSERT_EQ(CharMpscFifo_popMany(&cf, out, sizeof(out)),
+                  kMpscFifoSize);
+        ASSERT_EQ(out[kMpscFifoSize - 1], 'a' + round);
+    }
+}
+
+// Several producers write messages concurrently, the consumer has to receive
+// each message in one piece and the messages of a producer in order
+TEST_F(Test_CharMpscFifo, producers_consumer_concurrently)
+{
+    const unsigned int producers = 4;
+    const size_t messages = 1 << 16;
+    const size_t msgLen = 4;
+
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([this, p, messages, msgLen]
+        {
+            for (size_t i = 0; i < messages; i++)
+            {
+                const char msg[msgLen] =
+                {
+                    (char) p, (char) i, (char) (i >> 8), (char) (p ^ i)
+                };
+                CharMpscFifo_MutSpan spans[2];
+                while (!CharMpscFifo_reserve(&cf, msgLen, spans))
+                {
+                    std::this_thread::yield();
+                }
+                memcpy(spans[0].ptr, msg, spans[0].len);
+                if (spans[1].len > 0)
+                {
+                    memcpy(spans[1].ptr, &msg[spans[0].len], spans[1].len);
+                }
+                CharMpscFifo_commit(&cf, spans);
+            }
+        });
+    }
+
+    std::vector<size_t> received(producers, 0);
+    for (size_t total = 0; total < producers * messages; total++)
+    {
+        char msg[msgLen];
+        size_t n;
+        while ((n = CharMpscFifo_popMany(&cf, msg, msgLen)) == 0)
+        {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(n, msgLen);
+        unsigned int p = (unsigned char) msg[0];
+        ASSERT_LT(p, producers);
+        size_t i = received[p]++;
+        ASSERT_EQ(msg[1], (char) i);
+        ASSERT_EQ(msg[2], (char) (i >> 8));
+        ASSERT_EQ(msg[3], (char) (p ^ i));
+    }
+
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_TRUE(CharMpscFifo_isEmpty(&cf))
+        << CharMpscFifo_getSize(&cf);
+}
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_CharPow2Fifo, construction)
+{
+    CharPow2Fifo fifo;
+    char buffer[16];
+
+    ASSERT_FALSE(CharPow2Fifo_ctor(&fifo, buffer, 0));
+    ASSERT_FALSE(CharPow2Fifo_ctor(&fifo, buffer, 6));
+    ASSERT_FALSE(CharPow2Fifo_ctor(&fifo, buffer, 15));
+    ASSERT_FALSE(CharPow2Fifo_ctor(&fifo, NULL, 16));
+    ASSERT_TRUE(CharPow2Fifo_ctor(&fifo, buffer, 1));
+    CharPow2Fifo_dtor(&fifo);
+    ASSERT_TRUE(CharPow2Fifo_ctor(&fifo, buffer, 16));
+    ASSERT_EQ(16, CharPow2Fifo_getCapacity(&fifo));
+    ASSERT_TRUE(CharPow2Fifo_isEmpty(&fifo));
+    ASSERT_FALSE(CharPow2Fifo_isFull(&fifo));
+    CharPow2Fifo_dtor(&fifo);
+}
+
+TEST(Test_CharPow2Fifo, counters_wrap_around)
+{
+    CharPow2Fifo fifo;
+    char buffer[8];
+
+    ASSERT_TRUE(CharPow2Fifo_ctor(&fifo, buffer, sizeof(buffer)));
+
+    // the 8 bit counters wrap several times, size and order must not change
+    char in = 0;
+    char out = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        while (!CharPow2Fifo_isFull(&fifo))
+        {
+            ASSERT_TRUE(CharPow2Fifo_push(&fifo, &in));
+            in++;
+        }
+        ASSERT_EQ(sizeof(buffer), CharPow2Fifo_getSize(&fifo));
+        ASSERT_FALSE(CharPow2Fifo_push(&fifo, &in));
+        ASSERT_FALSE(CharPow2Fifo_isEmpty(&fifo));
+
+        for (int j = 0; j < 1 + i % 8; j++)
+        {
+            ASSERT_EQ(out, *CharPow2Fifo_getFirst(&fifo));
+            ASSERT_TRUE(CharPow2Fifo_pop(&fifo));
+            out++;
+        }
+        ASSERT_FALSE(CharPow2Fifo_isFull(&fifo));
+    }
+    while (CharPow2Fifo_pop(&fifo))
+    {
+        out++;
+    }
+    ASSERT_EQ(in, out);
+    ASSERT_TRUE(CharPow2Fifo_isEmpty(&fifo));
+    ASSERT_EQ(0, CharPow2Fifo_getSize(&fifo));
+    ASSERT_EQ(NULL, CharPow2Fifo_getFirst(&fifo));
+    ASSERT_FALSE(CharPow2Fifo_pop(&fifo));
+    CharPow2Fifo_dtor(&fifo);
+}
+
+TEST(Test_CharPow2Fifo, push_pop_many_wrap_around)
+{
+    CharPow2Fifo fifo;
+    char buffer[8];
+    char src[5] = { 'a', 'b', 'c', 'd', 'e' };
+    char dst[5];
+
+    ASSERT_TRUE(CharPow2Fifo_ctor(&fifo, buffer, sizeof(buffer)));
+    // the bulk copies split at the end of the buffer
+    for (int i = 0; i < 300; i++)
+    {
+        ASSERT_EQ(5, CharPow2Fifo_pushMany(&fifo, src, 5));
+        ASSERT_EQ(5, CharPow2Fifo_popMany(&fifo, dst, 5));
+        ASSERT_EQ(0, memcmp(src, dst, 5));
+    }
+    ASSERT_EQ(5, CharPow2Fifo_pushMany(&fifo, src, 5));
+    ASSERT_EQ(3, CharPow2Fifo_pushMany(&fifo, src, 5));
+    ASSERT_TRUE(CharPow2Fifo_isFull(&fifo));
+    CharPow2Fifo_dtor(&fifo);
+}
+
+/*----------------------------------------------------------------------------*/
+// The methods of a fixed fifo, the typed tests run on the masked and on the
+// compared wrap around of the positions
+template <typename F>
+struct FixedFifo;
+
+#define FIXED_FIFO(N, CAP)                                                  \
+    template <>                                                             \
+    struct FixedFifo<N>                                                     \
+    {                                                                       \
+        typedef N##_Span Span;                                              \
+        static constexpr unsigned int kCapacity = CAP;                      \
+        static constexpr auto ctor = N##_ctor;                              \
+        static constexpr auto dtor = N##_dtor;                              \
+        static constexpr auto push = N##_push;                              \
+        static constexpr auto pushOverwrite = N##_pushOverwrite;            \
+        static constexpr auto pop = N##_pop;                                \
+        static constexpr auto getFirst = N##_getFirst;                      \
+        static constexpr auto getSize = N##_getSize;                        \
+        static constexpr auto getCapacity = N##_getCapacity;                \
+        static constexpr auto isEmpty = N##_isEmpty;                        \
+        static constexpr auto isFull = N##_isFull;                          \
+        static constexpr auto peekSpans = N##_peekSpans;                    \
+    }
+
+FIXED_FIFO(CharFixedFifo8, 8);
+FIXED_FIFO(CharFixedFifo5, 5);
+
+template <typename F>
+class Test_CharFixedFifo : public testing::Test
+{
+    protected:
+        typedef FixedFifo<F> Ops;
+        F cf;
+        void SetUp()
+        {
+            Ops::ctor(&cf);
+        }
+        void TearDown()
+        {
+            Ops::dtor(&cf);
+        }
+};
+
+typedef testing::Types<CharFixedFifo8, CharFixedFifo5> CharFixedFifos;
+TYPED_TEST_SUITE(Test_CharFixedFifo, CharFixedFifos);
+
+TYPED_TEST(Test_CharFixedFifo, push_until_full)
+{
+    typedef typename TestFixture::Ops Ops;
+    TypeParam* cf = &this->cf;
+
+    ASSERT_EQ(Ops::kCapacity, Ops::getCapacity(cf));
+    ASSERT_TRUE(Ops::isEmpty(cf));
+    ASSERT_EQ(NULL, Ops::getFirst(cf));
+    for (char c = 0; c < (char) Ops::kCapacity; c++)
+    {
+        ASSERT_FALSE(Ops::isFull(cf));
+        ASSERT_TRUE(Ops::push(cf, &c));
+    }
+    char c = 'x';
+    ASSERT_TRUE(Ops::isFull(cf));
+    ASSERT_FALSE(Ops::push(cf, &c));
+    ASSERT_EQ(Ops::kCapacity, Ops::getSize(cf));
+    ASSERT_EQ(0, *Ops::getFirst(cf));
+}
+
+TYPED_TEST(Test_CharFixedFifo, wrap_around)
+{
+    typedef typename TestFixture::Ops Ops;
+    TypeParam* cf = &this->cf;
+
+    // the 8 bit positions wrap several times, size and order must not change
+    char in = 0;
+    char out = 0;
+    for (unsigned int i = 0; i < 300; i++)
+    {
+        while (!Ops::isFull(cf))
+        {
+            ASSERT_TRUE(Ops::push(cf, &in));
+            in++;
+        }
+        for (unsigned int j = 0; j < 1 + i % Ops::kCapacity; j++)
+        {
+            ASSERT_EQ(out, *Ops::getFirst(cf));
+            ASSERT_TRUE(Ops::pop(cf));
+            out++;
+        }
+        ASSERT_EQ(Ops::kCapacity - (1 + i % Ops::kCapacity),
+                  Ops::getSize(cf));
+    }
+    while (Ops::pop(cf))
+    {
+        out++;
+    }
+    ASSERT_EQ(in, out);
+    ASSERT_TRUE(Ops::isEmpty(cf));
+    ASSERT_FALSE(Ops::pop(cf));
+}
+
+TYPED_TEST(Test_CharFixedFifo, pushOverwrite)
+{
+    typedef typename TestFixture::Ops Ops;
+    TypeParam* cf = &this->cf;
+
+    // the oldest items are dropped, the newest ones kept in order
+    for (char c = 0; c < (char) Ops::kCapacity + 3; c++)
+    {
+        ASSERT_EQ(c >= (char) Ops::kCapacity, Ops::pushOverwrite(cf, &c));
+    }
+    ASSERT_EQ(Ops::kCapacity, Ops::getSize(cf));
+    for (char c = 3; c < (char) Ops::kCapacity + 3; c++)
+    {
+        ASSERT_EQ(c, *Ops::getFirst(cf));
+        ASSERT_TRUE(Ops::pop(cf));
+    }
+    ASSERT_TRUE(Ops::isEmpty(cf));
+}
+
+TYPED_TEST(Test_CharFixedFifo, peekSpans)
+{
+    typedef typename TestFixture::Ops Ops;
+    typename Ops::Span spans[2];
+    TypeParam* cf = &this->cf;
+
+    ASSERT_EQ(0, Ops::peekSpans(cf, spans));
+    ASSERT_EQ(0, spans[0].len);
+    ASSERT_EQ(0, spans[1].len);
+
+    for (char c = 0; c < 3; c++)
+    {
+        ASSERT_TRUE(Ops::push(cf, &c));
+    }
+    ASSERT_EQ(1, Ops::peekSpans(cf, spans));
+    ASSERT_EQ(cf->fifo, spans[0].ptr);
+    ASSERT_EQ(3, spans[0].len);
+
+    // two items popped and a full fifo, the content wraps at the end
+    ASSERT_TRUE(Ops::pop(cf));
+    ASSERT_TRUE(Ops::pop(cf));
+    for (char c = 3; !Ops::isFull(cf); c++)
+    {
+        ASSERT_TRUE(Ops::push(cf, &c));
+    }
+    ASSERT_EQ(2, Ops::peekSpans(cf, spans));
+    ASSERT_EQ(&cf->fifo[2], spans[0].ptr);
+    ASSERT_EQ(Ops::kCapacity - 2, spans[0].len);
+    ASSERT_EQ(cf->fifo, spans[1].ptr);
+    ASSERT_EQ(2, spans[1].len);
+
+    char expected = 2;
+    for (int s = 0; s < 2; s++)
+    {
+        for (unsigned int i = 0; i < spans[s].len; i++)
+        {
+            ASSERT_EQ(expected++, spans[s].ptr[i]);
+        }
+    }
+}
+
+TYPED_TEST(Test_CharFixedFifo, zero_initialized)
+{
+    typedef typename TestFixture::Ops Ops;
+    // static storage is zero initialized, the fifo is usable without ctor()
+    static TypeParam zeroed;
+
+    ASSERT_TRUE(Ops::isEmpty(&zeroed));
+    ASSERT_EQ(Ops::kCapacity, Ops::getCapacity(&zeroed));
+    for (char c = 0; c < (char) Ops::kCapacity; c++)
+    {
+        ASSERT_TRUE(Ops::push(&zeroed, &c));
+    }
+    ASSERT_TRUE(Ops::isFull(&zeroed));
+    for (char c = 0; c < (char) Ops::kCapacity; c++)
+    {
+        ASSERT_EQ(c, *Ops::getFirst(&zeroed));
+        ASSERT_TRUE(Ops::pop(&zeroed));
+    }
+    ASSERT_TRUE(Ops::isEmpty(&zeroed));
+}
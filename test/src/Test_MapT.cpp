@@ -0,0 +1,802 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C"
+{
+#include "Test_Types.h"
+}
+
+constexpr int kNumKeys = 200;
+
+/*----------------------------------------------------------------------------*/
+// Checks that every key in [0, n) has the expected presence and value
+template <typename M, typename F, typename G, typename V>
+static void checkKeys(M const* map, int n, F getIndexOf, G getValueAt,
+                      V isPresent)
+{
+    for (Pointer k = 0; k < n; k++)
+    {
+        int index = getIndexOf(map, &k);
+        if (isPresent(k))
+        {
+            ASSERT_LE(0, index) << "key " << k;
+            ASSERT_EQ(k * 10, *getValueAt(map, index)) << "key " << k;
+        }
+        else
+        {
+            ASSERT_EQ(-1, index) << "key " << k;
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_MapT, hashed_collisions)
+{
+    ColliderMap map;
+
+    ASSERT_TRUE(ColliderMap_ctor(&map, 4));
+    for (Collider k = 0; k < kNumKeys; k++)
+    {
+        Pointer v = k * 10;
+        ASSERT_TRUE(ColliderMap_insert(&map, &k, &v));
+        // a key is inserted once only
+        ASSERT_FALSE(ColliderMap_insert(&map, &k, &v));
+    }
+    ASSERT_EQ(kNumKeys, ColliderMap_getSize(&map));
+    checkKeys(&map, 2 * kNumKeys, ColliderMap_getIndexOf,
+              ColliderMap_getValueAt,
+              [](Pointer k) { return k < kNumKeys; });
+
+    // the removal shifts the colliding keys back, they must stay reachable
+    for (Collider k = 1; k < kNumKeys; k += 2)
+    {
+        ASSERT_TRUE(ColliderMap_remove(&map, &k));
+        ASSERT_FALSE(ColliderMap_remove(&map, &k));
+    }
+    ASSERT_EQ(kNumKeys / 2, ColliderMap_getSize(&map));
+    checkKeys(&map, kNumKeys, ColliderMap_getIndexOf, ColliderMap_getValueAt,
+              [](Pointer k) { return k % 2 == 0; });
+
+    for (Collider k = 1; k < kNumKeys; k += 2)
+    {
+        Pointer v = k * 10;
+        ASSERT_TRUE(ColliderMap_insert(&map, &k, &v));
+    }
+    checkKeys(&map, kNumKeys, ColliderMap_getIndexOf, ColliderMap_getValueAt,
+              [](Pointer) { return true; });
+    ColliderMap_dtor(&map);
+}
+
+TEST(Test_MapT, hashed_remove_then_lookup)
+{
+    PointerHashedMap map;
+
+    ASSERT_TRUE(PointerHashedMap_ctor(&map, kNumKeys));
+    for (Pointer k = 0; k < kNumKeys; k++)
+    {
+        Pointer v = k * 10;
+        ASSERT_TRUE(PointerHashedMap_insert(&map, &k, &v));
+    }
+    // the last association moves into the hole of the removed one, every
+    // index must still lead to its key
+    for (Pointer k = 0; k < kNumKeys; k += 3)
+    {
+        ASSERT_TRUE(PointerHashedMap_remove(&map, &k));
+        ASSERT_FALSE(PointerHashedMap_find(&map, &k));
+        for (int i = 0; i < PointerHashedMap_getSize(&map); i++)
+        {
+            Pointer const* key = PointerHashedMap_getKeyAt(&map, i);
+            ASSERT_EQ(i, PointerHashedMap_getIndexOf(&map, key));
+        }
+    }
+    checkKeys(&map, kNumKeys, PointerHashedMap_getIndexOf,
+              PointerHashedMap_getValueAt,
+              [](Pointer k) { return k % 3 != 0; });
+
+    PointerHashedMap_clear(&map);
+    ASSERT_TRUE(PointerHashedMap_isEmpty(&map));
+    Pointer k = 1;
+    ASSERT_FALSE(PointerHashedMap_find(&map, &k));
+    PointerHashedMap_dtor(&map);
+}
+
+TEST(Test_MapT, hashed_growth)
+{
+    PointerHashedMap map;
+
+    // every growth of the vector rehashes the slots
+    ASSERT_TRUE(PointerHashedMap_ctor(&map, 1));
+    for (Pointer k = 0; k < kNumKeys; k++)
+    {
+        Pointer v = k * 10;
+        ASSERT_TRUE(PointerHashedMap_insert(&map, &k, &v));
+        ASSERT_TRUE(PointerHashedMap_find(&map, &k));
+    }
+    checkKeys(&map, 2 * kNumKeys, PointerHashedMap_getIndexOf,
+              PointerHashedMap_getValueAt,
+              [](Pointer k) { return k < kNumKeys; });
+
+    PointerHashedMap copy;
+    ASSERT_TRUE(PointerHashedMap_ctorCopy(&copy, &map));
+    PointerHashedMap_dtor(&map);
+    checkKeys(&copy, 2 * kNumKeys, PointerHashedMap_getIndexOf,
+              PointerHashedMap_getValueAt,
+              [](Pointer k) { return k < kNumKeys; });
+    PointerHashedMap_dtor(&copy);
+}
+
+TEST(Test_MapT, hashed_static_full)
+{
+    constexpr int kCapacity = 8;
+    uint8_t buffer[MapT_SIZE_OF_BUFFER(PointerHashedMap, kCapacity)];
+    PointerHashedMap map;
+
+    ASSERT_TRUE(PointerHashedMap_ctorStatic(&map, buffer, kCapacity));
+    for (Pointer k = 0; k < kCapacity; k++)
+    {
+        Pointer v = k * 10;
+        ASSERT_TRUE(PointerHashedMap_insert(&map, &k, &v));
+    }
+    // the static buffer can not grow, the map is left unchanged
+    Pointer k = kCapacity;
+    ASSERT_FALSE(PointerHashedMap_insert(&map, &k, &k));
+    ASSERT_EQ(kCapacity, PointerHashedMap_getSize(&map));
+    checkKeys(&map, 2 * kCapacity, PointerHashedMap_getIndexOf,
+              PointerHashedMap_getValueAt,
+              [](Pointer k) { return k < kCapacity; });
+    PointerHashedMap_dtor(&map);
+}
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_PointerMap, removeAt_swaps_last)
+{
+    PointerMap map;
+
+    ASSERT_TRUE(PointerMap_ctor(&map, 4));
+    for (Pointer k = 0; k < 5; k++)
+    {
+        Pointer v = k * 10;
+        ASSERT_TRUE(PointerMap_insert(&map, &k, &v));
+    }
+    Pointer k = 1;
+    int index = PointerMap_getIndexOf(&map, &k);
+    ASSERT_EQ(1, index);
+    PointerMap_removeAt(&map, index);
+
+    // the last association takes the place of the removed one
+    ASSERT_EQ(4, PointerMap_getSize(&map));
+    ASSERT_EQ(-1, PointerMap_getIndexOf(&map, &k));
+    k = 4;
+    ASSERT_EQ(1, PointerMap_getIndexOf(&map, &k));
+    ASSERT_EQ(40, *PointerMap_getValueAt(&map, 1));
+    for (Pointer key = 0; key < 5; key++)
+    {
+        ASSERT_EQ(key != 1, PointerMap_find(&map, &key));
+    }
+    PointerMap_dtor(&map);
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_PointerSortedMap : public testing::Test
+{
+protected:
+    PointerSortedMap map;
+
+    // the even keys in [0, 2 * kNumKeys), inserted in a scrambled order
+    void SetUp() override
+    {
+        ASSERT_TRUE(PointerSortedMap_ctor(&map, 4));
+        for (int i = 0; i < kNumKeys; i++)
+        {
+            Pointer k = ((i * 37) % kNumKeys) * 2;
+            Pointer v = k * 10;
+            ASSERT_TRUE(PointerSortedMap_insert(&map, &k, &v));
+        }
+        ASSERT_EQ(kNumKeys, PointerSortedMap_getSize(&map));
+    }
+
+    void TearDown() override
+    {
+        PointerSortedMap_dtor(&map);
+    }
+
+    void checkOrder()
+    {
+        for (int i = 1; i < PointerSortedMap_getSize(&map); i++)
+        {
+            ASSERT_LT(*PointerSortedMap_getKeyAt(&map, i - 1),
+                      *PointerSortedMap_getKeyAt(&map, i));
+        }
+    }
+};
+
+TEST_F(Test_PointerSortedMap, ordered_insertion)
+{
+    checkOrder();
+    for (int i = 0; i < kNumKeys; i++)
+    {
+        ASSERT_EQ(i * 2, *PointerSortedMap_getKeyAt(&map, i));
+        ASSERT_EQ(i * 20, *PointerSortedMap_getValueAt(&map, i));
+    }
+
+    // a duplicate is rejected and does not change the order
+    Pointer k = 10;
+    Pointer v = 0;
+    ASSERT_FALSE(PointerSortedMap_insert(&map, &k, &v));
+    ASSERT_EQ(kNumKeys, PointerSortedMap_getSize(&map));
+    ASSERT_EQ(100, *PointerSortedMap_getValueAt(&map, 5));
+}
+
+TEST_F(Test_PointerSortedMap, lookup)
+{
+    Pointer k = 0;
+    ASSERT_EQ(0, PointerSortedMap_getIndexOf(&map, &k));
+    k = (kNumKeys - 1) * 2;
+    ASSERT_EQ(kNumKeys - 1, PointerSortedMap_getIndexOf(&map, &k));
+    k = 84;
+    ASSERT_EQ(42, PointerSortedMap_getIndexOf(&map, &k));
+    ASSERT_TRUE(PointerSortedMap_find(&map, &k));
+
+    // misses before, between and after the keys
+    k = -1;
+    ASSERT_EQ(-1, PointerSortedMap_getIndexOf(&map, &k));
+    k = 85;
+    ASSERT_EQ(-1, PointerSortedMap_getIndexOf(&map, &k));
+    ASSERT_FALSE(PointerSortedMap_find(&map, &k));
+    k = kNumKeys * 2;
+    ASSERT_EQ(-1, PointerSortedMap_getIndexOf(&map, &k));
+}
+
+TEST_F(Test_PointerSortedMap, bounds)
+{
+    Pointer a = 9;
+    Pointer b = 20;
+    // the keys in [9, 20] are 10, 12, ..., 20
+    ASSERT_EQ(5, PointerSortedMap_lowerBound(&map, &a));
+    ASSERT_EQ(11, PointerSortedMap_upperBound(&map, &b));
+    ASSERT_EQ(10, PointerSortedMap_lowerBound(&map, &b));
+
+    a = -5;
+    ASSERT_EQ(0, PointerSortedMap_lowerBound(&map, &a));
+    ASSERT_EQ(0, PointerSortedMap_upperBound(&map, &a));
+    b = kNumKeys * 2;
+    ASSERT_EQ(kNumKeys, PointerSortedMap_lowerBound(&map, &b));
+    ASSERT_EQ(kNumKeys, PointerSortedMap_upperBound(&map, &b));
+}
+
+TEST_F(Test_PointerSortedMap, remove_keeps_order)
+{
+    Pointer first = 0;
+    Pointer last = (kNumKeys - 1) * 2;
+    Pointer middle = 100;
+
+    ASSERT_TRUE(PointerSortedMap_remove(&map, &middle));
+    ASSERT_FALSE(PointerSortedMap_remove(&map, &middle));
+    ASSERT_TRUE(PointerSortedMap_remove(&map, &first));
+    ASSERT_TRUE(PointerSortedMap_remove(&map, &last));
+    ASSERT_EQ(kNumKeys - 3, PointerSortedMap_getSize(&map));
+    checkOrder();
+
+    ASSERT_EQ(2, *PointerSortedMap_getKeyAt(&map, 0));
+    ASSERT_EQ((kNumKeys - 2) * 2,
+              *PointerSortedMap_getKeyAt(&map, kNumKeys - 4));
+    for (Pointer k = 2; k < last; k += 2)
+    {
+        int index = PointerSortedMap_getIndexOf(&map, &k);
+        ASSERT_EQ(k != middle, index >= 0);
+        if (index >= 0)
+        {
+            ASSERT_EQ(k * 10, *PointerSortedMap_getValueAt(&map, index));
+        }
+    }
+}
+
+TEST_F(Test_PointerSortedMap, insertMany)
+{
+    // odd keys are new, 4 is already there, 7 is repeated in the batch
+    Pointer keys[] = { 7, 1, 4, 7, 401, 3 };
+    Pointer values[] = { 70, 10, 0, 71, 4010, 30 };
+
+    ASSERT_EQ(4, PointerSortedMap_insertMany(&map, keys, values, 6));
+    ASSERT_EQ(kNumKeys + 4, PointerSortedMap_getSize(&map));
+    checkOrder();
+
+    Pointer k = 4;
+    int index = PointerSortedMap_getIndexOf(&map, &k);
+    ASSERT_EQ(40, *PointerSortedMap_getValueAt(&map, index));
+    k = 401;
+    ASSERT_EQ(kNumKeys + 3, PointerSortedMap_getIndexOf(&map, &k));
+    k = 3;
+    ASSERT_EQ(3, PointerSortedMap_getIndexOf(&map, &k));
+}
+
+/*----------------------------------------------------------------------------*/
+// Records the visited indexes, stops after 'stopAt' has been visited
+struct Visits
+{
+    std::vector<int> index;
+    int stopAt = -1;
+};
+
+static bool
+visit(void* context, Pointer const* key, Pointer const* value, int index)
+{
+    Visits* visits = static_cast<Visits*>(context);
+    EXPECT_EQ(*key * 10, *value);
+    visits->index.push_back(index);
+    return index != visits->stopAt;
+}
+
+static bool
+negate(void* context, Pointer const* key, Pointer* value, int index)
+{
+    (void) context;
+    (void) key;
+    (void) index;
+    *value = -*value;
+    return true;
+}
+
+class Test_PointerMap_apply : public testing::Test
+{
+protected:
+    PointerMap map;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(PointerMap_ctor(&map, 4));
+        for (Pointer k = 0; k < 10; k++)
+        {
+            Pointer v = k * 10;
+            ASSERT_TRUE(PointerMap_insert(&map, &k, &v));
+        }
+    }
+
+    void TearDown() override
+    {
+        PointerMap_dtor(&map);
+    }
+};
+
+TEST_F(Test_PointerMap_apply, getData)
+{
+    PointerMap_Item const* items = PointerMap_getData(&map);
+    for (int i = 0; i < PointerMap_getSize(&map); i++)
+    {
+        ASSERT_EQ(*PointerMap_getKeyAt(&map, i), items[i].key);
+        ASSERT_EQ(*PointerMap_getValueAt(&map, i), items[i].value);
+    }
+}
+
+TEST_F(Test_PointerMap_apply, early_stop)
+{
+    Visits visits;
+
+    ASSERT_EQ(10, PointerMap_constApply(&map, visit, &visits));
+    ASSERT_EQ(10, visits.index.size());
+
+    visits.index.clear();
+    visits.stopAt = 2;
+    ASSERT_EQ(3, PointerMap_constApply(&map, visit, &visits));
+    ASSERT_EQ(std::vector<int>({ 0, 1, 2 }), visits.index);
+
+    visits.index.clear();
+    visits.stopAt = 7;
+    ASSERT_EQ(2, PointerMap_constApplyRange(&map, 6, 10, visit, &visits));
+    ASSERT_EQ(std::vector<int>({ 6, 7 }), visits.index);
+}
+
+TEST_F(Test_PointerMap_apply, ranges)
+{
+    Visits visits;
+
+    ASSERT_EQ(4, PointerMap_constApplyRange(&map, 3, 7, visit, &visits));
+    ASSERT_EQ(std::vector<int>({ 3, 4, 5, 6 }), visits.index);
+
+    // empty and inverted ranges process nothing
+    visits.index.clear();
+    ASSERT_EQ(0, PointerMap_constApplyRange(&map, 4, 4, visit, &visits));
+    ASSERT_EQ(0, PointerMap_constApplyRange(&map, 7, 3, visit, &visits));
+    ASSERT_EQ(0, PointerMap_applyRange(&map, 7, 3, negate, NULL));
+    ASSERT_TRUE(visits.index.empty());
+}
+
+TEST_F(Test_PointerMap_apply, mutation)
+{
+    ASSERT_EQ(2, PointerMap_applyRange(&map, 8, 10, negate, NULL));
+    for (Pointer k = 0; k < 10; k++)
+    {
+        int index = PointerMap_getIndexOf(&map, &k);
+        ASSERT_EQ(k * ((k >= 8) ? -10 : 10),
+                  *PointerMap_getValueAt(&map, index));
+    }
+
+    // the keys are unchanged, the lookups still work
+    ASSERT_EQ(10, PointerMap_apply(&map, negate, NULL));
+    for (Pointer k = 0; k < 10; k++)
+    {
+        int index = PointerMap_getIndexOf(&map, &k);
+        ASSERT_EQ(k, *PointerMap_getKeyAt(&map, index));
+        ASSERT_EQ(k * ((k >= 8) ? 10 : -10),
+                  *PointerMap_getValueAt(&map, index));
+    }
+}
+
+TEST(Test_PointerHashedMap_apply, mutation)
+{
+    PointerHashedMap map;
+
+    ASSERT_TRUE(PointerHashedMap_ctor(&map, 4));
+    for (Pointer k = 0; k < kNumKeys; k++)
+    {
+        Pointer v = k;
+        ASSERT_TRUE(PointerHashedMap_insert(&map, &k, &v));
+    }
+    ASSERT_EQ(kNumKeys, PointerHashedMap_apply(&map, negate, NULL));
+    for (Pointer k = 0; k < kNumKeys; k++)
+    {
+        int index = PointerHashedMap_getIndexOf(&map, &k);
+        ASSERT_GE(index, 0);
+        ASSERT_EQ(-k, *PointerHashedMap_getValueAt(&map, index));
+    }
+    PointerHashedMap_dtor(&map);
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_PointerSoaMap : public testing::Test
+{
+protected:
+    PointerSoaMap map;
+
+    void SetUp() override
+    {
+        Counted_live = 0;
+    }
+
+    void TearDown() override
+    {
+        PointerSoaMap_dtor(&map);
+        ASSERT_EQ(0, Counted_live);
+    }
+
+    void insert(Pointer k)
+    {
+        Counted v = { (int) k * 10 };
+        ASSERT_TRUE(PointerSoaMap_insert(&map, &k, &v));
+    }
+};
+
+TEST_F(Test_PointerSoaMap, insert_lookup)
+{
+    ASSERT_TRUE(PointerSoaMap_ctor(&map, 4));
+    for (Pointer k = 0; k < 10; k++)
+    {
+        insert(k);
+    }
+    ASSERT_EQ(10, PointerSoaMap_getSize(&map));
+    ASSERT_EQ(10, Counted_live);
+
+    // a duplicate is rejected
+    Pointer k = 3;
+    Counted v = { -1 };
+    ASSERT_FALSE(PointerSoaMap_insert(&map, &k, &v));
+    ASSERT_EQ(10, PointerSoaMap_getSize(&map));
+
+    Pointer const* keys = PointerSoaMap_getKeys(&map);
+    Counted const* values = PointerSoaMap_getValues(&map);
+    for (Pointer key = 0; key < 10; key++)
+    {
+        int index = PointerSoaMap_getIndexOf(&map, &key);
+        ASSERT_GE(index, 0);
+        ASSERT_EQ(key, keys[index]);
+        ASSERT_EQ(key * 10, values[index].value);
+        ASSERT_EQ(key * 10, PointerSoaMap_getValueAt(&map, index)->value);
+    }
+    k = 10;
+    ASSERT_EQ(-1, PointerSoaMap_getIndexOf(&map, &k));
+    ASSERT_FALSE(PointerSoaMap_find(&map, &k));
+
+    k = 7;
+    v.value = 77;
+    ASSERT_TRUE(PointerSoaMap_setValueAt(&map,
+                                         PointerSoaMap_getIndexOf(&map, &k),
+                                         &v));
+    ASSERT_EQ(77, values[PointerSoaMap_getIndexOf(&map, &k)].value);
+}
+
+TEST_F(Test_PointerSoaMap, remove)
+{
+    ASSERT_TRUE(PointerSoaMap_ctor(&map, 4));
+    for (Pointer k = 0; k < 5; k++)
+    {
+        insert(k);
+    }
+    Pointer k = 1;
+    ASSERT_TRUE(PointerSoaMap_remove(&map, &k));
+    ASSERT_FALSE(PointerSoaMap_remove(&map, &k));
+    ASSERT_EQ(4, PointerSoaMap_getSize(&map));
+    ASSERT_EQ(4, Counted_live);
+
+    // keys and values are swapped together, the associations stay intact
+    for (Pointer key = 0; key < 5; key++)
+    {
+        int index = PointerSoaMap_getIndexOf(&map, &key);
+        ASSERT_EQ(key != 1, index >= 0);
+        if (index >= 0)
+        {
+            ASSERT_EQ(key * 10, PointerSoaMap_getValueAt(&map, index)->value);
+        }
+    }
+
+    PointerSoaMap_clear(&map);
+    ASSERT_TRUE(PointerSoaMap_isEmpty(&map));
+    ASSERT_EQ(0, Counted_live);
+}
+
+TEST_F(Test_PointerSoaMap, applyRange)
+{
+    ASSERT_TRUE(PointerSoaMap_ctor(&map, 4));
+    for (Pointer k = 0; k < 10; k++)
+    {
+        insert(k);
+    }
+
+    auto negate = [](void* context, Pointer const* key, Counted* value,
+                     int index) -> bool
+    {
+        (void) context;
+        (void) key;
+        (void) index;
+        value->value = -value->value;
+        return true;
+    };
+    ASSERT_EQ(0, PointerSoaMap_applyRange(&map, 7, 3, negate, NULL));
+    ASSERT_EQ(2, PointerSoaMap_applyRange(&map, 8, 10, negate, NULL));
+    for (Pointer k = 0; k < 10; k++)
+    {
+        int index = PointerSoaMap_getIndexOf(&map, &k);
+        ASSERT_EQ(k * ((k >= 8) ? -10 : 10),
+                  PointerSoaMap_getValueAt(&map, index)->value);
+    }
+
+    Visits visits;
+    auto visit = [](void* context, Pointer const* key, Counted const* value,
+                    int index) -> bool
+    {
+        (void) key;
+        (void) value;
+        static_cast<Visits*>(context)->index.push_back(index);
+        return true;
+    };
+    ASSERT_EQ(3, PointerSoaMap_constApplyRange(&map, 2, 5, visit, &visits));
+    ASSERT_EQ(std::vector<int>({ 2, 3, 4 }), visits.index);
+}
+
+TEST_F(Test_PointerSoaMap, growth)
+{
+    ASSERT_TRUE(PointerSoaMap_ctor(&map, 1));
+    for (Pointer k = 0; k < kNumKeys; k++)
+    {
+        insert(k);
+    }
+    ASSERT_EQ(kNumKeys, PointerSoaMap_getSize(&map));
+    ASSERT_EQ(kNumKeys, Counted_live);
+
+    PointerSoaMap copy;
+    ASSERT_TRUE(PointerSoaMap_ctorCopy(&copy, &map));
+    ASSERT_EQ(2 * kNumKeys, Counted_live);
+    for (Pointer k = 0; k < kNumKeys; k++)
+    {
+        int index = PointerSoaMap_getIndexOf(&copy, &k);
+        ASSERT_GE(index, 0);
+        ASSERT_EQ(k * 10, PointerSoaMap_getValueAt(&copy, index)->value);
+    }
+    PointerSoaMap_dtor(&copy);
+}
+
+TEST_F(Test_PointerSoaMap, ctorStatic)
+{
+    constexpr int kCapacity = 5;
+    alignas(PointerSoaMap_Item)
+        uint8_t buffer[MapT_SIZE_OF_BUFFER(PointerSoaMap, kCapacity)];
+
+    ASSERT_FALSE(PointerSoaMap_ctorStatic(&map, NULL, kCapacity));
+    ASSERT_TRUE(PointerSoaMap_ctorStatic(&map, buffer, kCapacity));
+    for (Pointer k = 0; k < kCapacity; k++)
+    {
+        insert(k);
+    }
+    Pointer k = kCapacity;
+    Counted v = { 0 };
+    ASSERT_FALSE(PointerSoaMap_insert(&map, &k, &v));
+    ASSERT_EQ(kCapacity, Counted_live);
+
+    // the keys come first, the values right after them
+    ASSERT_EQ((void const*) buffer, PointerSoaMap_getKeys(&map));
+    ASSERT_EQ((void const*) (buffer + kCapacity * sizeof(Pointer)),
+              PointerSoaMap_getValues(&map));
+}
+
+TEST(Test_CountedSoaMap, ctorStatic_aligns_values)
+{
+    constexpr int kCapacity = 3;
+    alignas(CountedSoaMap_Item)
+        uint8_t buffer[MapT_SIZE_OF_BUFFER(CountedSoaMap, kCapacity)];
+    CountedSoaMap map;
+
+    Counted_live = 0;
+    ASSERT_TRUE(CountedSoaMap_ctorStatic(&map, buffer, kCapacity));
+    for (int i = 0; i < kCapacity; i++)
+    {
+        Counted k = { i };
+        Pointer v = i * 10;
+        ASSERT_TRUE(CountedSoaMap_insert(&map, &k, &v));
+    }
+
+    // 3 keys of 4 bytes, the values start at the next multiple of 8
+    uintptr_t values = (uintptr_t) CountedSoaMap_getValues(&map);
+    ASSERT_EQ((uintptr_t) buffer, (uintptr_t) CountedSoaMap_getKeys(&map));
+    ASSERT_EQ(0u, values % alignof(Pointer));
+    ASSERT_EQ((uintptr_t) buffer + 16, values);
+    ASSERT_LE(values + kCapacity * sizeof(Pointer),
+              (uintptr_t) buffer + sizeof(buffer));
+    for (int i = 0; i < kCapacity; i++)
+    {
+        Counted k = { i };
+        int index = CountedSoaMap_getIndexOf(&map, &k);
+        ASSERT_EQ(i * 10, *CountedSoaMap_getValueAt(&map, index));
+    }
+    CountedSoaMap_dtor(&map);
+    ASSERT_EQ(0, Counted_live);
+}
+
+/*----------------------------------------------------------------------------*/
+struct ScanPath
+{
+    char const* name;
+    bool supported;
+    int (*scan32)(MapT_Key32 const* keys, int size, uint32_t needle);
+    int (*scan64)(MapT_Key64 const* keys, int size, uint64_t needle);
+};
+
+static std::vector<ScanPath>
+getScanPaths()
+{
+    std::vector<ScanPath> paths = {
+        { "default", true, MapT_scanKeys32, MapT_scanKeys64 },
+    };
+#if defined(MapT_SCAN_X86_)
+    paths.push_back({ "sse2", __builtin_cpu_supports("sse2") != 0,
+                      MapT_scanKeys32Sse2, MapT_scanKeys64Sse2 });
+    paths.push_back({ "avx2", __builtin_cpu_supports("avx2") != 0,
+                      MapT_scanKeys32Avx2, MapT_scanKeys64Avx2 });
+    paths.push_back({ "avx512", __builtin_cpu_supports("avx512f") != 0,
+                      MapT_scanKeys32Avx512, MapT_scanKeys64Avx512 });
+#elif defined(MapT_SCAN_NEON_)
+    paths.push_back({ "neon", true,
+                      MapT_scanKeys32Neon, MapT_scanKeys64Neon });
+#endif
+    return paths;
+}
+
+// Up to 2 blocks of 16 lanes plus a tail, a size of 37 is a multiple of none
+// of the lane widths
+constexpr int kScanKeys = 37;
+
+TEST(Test_MapT_scanKeys, scan32)
+{
+    uint32_t keys[kScanKeys + 1];
+    for (int i = 0; i <= kScanKeys; i++)
+    {
+        keys[i] = 0x80000000u + 3 * i;
+    }
+    for (ScanPath const& path : getScanPaths())
+    {
+        if (!path.supported)
+        {
+            continue;
+        }
+        SCOPED_TRACE(path.name);
+        for (int size = 0; size <= kScanKeys; size++)
+        {
+            // a hit in every block and in the tail
+            for (int i = 0; i < size; i++)
+            {
+                ASSERT_EQ(i, path.scan32(keys, size, keys[i]));
+            }
+            // a miss, and the key after the last one is not read as a hit
+            ASSERT_EQ(-1, path.scan32(keys, size, 1));
+            ASSERT_EQ(-1, path.scan32(keys, size, keys[size]));
+            ASSERT_EQ(MapT_scanKeys32Scalar(keys, size, keys[size / 2]),
+                      path.scan32(keys, size, keys[size / 2]));
+        }
+    }
+}
+
+TEST(Test_MapT_scanKeys, scan64)
+{
+    uint64_t keys[kScanKeys + 1];
+    for (int i = 0; i <= kScanKeys; i++)
+    {
+        keys[i] = ((uint64_t) i << 32) | 7;
+    }
+    for (ScanPath const& path : getScanPaths())
+    {
+        if (!path.supported)
+        {
+            continue;
+        }
+        SCOPED_TRACE(path.name);
+        for (int size = 0; size <= kScanKeys; size++)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                ASSERT_EQ(i, path.scan64(keys, size, keys[i]));
+            }
+            // the lower halves of all keys match, the upper ones do not
+            ASSERT_EQ(-1, path.scan64(keys, size, ((uint64_t) 99 << 32) | 7));
+            ASSERT_EQ(-1, path.scan64(keys, size, keys[size]));
+            ASSERT_EQ(MapT_scanKeys64Scalar(keys, size, keys[size / 2]),
+                      path.scan64(keys, size, keys[size / 2]));
+        }
+    }
+}
+
+TEST(Test_MapT_scanKeys, first_match)
+{
+    uint32_t keys32[kScanKeys] = { 0 };
+    uint64_t keys64[kScanKeys] = { 0 };
+    keys32[5] = keys32[21] = keys32[35] = 1;
+    keys64[5] = keys64[21] = keys64[35] = 1;
+    for (ScanPath const& path : getScanPaths())
+    {
+        if (!path.supported)
+        {
+            continue;
+        }
+        SCOPED_TRACE(path.name);
+        ASSERT_EQ(5, path.scan32(keys32, kScanKeys, 1));
+        ASSERT_EQ(5, path.scan64(keys64, kScanKeys, 1));
+        ASSERT_EQ(21, path.scan32(&keys32[6], kScanKeys - 6, 1) + 6);
+        ASSERT_EQ(35, path.scan64(&keys64[22], kScanKeys - 22, 1) + 22);
+    }
+}
+
+TEST(Test_PointerIntKeyMap, lookup)
+{
+    PointerIntKeyMap map;
+
+    ASSERT_TRUE(PointerIntKeyMap_ctor(&map, 4));
+    for (Pointer k = 0; k < kScanKeys; k++)
+    {
+        Pointer key = k * -1000;
+        ASSERT_TRUE(PointerIntKeyMap_insert(&map, &key, &k));
+    }
+    // the duplicate check of insert uses the scan as well
+    Pointer key = -5000;
+    ASSERT_FALSE(PointerIntKeyMap_insert(&map, &key, &key));
+
+    for (Pointer k = 0; k < kScanKeys; k++)
+    {
+        key = k * -1000;
+        int index = PointerIntKeyMap_getIndexOf(&map, &key);
+        ASSERT_EQ(k, index);
+        ASSERT_EQ(k, *PointerIntKeyMap_getValueAt(&map, index));
+    }
+    key = 1;
+    ASSERT_EQ(-1, PointerIntKeyMap_getIndexOf(&map, &key));
+
+    key = 0;
+    ASSERT_TRUE(PointerIntKeyMap_remove(&map, &key));
+    key = (kScanKeys - 1) * -1000;
+    ASSERT_EQ(0, PointerIntKeyMap_getIndexOf(&map, &key));
+    PointerIntKeyMap_dtor(&map);
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "Test_Types.h"
+}
+
+constexpr size_t kPoolSize = 8;
+
+/*----------------------------------------------------------------------------*/
+class Test_PointerPool : public testing::Test
+{
+protected:
+    PointerPool pool;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(PointerPool_ctor(&pool, kPoolSize));
+    }
+
+    void TearDown() override
+    {
+        PointerPool_dtor(&pool);
+    }
+};
+
+TEST_F(Test_PointerPool, acquire_until_exhausted)
+{
+    Pointer* items[kPoolSize];
+
+    ASSERT_EQ(kPoolSize, PointerPool_getCapacity(&pool));
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        ASSERT_FALSE(PointerPool_isFull(&pool));
+        items[i] = PointerPool_acquire(&pool);
+        ASSERT_NE(nullptr, items[i]);
+        *items[i] = (Pointer) i;
+        ASSERT_EQ(i + 1, PointerPool_getUsed(&pool));
+    }
+    ASSERT_TRUE(PointerPool_isFull(&pool));
+    ASSERT_EQ(nullptr, PointerPool_acquire(&pool));
+    ASSERT_EQ(kPoolSize, PointerPool_getUsed(&pool));
+
+    // the slots are distinct, no object has been overwritten
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        ASSERT_EQ((Pointer) i, *items[i]);
+    }
+}
+
+TEST_F(Test_PointerPool, release_then_reuse)
+{
+    Pointer* items[kPoolSize];
+
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        items[i] = PointerPool_acquire(&pool);
+    }
+    PointerPool_release(&pool, items[2]);
+    PointerPool_release(&pool, items[5]);
+    ASSERT_EQ(kPoolSize - 2, PointerPool_getUsed(&pool));
+    ASSERT_FALSE(PointerPool_isFull(&pool));
+
+    // the last released slot is reused first
+    ASSERT_EQ(items[5], PointerPool_acquire(&pool));
+    ASSERT_EQ(items[2], PointerPool_acquire(&pool));
+    ASSERT_EQ(nullptr, PointerPool_acquire(&pool));
+}
+
+TEST_F(Test_PointerPool, release_before_exhausted)
+{
+    Pointer* a = PointerPool_acquire(&pool);
+    Pointer* b = PointerPool_acquire(&pool);
+
+    // released slots are taken before the ones never used
+    PointerPool_release(&pool, a);
+    ASSERT_EQ(a, PointerPool_acquire(&pool));
+    Pointer* c = PointerPool_acquire(&pool);
+    ASSERT_NE(a, c);
+    ASSERT_NE(b, c);
+    ASSERT_EQ(3, PointerPool_getUsed(&pool));
+}
+
+TEST_F(Test_PointerPool, owns)
+{
+    Pointer outside = 0;
+    Pointer* a = PointerPool_acquire(&pool);
+    Pointer* b = PointerPool_acquire(&pool);
+
+    ASSERT_TRUE(PointerPool_owns(&pool, a));
+    ASSERT_TRUE(PointerPool_owns(&pool, b));
+    ASSERT_FALSE(PointerPool_owns(&pool, &outside));
+
+    // inside the slots, but not at the start of one
+    Pointer const* misaligned = (Pointer const*) ((char const*) a + 1);
+    ASSERT_FALSE(PointerPool_owns(&pool, misaligned));
+
+    // a slot which has not been handed out yet
+    Pointer const* unused = &((PointerPool_Slot const*) b)[1].item;
+    ASSERT_FALSE(PointerPool_owns(&pool, unused));
+
+    // a released slot is still part of the pool
+    PointerPool_release(&pool, a);
+    ASSERT_TRUE(PointerPool_owns(&pool, a));
+}
+
+TEST_F(Test_PointerPool, dtor)
+{
+    Pointer* a = PointerPool_acquire(&pool);
+    PointerPool_release(&pool, PointerPool_acquire(&pool));
+
+    PointerPool_dtor(&pool);
+    ASSERT_EQ(0, PointerPool_getCapacity(&pool));
+    ASSERT_EQ(0, PointerPool_getUsed(&pool));
+    ASSERT_EQ(nullptr, PointerPool_acquire(&pool));
+    ASSERT_FALSE(PointerPool_owns(&pool, a));
+
+    // the pool can be constructed again
+    ASSERT_TRUE(PointerPool_ctor(&pool, kPoolSize));
+    ASSERT_NE(nullptr, PointerPool_acquire(&pool));
+    ASSERT_EQ(1, PointerPool_getUsed(&pool));
+}
+
+TEST(Test_PointerPool_static, ctorStatic)
+{
+    PointerPool_Slot buffer[kPoolSize];
+    PointerPool pool;
+
+    ASSERT_FALSE(PointerPool_ctorStatic(&pool, NULL, kPoolSize));
+    ASSERT_TRUE(PointerPool_ctorStatic(&pool, buffer, kPoolSize));
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        Pointer* item = PointerPool_acquire(&pool);
+        ASSERT_EQ(&buffer[i].item, item);
+    }
+    ASSERT_EQ(nullptr, PointerPool_acquire(&pool));
+    PointerPool_dtor(&pool);
+}
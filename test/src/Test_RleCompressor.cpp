@@ -6,6 +6,7 @@
  * For commercial licensing, contact: info.cyber@hensoldt.net
  */
 #include <gtest/gtest.h>
+#include <algorithm>
 
 extern "C"
 {
@@ -132,3 +133,469 @@ TEST(Test_RleCompressor, compress_decompress)
     ASSERT_EQ(0, memcmp(static_buf, inbuf, sizeof(inbuf)));
     free(alloc_buf);
 }
+
+TEST(Test_RleCompressor, compress_runs)
+{
+    uint8_t inbuf[87], outbuf[32];
+    uint8_t* static_buf = outbuf;
+    size_t len;
+    const uint8_t expected[] =
+    {
+        'R', 'L', 'E', 87, 0, 0, 0,
+        3, 0x00, 13, 0xFF, 1, 0x01, 0x40, 70, 0x02
+    };
+
+    // Runs which end within, exactly at and across 8 byte boundaries
+    memset(inbuf, 0x00, 3);
+    memset(inbuf + 3, 0xFF, 13);
+    memset(inbuf + 16, 0x01, 1);
+    memset(inbuf + 17, 0x02, 70);
+
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, sizeof(outbuf), &len,
+                                     &static_buf));
+    ASSERT_EQ(len, sizeof(expected));
+    ASSERT_EQ(0, memcmp(outbuf, expected, sizeof(expected)));
+}
+
+TEST(Test_RleCompressor, compress_decompress_mixed)
+{
+    static uint8_t inbuf[4096], outbuf[4096];
+    uint8_t* alloc_buf, *static_buf = outbuf;
+    size_t len, pos = 0;
+    unsigned int seed = 1;
+
+    // Runs of random length of random symbols
+    while (pos < sizeof(inbuf))
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t run = ((seed >> 8) % 40) + 1;
+        run = std::min(run, sizeof(inbuf) - pos);
+        memset(inbuf + pos, (seed >> 16) & 0x03, run);
+        pos += run;
+    }
+
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, 0, &len, &alloc_buf));
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_decompress(len, alloc_buf, sizeof(outbuf), &len,
+                                       &static_buf));
+    ASSERT_EQ(len, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(outbuf, inbuf, sizeof(inbuf)));
+    free(alloc_buf);
+}
+
+TEST(Test_RleCompressor, decompress_truncated)
+{
+    static uint8_t inbuf[1024], outbuf[1024];
+    uint8_t* alloc_buf, *static_buf = outbuf;
+    size_t len, olen;
+
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 100) & 0x01 ? (i & 0xFF) : 0x00;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, 0, &len, &alloc_buf));
+
+    // Every truncation must be detected, whether it cuts an encoded symbol or
+    // ends exactly at the boundary between two of them
+    for (size_t cut = 1; cut < len - 7; cut++)
+    {
+        ASSERT_EQ(OS_ERROR_ABORTED,
+                  RleCompressor_decompress(len - cut, alloc_buf, sizeof(outbuf),
+                                           &olen, &static_buf));
+    }
+
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_decompress(len, alloc_buf, sizeof(outbuf), &olen,
+                                       &static_buf));
+    ASSERT_EQ(olen, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(outbuf, inbuf, sizeof(inbuf)));
+    free(alloc_buf);
+}
+
+TEST(Test_RleCompressor, compress_stream)
+{
+    static uint8_t inbuf[4096], ref[8192], outbuf[8192];
+    uint8_t* static_buf = ref;
+    RleCompressor_CompressStream stream;
+    size_t len, pos = 0, opos = 0, iused, olen;
+    unsigned int seed = 7;
+
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 50) & 0x01 ? (i & 0x03) : 0xFF;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, sizeof(ref), &len,
+                                     &static_buf));
+
+    // Feed chunks of random size into output windows of random size, the
+    // result must be the same as the one of a single call
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_CompressStream_init(&stream, sizeof(inbuf)));
+    while (pos < sizeof(inbuf))
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t ilen = std::min((size_t) (seed >> 8) % 300, sizeof(inbuf) - pos);
+        size_t osz = (seed >> 20) % 9;
+        ASSERT_EQ(OS_SUCCESS,
+                  RleCompressor_CompressStream_update(&stream, ilen,
+                                                      inbuf + pos, &iused, osz,
+                                                      &olen, outbuf + opos));
+        ASSERT_LE(iused, ilen);
+        ASSERT_LE(olen, osz);
+        pos  += iused;
+        opos += olen;
+    }
+    // Too much input
+    ASSERT_EQ(OS_ERROR_INVALID_PARAMETER,
+              RleCompressor_CompressStream_update(&stream, 1, inbuf, &iused, 1,
+                                                  &olen, outbuf + opos));
+    while (RleCompressor_CompressStream_finish(&stream, 3, &olen,
+                                               outbuf + opos)
+           == OS_ERROR_BUFFER_TOO_SMALL)
+    {
+        opos += olen;
+    }
+    opos += olen;
+    ASSERT_EQ(opos, len);
+    ASSERT_EQ(0, memcmp(outbuf, ref, len));
+
+    // Not all the announced input was given
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_CompressStream_init(&stream, sizeof(inbuf)));
+    ASSERT_EQ(OS_ERROR_INVALID_STATE,
+              RleCompressor_CompressStream_finish(&stream, sizeof(outbuf),
+                                                  &olen, outbuf));
+}
+
+TEST(Test_RleCompressor, decompress_stream)
+{
+    static uint8_t inbuf[4096], outbuf[4096];
+    uint8_t* alloc_buf;
+    RleCompressor_DecompressStream stream;
+    size_t len, pos = 0, opos = 0, iused, olen;
+    unsigned int seed = 11;
+
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 70) & 0x01 ? (i & 0x07) : 0x00;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, 0, &len, &alloc_buf));
+
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_DecompressStream_init(&stream));
+    while (pos < len || opos < sizeof(inbuf))
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t ilen = std::min((size_t) (seed >> 8) % 5, len - pos);
+        size_t osz = std::min((size_t) (seed >> 16) % 100,
+                              sizeof(outbuf) - opos);
+        ASSERT_EQ(OS_SUCCESS,
+                  RleCompressor_DecompressStream_update(&stream, ilen,
+                                                        alloc_buf + pos,
+                                                        &iused, osz, &olen,
+                                                        outbuf + opos));
+        pos  += iused;
+        opos += olen;
+    }
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_DecompressStream_finish(&stream));
+    ASSERT_EQ(0, memcmp(outbuf, inbuf, sizeof(inbuf)));
+
+    // Truncated input
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_DecompressStream_init(&stream));
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_DecompressStream_update(&stream, len - 1, alloc_buf,
+                                                    &iused, sizeof(outbuf),
+                                                    &olen, outbuf));
+    ASSERT_EQ(OS_ERROR_ABORTED, RleCompressor_DecompressStream_finish(&stream));
+
+    // Wrong magic
+    alloc_buf[1] ^= 0xFF;
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_DecompressStream_init(&stream));
+    ASSERT_EQ(OS_ERROR_INVALID_STATE,
+              RleCompressor_DecompressStream_update(&stream, len, alloc_buf,
+                                                    &iused, sizeof(outbuf),
+                                                    &olen, outbuf));
+    free(alloc_buf);
+}
+
+TEST(Test_RleCompressor, get_sizes)
+{
+    static uint8_t inbuf[2048], outbuf[4096];
+    uint8_t* static_buf = outbuf;
+    size_t len, sz;
+
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 30) & 0x01 ? (i & 0xFF) : 0xAA;
+    }
+
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_getCompressedSize(sizeof(inbuf), inbuf, &sz));
+    // A buffer of exactly the computed size is enough
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, sz, &len,
+                                     &static_buf));
+    ASSERT_EQ(len, sz);
+    ASSERT_EQ(OS_ERROR_ABORTED,
+              RleCompressor_compress(sizeof(inbuf), inbuf, sz - 1, &len,
+                                     &static_buf));
+
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_getDecompressedSize(sz, outbuf, &len));
+    ASSERT_EQ(len, sizeof(inbuf));
+    ASSERT_EQ(OS_ERROR_BUFFER_TOO_SMALL,
+              RleCompressor_getDecompressedSize(6, outbuf, &len));
+    outbuf[0] ^= 0xFF;
+    ASSERT_EQ(OS_ERROR_INVALID_STATE,
+              RleCompressor_getDecompressedSize(sz, outbuf, &len));
+
+    ASSERT_EQ(OS_ERROR_INVALID_PARAMETER,
+              RleCompressor_getCompressedSize(sizeof(inbuf), NULL, &sz));
+    ASSERT_EQ(OS_ERROR_INVALID_PARAMETER,
+              RleCompressor_getDecompressedSize(sz, outbuf, NULL));
+}
+
+TEST(Test_RleCompressor, decompress_in_place)
+{
+    static uint8_t inbuf[2048], buf[4096];
+    uint8_t* alloc_buf;
+    size_t len, bsz, olen;
+
+    // Incompressible data first, so the output overtakes the input unless
+    // there is some extra room
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i < 500) ? (i & 0xFF) : 0x00;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compress(sizeof(inbuf), inbuf, 0, &len, &alloc_buf));
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_getInPlaceSize(len, alloc_buf, &bsz));
+    ASSERT_GE(bsz, sizeof(inbuf));
+    ASSERT_LE(bsz, sizeof(buf));
+
+    // One byte less must be refused without destroying the input
+    memcpy(buf + bsz - 1 - len, alloc_buf, len);
+    ASSERT_EQ(OS_ERROR_BUFFER_TOO_SMALL,
+              RleCompressor_decompressInPlace(bsz - 1, buf, len, &olen));
+    ASSERT_EQ(0, memcmp(buf + bsz - 1 - len, alloc_buf, len));
+
+    memcpy(buf + bsz - len, alloc_buf, len);
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_decompressInPlace(bsz, buf, len, &olen));
+    ASSERT_EQ(olen, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(buf, inbuf, sizeof(inbuf)));
+
+    // Truncated input is detected before anything is written
+    memcpy(buf + bsz - (len - 1), alloc_buf, len - 1);
+    ASSERT_EQ(OS_ERROR_ABORTED,
+              RleCompressor_decompressInPlace(bsz, buf, len - 1, &olen));
+    free(alloc_buf);
+}
+
+TEST(Test_RleCompressor, compress_v2)
+{
+    uint8_t inbuf[15] = {1, 2, 3}, outbuf[32];
+    uint8_t* static_buf = outbuf;
+    size_t len, sz;
+    const uint8_t expected[] =
+    {
+        'R', 'L', '2', 15, 0, 0, 0,
+        0x07, 1, 2, 3, 0x14, 0x00, 0x05, 5, 5
+    };
+
+    // Short runs go into literal runs, long ones are encoded as usual
+    inbuf[13] = inbuf[14] = 5;
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compressV2(sizeof(inbuf), inbuf, sizeof(outbuf),
+                                       &len, &static_buf));
+    ASSERT_EQ(len, sizeof(expected));
+    ASSERT_EQ(0, memcmp(outbuf, expected, sizeof(expected)));
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_getCompressedSizeV2(sizeof(inbuf), inbuf, &sz));
+    ASSERT_EQ(sz, len);
+    ASSERT_EQ(OS_ERROR_ABORTED,
+              RleCompressor_compressV2(sizeof(inbuf), inbuf, len - 1, &len,
+                                       &static_buf));
+}
+
+TEST(Test_RleCompressor, compress_decompress_v2)
+{
+    static uint8_t inbuf[4096], outbuf[4096], buf[8192];
+    uint8_t* alloc_buf, *static_buf = outbuf;
+    RleCompressor_DecompressStream stream;
+    size_t len, olen, bsz, pos = 0, opos = 0, iused;
+    unsigned int seed = 5;
+
+    // Incompressible data grows by the header and one length field only
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        inbuf[i] = seed >> 16;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compressV2(sizeof(inbuf), inbuf, 0, &len,
+                                       &alloc_buf));
+    ASSERT_LE(len, sizeof(inbuf) + 7 + 4);
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_decompress(len, alloc_buf, sizeof(outbuf), &olen,
+                                       &static_buf));
+    ASSERT_EQ(olen, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(outbuf, inbuf, sizeof(inbuf)));
+    free(alloc_buf);
+
+    // Mixed data, through all the decoders
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 100) & 0x01 ? (i & 0xFF) : (i / 13) & 0x01;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compressV2(sizeof(inbuf), inbuf, 0, &len,
+                                       &alloc_buf));
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_decompress(len, alloc_buf, 0, &olen, &static_buf));
+    ASSERT_EQ(olen, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(static_buf, inbuf, sizeof(inbuf)));
+    free(static_buf);
+    static_buf = outbuf;
+
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_getInPlaceSize(len, alloc_buf, &bsz));
+    ASSERT_LE(bsz, sizeof(buf));
+    memcpy(buf + bsz - len, alloc_buf, len);
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_decompressInPlace(bsz, buf, len, &olen));
+    ASSERT_EQ(olen, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(buf, inbuf, sizeof(inbuf)));
+
+    memset(outbuf, 0, sizeof(outbuf));
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_DecompressStream_init(&stream));
+    while (pos < len || opos < sizeof(inbuf))
+    {
+        seed = seed * 1103515245 + 12345;
+        size_t ilen = std::min((size_t) (seed >> 8) % 7, len - pos);
+        size_t osz = std::min((size_t) (seed >> 16) % 50,
+                              sizeof(outbuf) - opos);
+        ASSERT_EQ(OS_SUCCESS,
+                  RleCompressor_DecompressStream_update(&stream, ilen,
+                                                        alloc_buf + pos,
+                                                        &iused, osz, &olen,
+                                                        outbuf + opos));
+        pos  += iused;
+        opos += olen;
+    }
+    ASSERT_EQ(OS_SUCCESS, RleCompressor_DecompressStream_finish(&stream));
+    ASSERT_EQ(0, memcmp(outbuf, inbuf, sizeof(inbuf)));
+
+    // Truncation is detected by the v2 decoder too
+    for (size_t cut = 1; cut < len - 7; cut += 7)
+    {
+        ASSERT_EQ(OS_ERROR_ABORTED,
+                  RleCompressor_decompress(len - cut, alloc_buf, sizeof(outbuf),
+                                           &olen, &static_buf));
+    }
+    free(alloc_buf);
+}
+
+static OS_Error_t
+reverseRunner(void* pool, size_t n, RleCompressor_Job job, void* ctx)
+{
+    // Run the jobs backwards, blocks must not depend on each other
+    size_t* calls = (size_t*) pool;
+    OS_Error_t err = OS_SUCCESS;
+
+    for (size_t i = n; i > 0; i--)
+    {
+        OS_Error_t e = job(ctx, i - 1);
+        err = (err == OS_SUCCESS) ? e : err;
+        (*calls)++;
+    }
+    return err;
+}
+
+TEST(Test_RleCompressor, compress_decompress_blocks)
+{
+    static uint8_t inbuf[5000], outbuf[5000];
+    uint8_t* alloc_buf, *static_buf = outbuf, *block_buf;
+    size_t len, olen, calls = 0;
+
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 100) & 0x01 ? (i & 0xFF) : (i / 13) & 0x01;
+    }
+    // 5 blocks, the last one shorter; sizing and encoding are one job each
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compressBlocks(sizeof(inbuf), inbuf, 1024,
+                                           reverseRunner, &calls, 0, &len,
+                                           &alloc_buf));
+    ASSERT_EQ(calls, 10u);
+    ASSERT_EQ(0, memcmp(alloc_buf, "RLB", 3));
+
+    // The same data with the default runner, into a buffer of exact size
+    block_buf = (uint8_t*) malloc(len);
+    ASSERT_EQ(OS_ERROR_BUFFER_TOO_SMALL,
+              RleCompressor_compressBlocks(sizeof(inbuf), inbuf, 1024, NULL,
+                                           NULL, len - 1, &olen, &block_buf));
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compressBlocks(sizeof(inbuf), inbuf, 1024, NULL,
+                                           NULL, len, &olen, &block_buf));
+    ASSERT_EQ(olen, len);
+    ASSERT_EQ(0, memcmp(alloc_buf, block_buf, len));
+    free(block_buf);
+
+    calls = 0;
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_decompressBlocks(len, alloc_buf, reverseRunner,
+                                             &calls, sizeof(outbuf), &olen,
+                                             &static_buf));
+    ASSERT_EQ(calls, 5u);
+    ASSERT_EQ(olen, sizeof(inbuf));
+    ASSERT_EQ(0, memcmp(outbuf, inbuf, sizeof(inbuf)));
+
+    // Not a block framed buffer, or a truncated one
+    ASSERT_EQ(OS_ERROR_INVALID_PARAMETER,
+              RleCompressor_compressBlocks(sizeof(inbuf), inbuf, 0, NULL,
+                                           NULL, 0, &len, &block_buf));
+    ASSERT_EQ(OS_ERROR_ABORTED,
+              RleCompressor_decompressBlocks(len - 1, alloc_buf, NULL, NULL,
+                                             0, &olen, &block_buf));
+    alloc_buf[2] = 'E';
+    ASSERT_EQ(OS_ERROR_INVALID_STATE,
+              RleCompressor_decompressBlocks(len, alloc_buf, NULL, NULL, 0,
+                                             &olen, &block_buf));
+    free(alloc_buf);
+}
+
+TEST(Test_RleCompressor, decompress_blocks_at)
+{
+    static uint8_t inbuf[3000], outbuf[3001];
+    uint8_t* alloc_buf;
+    size_t len;
+    const size_t ranges[][2] =
+    {
+        {0, 1}, {0, 100}, {99, 2}, {250, 500}, {1234, 1766}, {2999, 1},
+        {0, 3000}, {500, 0}
+    };
+
+    for (size_t i = 0; i < sizeof(inbuf); i++)
+    {
+        inbuf[i] = (i / 37) & 0x01 ? (i & 0xFF) : (i / 29) & 0x03;
+    }
+    ASSERT_EQ(OS_SUCCESS,
+              RleCompressor_compressBlocks(sizeof(inbuf), inbuf, 100, NULL,
+                                           NULL, 0, &len, &alloc_buf));
+    for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+    {
+        memset(outbuf, 0xAA, sizeof(outbuf));
+        ASSERT_EQ(OS_SUCCESS,
+                  RleCompressor_decompressBlocksAt(len, alloc_buf, ranges[i][0],
+                                                   ranges[i][1], outbuf));
+        ASSERT_EQ(0, memcmp(outbuf, inbuf + ranges[i][0], ranges[i][1]));
+        ASSERT_EQ(0xAA, outbuf[ranges[i][1]]);
+    }
+    ASSERT_EQ(OS_ERROR_INVALID_PARAMETER,
+              RleCompressor_decompressBlocksAt(len, alloc_buf, 2999, 2,
+                                               outbuf));
+    free(alloc_buf);
+}
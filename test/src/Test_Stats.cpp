@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+extern "C"
+{
+#include "Test_StatsTypes.h"
+}
+
+/*----------------------------------------------------------------------------*/
+constexpr unsigned int kFifoSize = 10;
+
+// The counters track the high-water mark, the rejected and the dropped items
+TEST(Test_Stats, fifo)
+{
+    StatsCharFifo cf;
+    char fifoBuff[kFifoSize];
+
+    ASSERT_TRUE(StatsCharFifo_ctor(&cf, fifoBuff, kFifoSize));
+    FifoT_Stats stats = StatsCharFifo_getStats(&cf);
+    ASSERT_EQ(stats.highWaterMark, 0);
+    ASSERT_EQ(stats.rejected, 0);
+    ASSERT_EQ(stats.dropped, 0);
+
+    const char data[] = "0123456789abcdef";
+    ASSERT_EQ(StatsCharFifo_pushMany(&cf, data, 4), 4);
+    char out[1];
+    ASSERT_EQ(StatsCharFifo_popMany(&cf, out, 0), 0);
+    ASSERT_EQ(StatsCharFifo_dropFirst(&cf, 2), 2);
+    ASSERT_EQ(StatsCharFifo_getStats(&cf).highWaterMark, 4);
+
+    ASSERT_EQ(StatsCharFifo_pushMany(&cf, data, 16), kFifoSize - 2);
+    ASSERT_FALSE(StatsCharFifo_push(&cf, &data[0]));
+    stats = StatsCharFifo_getStats(&cf);
+    ASSERT_EQ(stats.highWaterMark, kFifoSize);
+    ASSERT_EQ(stats.rejected, 16 - (kFifoSize - 2) + 1);
+    ASSERT_EQ(stats.dropped, 0);
+
+    ASSERT_TRUE(StatsCharFifo_pushOverwrite(&cf, &data[0]));
+    ASSERT_EQ(StatsCharFifo_pushManyOverwrite(&cf, data, 16), 16);
+    ASSERT_EQ(StatsCharFifo_getStats(&cf).dropped, 1 + 16);
+
+    // clear() keeps the counters
+    StatsCharFifo_clear(&cf);
+    ASSERT_EQ(StatsCharFifo_getStats(&cf).highWaterMark, kFifoSize);
+    StatsCharFifo_dtor(&cf);
+}
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_Stats, vector)
+{
+    StatsVector v;
+
+    ASSERT_TRUE(StatsVector_ctor(&v, 1));
+    VectorT_Stats stats = StatsVector_getStats(&v);
+    ASSERT_EQ(stats.reallocations, 0);
+    ASSERT_EQ(stats.failedGrowths, 0);
+
+    // the capacity doubles, from 1 to 2, 4 and 8
+    for (Number i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(StatsVector_pushBack(&v, i));
+    }
+    ASSERT_EQ(StatsVector_getStats(&v).reallocations, 3);
+
+    ASSERT_TRUE(StatsVector_reserve(&v, 8));
+    ASSERT_EQ(StatsVector_getStats(&v).reallocations, 3);
+    ASSERT_TRUE(StatsVector_reserve(&v, 20));
+    ASSERT_TRUE(StatsVector_shrinkToFit(&v));
+    ASSERT_EQ(StatsVector_getStats(&v).reallocations, 5);
+    StatsVector_dtor(&v);
+
+    // a static vector can not grow
+    Number buffer[2];
+    ASSERT_TRUE(StatsVector_ctorStatic(&v, buffer, 2));
+    ASSERT_TRUE(StatsVector_pushBack(&v, 1));
+    ASSERT_TRUE(StatsVector_pushBack(&v, 2));
+    ASSERT_FALSE(StatsVector_pushBack(&v, 3));
+    stats = StatsVector_getStats(&v);
+    ASSERT_EQ(stats.reallocations, 0);
+    ASSERT_EQ(stats.failedGrowths, 1);
+    StatsVector_dtor(&v);
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_Stats_map : public testing::Test
+{
+protected:
+    StatsMap map;
+    StatsSortedMap sorted;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(StatsMap_ctor(&map, 8));
+        ASSERT_TRUE(StatsSortedMap_ctor(&sorted, 8));
+        for (Number k = 0; k < 8; k++)
+        {
+            ASSERT_TRUE(StatsMap_insert(&map, &k, &k));
+            ASSERT_TRUE(StatsSortedMap_insert(&sorted, &k, &k));
+        }
+    }
+
+    void TearDown() override
+    {
+        StatsMap_dtor(&map);
+        StatsSortedMap_dtor(&sorted);
+    }
+};
+
+TEST_F(Test_Stats_map, lookups)
+{
+    MapT_Stats before = StatsMap_getStats(&map);
+    Number k = 3;
+    ASSERT_EQ(3, StatsMap_getIndexOf(&map, &k));
+    k = 8;
+    ASSERT_EQ(-1, StatsMap_getIndexOf(&map, &k));
+
+    // the hit compares 4 keys, the miss all of them
+    MapT_Stats stats = StatsMap_getStats(&map);
+    ASSERT_EQ(before.lookups + 2, stats.lookups);
+    ASSERT_EQ(before.misses + 1, stats.misses);
+    ASSERT_EQ(before.probes + 4 + 8, stats.probes);
+    ASSERT_EQ(8, stats.maxProbe);
+}
+
+TEST_F(Test_Stats_map, sorted_lookups)
+{
+    MapT_Stats before = StatsSortedMap_getStats(&sorted);
+    Number k = 3;
+    ASSERT_EQ(3, StatsSortedMap_getIndexOf(&sorted, &k));
+    k = -1;
+    ASSERT_EQ(-1, StatsSortedMap_getIndexOf(&sorted, &k));
+
+    // a binary search of 8 keys is 4 levels deep
+    MapT_Stats stats = StatsSortedMap_getStats(&sorted);
+    ASSERT_EQ(before.lookups + 2, stats.lookups);
+    ASSERT_EQ(before.misses + 1, stats.misses);
+    ASSERT_EQ(before.probes + 2 * 4, stats.probes);
+    ASSERT_EQ(4, stats.maxProbe);
+}
+
+// The lookups take a const map, concurrent ones must not lose any count
+TEST_F(Test_Stats_map, concurrent_lookups)
+{
+    constexpr int kThreads = 4;
+    constexpr int kLookups = 10000;
+    MapT_Stats before = StatsMap_getStats(&map);
+    StatsMap const* constMap = &map;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([constMap, t]()
+        {
+            for (int i = 0; i < kLookups; i++)
+            {
+                // thread 0 looks up the last key, it has the longest lookup
+                Number k = (t == 0) ? 7 : (i % 9);
+                StatsMap_getIndexOf(constMap, &k);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    MapT_Stats stats = StatsMap_getStats(&map);
+    ASSERT_EQ(before.lookups + kThreads * kLookups, stats.lookups);
+    ASSERT_EQ(8, stats.maxProbe);
+}
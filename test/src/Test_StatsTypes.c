@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Test_StatsTypes.h"
+
+static void
+char_dtor(char* c)
+{
+    (void) c;
+}
+
+static bool
+char_ctorCopy(char* target, char const* source)
+{
+    *target = *source;
+    return true;
+}
+
+void
+Number_dtor(Number* el)
+{
+    (void) el;
+}
+
+bool
+Number_ctorCopy(Number* dst, Number const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Number_ctorMove(Number* dst, Number const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Number_assign(Number* dst, Number const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Number_isEqual(Number const* a, Number const* b)
+{
+    return (*a == *b);
+}
+
+int
+Number_compare(Number const* a, Number const* b)
+{
+    return (*a > *b) - (*a < *b);
+}
+
+FifoT_DEFINE_TRIVIAL(char, StatsCharFifo, size_t)
+
+VectorT_DEFINE(Number, StatsVector, size_t)
+
+MapT_DEFINE(Number, Number, StatsMap)
+MapT_DEFINE_SORTED(Number, Number, StatsSortedMap)
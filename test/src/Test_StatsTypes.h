@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/*
+ * Instances of the container templates with the LIB_UTILS_STATS counters,
+ * whether the library is built with them or not. They are defined in
+ * Test_StatsTypes.c, a translation unit which must not include Test_Types.h:
+ * the containers of both headers share the template headers, which only see
+ * the first definition of LIB_UTILS_STATS.
+ */
+
+#pragma once
+
+#if !defined(LIB_UTILS_STATS)
+#   define LIB_UTILS_STATS
+#endif
+
+#include "lib_utils/VectorT.h"
+#include "lib_utils/MapT.h"
+#include "lib_utils/FifoT.h"
+
+#include <stdint.h>
+
+/*
+ * The element type of the vector and the maps. Pointer would do, but the
+ * PointerVector of its header would then have a different layout than the
+ * one of the library when it is built without the counters.
+ */
+typedef intptr_t Number;
+
+void Number_dtor(Number* el);
+bool Number_ctorCopy(Number* dst, Number const* src);
+bool Number_ctorMove(Number* dst, Number const* src);
+bool Number_assign(Number* dst, Number const* src);
+bool Number_isEqual(Number const* a, Number const* b);
+int Number_compare(Number const* a, Number const* b);
+
+typedef
+FifoT_TYPE(char, size_t)
+StatsCharFifo;
+
+FifoT_DECLARE(char, StatsCharFifo, size_t);
+
+VectorT_DECLARE(Number, StatsVector, size_t);
+
+MapT_DECLARE(Number, Number, StatsMap);
+MapT_DECLARE_SORTED(Number, Number, StatsSortedMap);
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include "Test_Types.h"
+
+static void
+char_dtor(char* c)
+{
+    (void) c;
+}
+
+static bool
+char_ctorCopy(char* target, char const* source)
+{
+    *target = *source;
+    return true;
+}
+
+void
+Collider_dtor(Collider* el)
+{
+    (void) el;
+}
+
+bool
+Collider_ctorCopy(Collider* dst, Collider const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Collider_ctorMove(Collider* dst, Collider const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Collider_assign(Collider* dst, Collider const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Collider_isEqual(Collider const* a, Collider const* b)
+{
+    return (*a == *b);
+}
+
+uint32_t
+Collider_hash(Collider const* key)
+{
+    return (uint32_t) (*key & 3);
+}
+
+int Counted_live = 0;
+
+void
+Counted_dtor(Counted* el)
+{
+    (void) el;
+    Counted_live--;
+}
+
+bool
+Counted_ctorCopy(Counted* dst, Counted const* src)
+{
+    *dst = *src;
+    Counted_live++;
+    return true;
+}
+
+bool
+Counted_ctorMove(Counted* dst, Counted const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Counted_assign(Counted* dst, Counted const* src)
+{
+    *dst = *src;
+    return true;
+}
+
+bool
+Counted_isEqual(Counted const* a, Counted const* b)
+{
+    return (a->value == b->value);
+}
+
+VectorT_DEFINE(Counted, CountedVector, size_t);
+VectorT_DEFINE_FIXED(Counted, CountedFixedVector, uint8_t)
+VectorT_DEFINE_FIXED_TRIVIAL(Pointer, PointerFixedVector, int)
+
+MapT_DEFINE(Pointer, Pointer, PointerMap)
+MapT_DEFINE_HASHED(Pointer, Pointer, PointerHashedMap)
+MapT_DEFINE_SORTED(Pointer, Pointer, PointerSortedMap)
+MapT_DEFINE_SOA(Pointer, Counted, PointerSoaMap)
+MapT_DEFINE_SOA_INTKEY(Pointer, Pointer, PointerIntKeyMap)
+MapT_DEFINE_SOA(Counted, Pointer, CountedSoaMap)
+
+ObjectPoolT_DEFINE(Pointer, PointerPool, size_t)
+MapT_DEFINE_HASHED(Collider, Pointer, ColliderMap)
+
+FifoT_DEFINE_POW2(char, CharPow2Fifo, uint8_t)
+FifoT_DEFINE_FIXED_TRIVIAL(char, CharFixedFifo8, uint8_t)
+FifoT_DEFINE_FIXED(char, CharFixedFifo5, uint8_t)
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+/*
+ * Instances of the container templates for the unit tests. The templates are
+ * C only, so they are defined in Test_Types.c and the tests use them through
+ * these declarations.
+ */
+
+#pragma once
+
+#include "lib_utils/PointerVector.h"
+#include "lib_utils/MapT.h"
+#include "lib_utils/FifoT.h"
+#include "lib_utils/ObjectPoolT.h"
+
+#include <stdint.h>
+
+// A key with four different hashes only, it makes most of the keys collide
+typedef intptr_t Collider;
+
+void Collider_dtor(Collider* el);
+bool Collider_ctorCopy(Collider* dst, Collider const* src);
+bool Collider_ctorMove(Collider* dst, Collider const* src);
+bool Collider_assign(Collider* dst, Collider const* src);
+bool Collider_isEqual(Collider const* a, Collider const* b);
+uint32_t Collider_hash(Collider const* key);
+
+// An element which counts its live instances, moved-from ones do not count
+typedef struct
+{
+    int value;
+}
+Counted;
+
+extern int Counted_live;
+
+void Counted_dtor(Counted* el);
+bool Counted_ctorCopy(Counted* dst, Counted const* src);
+bool Counted_ctorMove(Counted* dst, Counted const* src);
+bool Counted_assign(Counted* dst, Counted const* src);
+bool Counted_isEqual(Counted const* a, Counted const* b);
+
+VectorT_DECLARE(Counted, CountedVector, size_t);
+VectorT_DECLARE_FIXED(Counted, CountedFixedVector, uint8_t, 3);
+// A signed SIZE_T, the compares with the capacity must not warn
+VectorT_DECLARE_FIXED(Pointer, PointerFixedVector, int, 4);
+
+MapT_DECLARE(Pointer, Pointer, PointerMap);
+MapT_DECLARE_HASHED(Pointer, Pointer, PointerHashedMap);
+MapT_DECLARE_SORTED(Pointer, Pointer, PointerSortedMap);
+MapT_DECLARE_SOA(Pointer, Counted, PointerSoaMap);
+MapT_DECLARE_SOA(Pointer, Pointer, PointerIntKeyMap);
+// The keys are smaller than the alignment of the values
+MapT_DECLARE_SOA(Counted, Pointer, CountedSoaMap);
+
+ObjectPoolT_DECLARE(Pointer, PointerPool, size_t);
+MapT_DECLARE_HASHED(Collider, Pointer, ColliderMap);
+
+// The 8 bit counters of this fifo wrap around after 256 pushes
+typedef
+FifoT_TYPE(char, uint8_t)
+CharPow2Fifo;
+
+FifoT_DECLARE(char, CharPow2Fifo, uint8_t);
+
+// The fixed fifos wrap with a mask, and with a compare
+typedef
+FifoT_TYPE_FIXED(char, uint8_t, 8)
+CharFixedFifo8;
+
+FifoT_DECLARE_FIXED(char, CharFixedFifo8, uint8_t);
+
+typedef
+FifoT_TYPE_FIXED(char, uint8_t, 5)
+CharFixedFifo5;
+
+FifoT_DECLARE_FIXED(char, CharFixedFifo5, uint8_t);
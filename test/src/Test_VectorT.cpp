@@ -0,0 +1,518 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C"
+{
+#include "Test_Types.h"
+}
+
+constexpr int kNumElements = 100;
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_PointerVector, growth_relocates_elements)
+{
+    PointerVector v;
+
+    ASSERT_TRUE(PointerVector_ctor(&v, 1));
+    Pointer const* first = PointerVector_getData(&v);
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i * 10));
+        ASSERT_EQ((size_t) i + 1, PointerVector_getSize(&v));
+    }
+    // the default growth doubles the capacity: 1, 2, 4, ..., 128
+    ASSERT_EQ(128, v.size_);
+    ASSERT_NE(first, PointerVector_getData(&v));
+
+    for (int i = 0; i < kNumElements; i++)
+    {
+        ASSERT_EQ(i * 10, PointerVector_getElementAt(&v, i));
+    }
+    PointerVector_dtor(&v);
+}
+
+TEST(Test_PointerVector, copy_ctor)
+{
+    PointerVector v;
+    PointerVector copy;
+
+    ASSERT_TRUE(PointerVector_ctor(&v, 4));
+    for (int i = 0; i < kNumElements; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i));
+    }
+    ASSERT_TRUE(PointerVector_ctorCopy(&copy, &v));
+    ASSERT_EQ(PointerVector_getSize(&v), PointerVector_getSize(&copy));
+    ASSERT_NE(PointerVector_getData(&v), PointerVector_getData(&copy));
+    for (int i = 0; i < kNumElements; i++)
+    {
+        ASSERT_EQ(i, PointerVector_getElementAt(&copy, i));
+    }
+
+    // the copy is independent of the original
+    ASSERT_TRUE(PointerVector_replaceElementAt(&v, 0, -1));
+    PointerVector_popBack(&v);
+    ASSERT_EQ(0, PointerVector_getElementAt(&copy, 0));
+    ASSERT_EQ((size_t) kNumElements, PointerVector_getSize(&copy));
+    ASSERT_TRUE(PointerVector_pushBack(&copy, kNumElements));
+    ASSERT_EQ(kNumElements, PointerVector_getBack(&copy));
+    PointerVector_dtor(&v);
+    PointerVector_dtor(&copy);
+}
+
+TEST(Test_PointerVector, copy_ctor_of_static)
+{
+    Pointer buffer[8];
+    PointerVector v;
+    PointerVector copy;
+
+    ASSERT_TRUE(PointerVector_ctorStatic(&v, buffer, 8));
+    for (int i = 0; i < 8; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i));
+    }
+    ASSERT_FALSE(PointerVector_pushBack(&v, 8));
+
+    // the copy allocates its own buffer and can grow
+    ASSERT_TRUE(PointerVector_ctorCopy(&copy, &v));
+    ASSERT_NE(PointerVector_getData(&v), PointerVector_getData(&copy));
+    ASSERT_TRUE(PointerVector_pushBack(&copy, 8));
+    for (int i = 0; i < 9; i++)
+    {
+        ASSERT_EQ(i, PointerVector_getElementAt(&copy, i));
+    }
+    PointerVector_dtor(&v);
+    PointerVector_dtor(&copy);
+}
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_PointerVector, reserve)
+{
+    PointerVector v;
+
+    ASSERT_TRUE(PointerVector_ctor(&v, 2));
+    ASSERT_TRUE(PointerVector_pushBack(&v, 1));
+    ASSERT_TRUE(PointerVector_reserve(&v, 1));
+    ASSERT_EQ(2, v.size_);
+
+    ASSERT_TRUE(PointerVector_reserve(&v, 50));
+    ASSERT_EQ(50, v.size_);
+    Pointer const* data = PointerVector_getData(&v);
+    for (int i = 1; i < 50; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, 1));
+    }
+    // no reallocation up to the reserved size
+    ASSERT_EQ(data, PointerVector_getData(&v));
+    ASSERT_EQ(50, v.size_);
+    PointerVector_dtor(&v);
+}
+
+TEST(Test_PointerVector, reserve_static)
+{
+    Pointer buffer[8];
+    PointerVector v;
+
+    ASSERT_TRUE(PointerVector_ctorStatic(&v, buffer, 8));
+    ASSERT_TRUE(PointerVector_pushBack(&v, 1));
+    ASSERT_TRUE(PointerVector_reserve(&v, 8));
+    ASSERT_FALSE(PointerVector_reserve(&v, 9));
+    ASSERT_EQ(buffer, PointerVector_getData(&v));
+    ASSERT_EQ(8, v.size_);
+    ASSERT_EQ(1, PointerVector_getSize(&v));
+    PointerVector_dtor(&v);
+}
+
+TEST(Test_PointerVector, shrinkToFit)
+{
+    PointerVector v;
+
+    ASSERT_TRUE(PointerVector_ctor(&v, 16));
+    ASSERT_TRUE(PointerVector_shrinkToFit(&v));
+    // an empty vector keeps room for one element
+    ASSERT_EQ(1, v.size_);
+
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i));
+    }
+    ASSERT_TRUE(PointerVector_shrinkToFit(&v));
+    ASSERT_EQ(5, v.size_);
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(i, PointerVector_getElementAt(&v, i));
+    }
+    ASSERT_TRUE(PointerVector_pushBack(&v, 5));
+    PointerVector_dtor(&v);
+}
+
+TEST(Test_PointerVector, shrinkToFit_static)
+{
+    Pointer buffer[8];
+    PointerVector v;
+
+    // not applicable, the buffer is left as it is
+    ASSERT_TRUE(PointerVector_ctorStatic(&v, buffer, 8));
+    ASSERT_TRUE(PointerVector_pushBack(&v, 1));
+    ASSERT_TRUE(PointerVector_shrinkToFit(&v));
+    ASSERT_EQ(buffer, PointerVector_getData(&v));
+    ASSERT_EQ(8, v.size_);
+    PointerVector_dtor(&v);
+}
+
+TEST(Test_PointerVector, setGrowth)
+{
+    PointerVector v;
+
+    ASSERT_TRUE(PointerVector_ctor(&v, 4));
+
+    // factor 1.5: 4, 6, 9
+    PointerVector_setGrowth(&v, 50, 0);
+    for (int i = 0; i < 7; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i));
+    }
+    ASSERT_EQ(9, v.size_);
+
+    // fixed increment: 9, 12
+    PointerVector_setGrowth(&v, 0, 3);
+    for (int i = 7; i < 10; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i));
+    }
+    ASSERT_EQ(12, v.size_);
+
+    // no growth configured still adds one element
+    PointerVector_setGrowth(&v, 0, 0);
+    for (int i = 10; i < 13; i++)
+    {
+        ASSERT_TRUE(PointerVector_pushBack(&v, i));
+    }
+    ASSERT_EQ(13, v.size_);
+
+    for (int i = 0; i < 13; i++)
+    {
+        ASSERT_EQ(i, PointerVector_getElementAt(&v, i));
+    }
+    PointerVector_dtor(&v);
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_CountedVector : public testing::Test
+{
+protected:
+    CountedVector v;
+
+    void SetUp() override
+    {
+        Counted_live = 0;
+        ASSERT_TRUE(CountedVector_ctor(&v, 2));
+    }
+
+    void TearDown() override
+    {
+        CountedVector_dtor(&v);
+        ASSERT_EQ(0, Counted_live);
+    }
+
+    void push(int value)
+    {
+        Counted c = { value };
+        ASSERT_TRUE(CountedVector_pushBackByPtr(&v, &c));
+    }
+};
+
+TEST_F(Test_CountedVector, emplaceBack)
+{
+    push(0);
+    for (int i = 1; i < 10; i++)
+    {
+        // the storage is handed out uninitialized and constructed in place
+        Counted c = { i };
+        Counted* slot = CountedVector_emplaceBack(&v);
+        ASSERT_NE(nullptr, slot);
+        ASSERT_TRUE(Counted_ctorCopy(slot, &c));
+    }
+    ASSERT_EQ(10, CountedVector_getSize(&v));
+    ASSERT_EQ(10, Counted_live);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(i, CountedVector_getPtrToElementAt(&v, i)->value);
+    }
+}
+
+TEST_F(Test_CountedVector, emplaceBack_static_full)
+{
+    Counted buffer[2];
+    CountedVector s;
+
+    ASSERT_TRUE(CountedVector_ctorStatic(&s, buffer, 2));
+    ASSERT_NE(nullptr, CountedVector_emplaceBack(&s));
+    ASSERT_NE(nullptr, CountedVector_emplaceBack(&s));
+    ASSERT_EQ(nullptr, CountedVector_emplaceBack(&s));
+    ASSERT_EQ(2, CountedVector_getSize(&s));
+    // nothing has been constructed, drop the slots without destroying them
+    CountedVector_cancelEmplace(&s);
+    CountedVector_cancelEmplace(&s);
+    ASSERT_TRUE(CountedVector_isEmpty(&s));
+    CountedVector_dtor(&s);
+}
+
+TEST_F(Test_CountedVector, cancelEmplace)
+{
+    push(1);
+    push(2);
+
+    Counted* slot = CountedVector_emplaceBack(&v);
+    ASSERT_NE(nullptr, slot);
+    ASSERT_EQ(3, CountedVector_getSize(&v));
+
+    // the construction failed, the slot is dropped without a dtor call
+    CountedVector_cancelEmplace(&v);
+    ASSERT_EQ(2, CountedVector_getSize(&v));
+    ASSERT_EQ(2, Counted_live);
+    ASSERT_EQ(2, CountedVector_getPtrToElementAt(&v, 1)->value);
+
+    // the next element goes into the same slot
+    push(3);
+    ASSERT_EQ(3, CountedVector_getPtrToElementAt(&v, 2)->value);
+}
+
+TEST_F(Test_CountedVector, removeAtSwap)
+{
+    for (int i = 0; i < 5; i++)
+    {
+        push(i);
+    }
+
+    // the last element moves into the hole
+    CountedVector_removeAtSwap(&v, 1);
+    ASSERT_EQ(4, CountedVector_getSize(&v));
+    ASSERT_EQ(4, Counted_live);
+    ASSERT_EQ(0, CountedVector_getPtrToElementAt(&v, 0)->value);
+    ASSERT_EQ(4, CountedVector_getPtrToElementAt(&v, 1)->value);
+    ASSERT_EQ(2, CountedVector_getPtrToElementAt(&v, 2)->value);
+    ASSERT_EQ(3, CountedVector_getPtrToElementAt(&v, 3)->value);
+
+    // removing the last element does not move anything
+    CountedVector_removeAtSwap(&v, 3);
+    ASSERT_EQ(3, CountedVector_getSize(&v));
+    ASSERT_EQ(3, Counted_live);
+    ASSERT_EQ(2, CountedVector_getPtrToElementAt(&v, 2)->value);
+
+    while (!CountedVector_isEmpty(&v))
+    {
+        CountedVector_removeAtSwap(&v, 0);
+    }
+    ASSERT_EQ(0, Counted_live);
+}
+
+/*----------------------------------------------------------------------------*/
+// Records the visited positions, stops after 'stopAt' has been visited
+struct Visits
+{
+    std::vector<size_t> pos;
+    size_t stopAt = SIZE_MAX;
+};
+
+static bool
+visit(void* context, Pointer const* element, size_t pos)
+{
+    Visits* visits = static_cast<Visits*>(context);
+    EXPECT_EQ((Pointer) pos * 10, *element);
+    visits->pos.push_back(pos);
+    return pos != visits->stopAt;
+}
+
+static bool
+triple(void* context, Pointer* element, size_t pos)
+{
+    (void) context;
+    (void) pos;
+    *element *= 3;
+    return true;
+}
+
+class Test_PointerVector_apply : public testing::Test
+{
+protected:
+    PointerVector v;
+
+    void SetUp() override
+    {
+        ASSERT_TRUE(PointerVector_ctor(&v, 4));
+        for (int i = 0; i < 10; i++)
+        {
+            ASSERT_TRUE(PointerVector_pushBack(&v, i * 10));
+        }
+    }
+
+    void TearDown() override
+    {
+        PointerVector_dtor(&v);
+    }
+};
+
+TEST_F(Test_PointerVector_apply, getData)
+{
+    Pointer const* data = PointerVector_getData(&v);
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(i * 10, data[i]);
+    }
+    PointerVector_getMutData(&v)[3] = -1;
+    ASSERT_EQ(-1, PointerVector_getElementAt(&v, 3));
+    ASSERT_EQ(data, PointerVector_getMutData(&v));
+}
+
+TEST_F(Test_PointerVector_apply, constApply)
+{
+    Visits visits;
+
+    ASSERT_EQ(10, PointerVector_constApply(&v, visit, &visits));
+    ASSERT_EQ(10, visits.pos.size());
+    for (size_t i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(i, visits.pos[i]);
+    }
+}
+
+TEST_F(Test_PointerVector_apply, early_stop)
+{
+    Visits visits;
+
+    // the element which stops the iteration is counted
+    visits.stopAt = 4;
+    ASSERT_EQ(5, PointerVector_constApply(&v, visit, &visits));
+    ASSERT_EQ(5, visits.pos.size());
+
+    visits.pos.clear();
+    visits.stopAt = 6;
+    ASSERT_EQ(2, PointerVector_constApplyRange(&v, 5, 9, visit, &visits));
+    ASSERT_EQ(std::vector<size_t>({ 5, 6 }), visits.pos);
+}
+
+TEST_F(Test_PointerVector_apply, ranges)
+{
+    Visits visits;
+
+    ASSERT_EQ(3, PointerVector_constApplyRange(&v, 2, 5, visit, &visits));
+    ASSERT_EQ(std::vector<size_t>({ 2, 3, 4 }), visits.pos);
+
+    // empty and inverted ranges process nothing
+    visits.pos.clear();
+    ASSERT_EQ(0, PointerVector_constApplyRange(&v, 3, 3, visit, &visits));
+    ASSERT_EQ(0, PointerVector_constApplyRange(&v, 10, 10, visit, &visits));
+    ASSERT_EQ(0, PointerVector_constApplyRange(&v, 5, 2, visit, &visits));
+    ASSERT_EQ(0, PointerVector_applyRange(&v, 5, 2, triple, NULL));
+    ASSERT_TRUE(visits.pos.empty());
+
+    ASSERT_EQ(1, PointerVector_constApplyRange(&v, 9, 10, visit, &visits));
+    ASSERT_EQ(std::vector<size_t>({ 9 }), visits.pos);
+}
+
+TEST_F(Test_PointerVector_apply, mutation)
+{
+    ASSERT_EQ(3, PointerVector_applyRange(&v, 1, 4, triple, NULL));
+    for (int i = 0; i < 10; i++)
+    {
+        ASSERT_EQ(i * 10 * ((i >= 1 && i < 4) ? 3 : 1),
+                  PointerVector_getElementAt(&v, i));
+    }
+    ASSERT_EQ(10, PointerVector_apply(&v, triple, NULL));
+    ASSERT_EQ(90 * 3, PointerVector_getElementAt(&v, 9));
+    ASSERT_EQ(10 * 9, PointerVector_getElementAt(&v, 1));
+}
+
+/*----------------------------------------------------------------------------*/
+TEST(Test_PointerFixedVector, push_until_full)
+{
+    PointerFixedVector v;
+
+    PointerFixedVector_ctor(&v);
+    ASSERT_EQ(4, PointerFixedVector_getCapacity(&v));
+    ASSERT_TRUE(PointerFixedVector_isEmpty(&v));
+    for (Pointer i = 0; i < 4; i++)
+    {
+        ASSERT_FALSE(PointerFixedVector_isFull(&v));
+        ASSERT_TRUE(PointerFixedVector_pushBack(&v, i * 10));
+    }
+    ASSERT_TRUE(PointerFixedVector_isFull(&v));
+    ASSERT_FALSE(PointerFixedVector_resizeIfNeeded(&v));
+    ASSERT_FALSE(PointerFixedVector_pushBack(&v, 40));
+    ASSERT_EQ(NULL, PointerFixedVector_emplaceBack(&v));
+    ASSERT_EQ(4, PointerFixedVector_getSize(&v));
+    ASSERT_EQ(v.vector_, PointerFixedVector_getData(&v));
+
+    // a removal makes room again
+    PointerFixedVector_removeAtSwap(&v, 0);
+    ASSERT_EQ(30, PointerFixedVector_getFront(&v));
+    ASSERT_TRUE(PointerFixedVector_pushBack(&v, 40));
+    ASSERT_EQ(40, PointerFixedVector_getBack(&v));
+
+    PointerFixedVector copy;
+    ASSERT_TRUE(PointerFixedVector_ctorCopy(&copy, &v));
+    ASSERT_EQ(4, PointerFixedVector_getSize(&copy));
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(PointerFixedVector_getElementAt(&v, i),
+                  PointerFixedVector_getElementAt(&copy, i));
+    }
+    PointerFixedVector_dtor(&copy);
+    PointerFixedVector_dtor(&v);
+}
+
+TEST(Test_PointerFixedVector, zero_initialized)
+{
+    // static storage is zero initialized, the vector is usable without ctor()
+    static PointerFixedVector zeroed;
+
+    ASSERT_TRUE(PointerFixedVector_isEmpty(&zeroed));
+    for (Pointer i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(PointerFixedVector_pushBack(&zeroed, i));
+    }
+    ASSERT_TRUE(PointerFixedVector_isFull(&zeroed));
+    ASSERT_EQ(3, PointerFixedVector_getElementAt(&zeroed, 3));
+    PointerFixedVector_dtor(&zeroed);
+    ASSERT_TRUE(PointerFixedVector_isEmpty(&zeroed));
+}
+
+TEST(Test_CountedFixedVector, lifetimes)
+{
+    CountedFixedVector v;
+    Counted c = { 0 };
+
+    Counted_live = 0;
+    CountedFixedVector_ctor(&v);
+    for (c.value = 0; c.value < 3; c.value++)
+    {
+        ASSERT_TRUE(CountedFixedVector_pushBackByPtr(&v, &c));
+    }
+    // an element not pushed is not constructed
+    ASSERT_FALSE(CountedFixedVector_pushBackByPtr(&v, &c));
+    ASSERT_EQ(3, Counted_live);
+
+    CountedFixedVector copy;
+    ASSERT_TRUE(CountedFixedVector_ctorCopy(&copy, &v));
+    ASSERT_EQ(6, Counted_live);
+    // the element is returned as a copy, which the caller destroys
+    Counted back = CountedFixedVector_getBack(&copy);
+    ASSERT_EQ(2, back.value);
+    Counted_dtor(&back);
+
+    CountedFixedVector_popBack(&v);
+    ASSERT_EQ(5, Counted_live);
+    CountedFixedVector_dtor(&copy);
+    CountedFixedVector_dtor(&v);
+    ASSERT_EQ(0, Counted_live);
+}
@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2024, HENSOLDT Cyber GmbH
+ * 
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * For commercial licensing, contact: info.cyber@hensoldt.net
+ */
+
+#include <gtest/gtest.h>
+
+extern "C"
+{
+#include "lib_utils/managedBuffer.h"
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_managedBufferChain : public testing::Test
+{
+protected:
+    static constexpr size_t kNumSegments = 4;
+
+    managedBuffer_t segments[kNumSegments];
+    managedBufferChain_t chain;
+    uint8_t space1[8];
+    uint8_t space2[8];
+
+    void SetUp() override
+    {
+        managedBufferChain_init(&chain, segments, kNumSegments);
+    }
+
+    // the data of the chain in order, as a contiguous array
+    std::vector<uint8_t> flatten()
+    {
+        managedBuffer_iovec_t iov[kNumSegments];
+        std::vector<uint8_t> data;
+        int n = managedBufferChain_getIovec(&chain, iov, kNumSegments);
+
+        for (int i = 0; i < n; i++)
+        {
+            const uint8_t* base = (const uint8_t*) iov[i].base;
+            data.insert(data.end(), base, base + iov[i].len);
+        }
+        return data;
+    }
+};
+
+TEST_F(Test_managedBufferChain, addSpace)
+{
+    uint8_t more[4];
+
+    ASSERT_EQ(0u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space2, sizeof(space2)));
+    ASSERT_EQ(16u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, more, sizeof(more)));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, more, sizeof(more)));
+
+    // all the segments are in use
+    ASSERT_EQ(-1, managedBufferChain_addSpace(&chain, more, sizeof(more)));
+    ASSERT_EQ(kNumSegments, chain.usedSegments);
+    ASSERT_EQ(24u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(0u, managedBufferChain_getUsedLen(&chain));
+}
+
+TEST_F(Test_managedBufferChain, append_across_segments)
+{
+    const uint8_t data[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space2, sizeof(space2)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, data, 5));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, data + 5, 7));
+    ASSERT_EQ(12u, managedBufferChain_getUsedLen(&chain));
+    ASSERT_EQ(4u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(8u, segments[0].usedLen);
+    ASSERT_EQ(4u, segments[1].usedLen);
+    ASSERT_EQ(std::vector<uint8_t>(data, data + 12), flatten());
+}
+
+TEST_F(Test_managedBufferChain, append_overflow)
+{
+    const uint8_t data[17] = { 0 };
+
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space2, sizeof(space2)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, data, 3));
+
+    // all or nothing, a failed append leaves the chain unchanged
+    ASSERT_EQ(-1, managedBufferChain_append(&chain, data, 14));
+    ASSERT_EQ(3u, managedBufferChain_getUsedLen(&chain));
+    ASSERT_EQ(13u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, data, 13));
+
+    // the chain is full
+    ASSERT_EQ(0u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(-1, managedBufferChain_append(&chain, data, 1));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, data, 0));
+    ASSERT_EQ(16u, managedBufferChain_getUsedLen(&chain));
+}
+
+TEST_F(Test_managedBufferChain, appendRef_splits_segment)
+{
+    const uint8_t head[] = { 1, 2, 3 };
+    const uint8_t ref[] = { 4, 5, 6, 7 };
+    const uint8_t tail[] = { 8, 9, 10, 11, 12, 13 };
+
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, head, sizeof(head)));
+
+    // the free part of the segment is split off and follows the reference
+    ASSERT_EQ(0, managedBufferChain_appendRef(&chain, ref, sizeof(ref)));
+    ASSERT_EQ(3u, chain.usedSegments);
+    ASSERT_EQ(ref, segments[1].buffer);
+    ASSERT_EQ(&space1[3], segments[2].buffer);
+    ASSERT_EQ(5u, managedBufferChain_getFreeSpace(&chain));
+    ASSERT_EQ(7u, managedBufferChain_getUsedLen(&chain));
+
+    // the data after the reference fills the split off space, the rest
+    // goes into the next segment
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space2, sizeof(space2)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, tail, sizeof(tail)));
+    ASSERT_EQ(13u, managedBufferChain_getUsedLen(&chain));
+
+    const uint8_t expected[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13 };
+    ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)),
+              flatten());
+    // the reference is not copied
+    ASSERT_EQ(0, memcmp(&space1[3], tail, 5));
+}
+
+TEST_F(Test_managedBufferChain, appendRef_in_front_of_empty_segment)
+{
+    const uint8_t ref[] = { 1, 2 };
+    const uint8_t tail[] = { 3 };
+
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_appendRef(&chain, ref, sizeof(ref)));
+    ASSERT_EQ(2u, chain.usedSegments);
+    ASSERT_EQ(ref, segments[0].buffer);
+    ASSERT_EQ(space1, segments[1].buffer);
+    ASSERT_EQ(0, managedBufferChain_append(&chain, tail, sizeof(tail)));
+
+    const uint8_t expected[] = { 1, 2, 3 };
+    ASSERT_EQ(std::vector<uint8_t>(expected, expected + 3), flatten());
+}
+
+TEST_F(Test_managedBufferChain, appendRef_without_space)
+{
+    const uint8_t ref[] = { 1, 2, 3, 4 };
+
+    // a chain with no space at all, the references are its segments
+    for (size_t i = 0; i < kNumSegments; i++)
+    {
+        ASSERT_EQ(0, managedBufferChain_appendRef(&chain, ref, sizeof(ref)));
+    }
+    ASSERT_EQ(-1, managedBufferChain_appendRef(&chain, ref, sizeof(ref)));
+    ASSERT_EQ(kNumSegments, chain.usedSegments);
+    ASSERT_EQ(16u, managedBufferChain_getUsedLen(&chain));
+    ASSERT_EQ(0u, managedBufferChain_getFreeSpace(&chain));
+}
+
+TEST_F(Test_managedBufferChain, appendRef_no_segment_for_split)
+{
+    const uint8_t head[] = { 1 };
+    const uint8_t ref[] = { 2, 3 };
+    managedBuffer_t two[2];
+
+    managedBufferChain_init(&chain, two, 2);
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, head, sizeof(head)));
+
+    // the split needs two more segments, only one is left
+    ASSERT_EQ(-1, managedBufferChain_appendRef(&chain, ref, sizeof(ref)));
+    ASSERT_EQ(1u, chain.usedSegments);
+    ASSERT_EQ(1u, managedBufferChain_getUsedLen(&chain));
+    ASSERT_EQ(7u, managedBufferChain_getFreeSpace(&chain));
+}
+
+TEST_F(Test_managedBufferChain, getIovec_too_small)
+{
+    const uint8_t head[] = { 1 };
+    const uint8_t ref[] = { 2, 3 };
+    managedBuffer_iovec_t iov[3];
+
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space1, sizeof(space1)));
+    ASSERT_EQ(0, managedBufferChain_addSpace(&chain, space2, sizeof(space2)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, head, sizeof(head)));
+    ASSERT_EQ(0, managedBufferChain_appendRef(&chain, ref, sizeof(ref)));
+    ASSERT_EQ(0, managedBufferChain_append(&chain, head, sizeof(head)));
+
+    // 4 segments, the empty one is skipped
+    ASSERT_EQ(3, managedBufferChain_getIovec(&chain, iov, 3));
+    ASSERT_EQ(-1, managedBufferChain_getIovec(&chain, iov, 2));
+    ASSERT_EQ(space1, iov[0].base);
+    ASSERT_EQ(ref, iov[1].base);
+    ASSERT_EQ(2u, iov[1].len);
+}
+
+/*----------------------------------------------------------------------------*/
+class Test_managedBufferCursor : public testing::Test
+{
+protected:
+    uint8_t buffer[32];
+    managedBuffer_t mb;
+    managedBufferWriter_t writer;
+    managedBufferReader_t reader;
+
+    void SetUp() override
+    {
+        memset(buffer, 0xee, sizeof(buffer));
+        managedBuffer_init(&mb, buffer, sizeof(buffer));
+    }
+};
+
+TEST_F(Test_managedBufferCursor, round_trip)
+{
+    const uint8_t bytes[] = { 0xa1, 0xa2, 0xa3 };
+    uint8_t out[sizeof(bytes)];
+    uint64_t varint;
+
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, sizeof(buffer)));
+    managedBufferWriter_putU16BE(&writer, 0x0102);
+    managedBufferWriter_putU16LE(&writer, 0x0102);
+    managedBufferWriter_putU32BE(&writer, 0x01020304);
+    managedBufferWriter_putU32LE(&writer, 0x01020304);
+    managedBufferWriter_putU64BE(&writer, 0x0102030405060708);
+    managedBufferWriter_putVarint(&writer, 300);
+    managedBufferWriter_putBytes(&writer, bytes, sizeof(bytes));
+    managedBufferWriter_end(&writer);
+
+    // only the space written stays used
+    ASSERT_EQ(2u + 2 + 4 + 4 + 8 + 2 + 3, mb.usedLen);
+    ASSERT_EQ(0x01, buffer[0]);
+    ASSERT_EQ(0x02, buffer[1]);
+    ASSERT_EQ(0x02, buffer[2]);
+    ASSERT_EQ(0x01, buffer[3]);
+
+    managedBufferReader_init(&reader, &mb);
+    ASSERT_EQ(mb.usedLen, managedBufferReader_getRemaining(&reader));
+    ASSERT_EQ(0, managedBufferReader_require(&reader, 20));
+    ASSERT_EQ(0x0102, managedBufferReader_getU16BE(&reader));
+    ASSERT_EQ(0x0102, managedBufferReader_getU16LE(&reader));
+    ASSERT_EQ(0x01020304u, managedBufferReader_getU32BE(&reader));
+    ASSERT_EQ(0x01020304u, managedBufferReader_getU32LE(&reader));
+    ASSERT_EQ(0x0102030405060708u, managedBufferReader_getU64BE(&reader));
+    ASSERT_EQ(0, managedBufferReader_getVarint(&reader, &varint));
+    ASSERT_EQ(300u, varint);
+    ASSERT_EQ(0, managedBufferReader_require(&reader, sizeof(out)));
+    managedBufferReader_getBytes(&reader, out, sizeof(out));
+    ASSERT_EQ(0, memcmp(bytes, out, sizeof(out)));
+    ASSERT_EQ(0u, managedBufferReader_getRemaining(&reader));
+}
+
+TEST_F(Test_managedBufferCursor, round_trip_u64_le)
+{
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, 8));
+    managedBufferWriter_putU64LE(&writer, 0x0102030405060708);
+    managedBufferWriter_end(&writer);
+    ASSERT_EQ(0x08, buffer[0]);
+    ASSERT_EQ(0x01, buffer[7]);
+
+    managedBufferReader_init(&reader, &mb);
+    ASSERT_EQ(0x0102030405060708u, managedBufferReader_getU64LE(&reader));
+}
+
+TEST_F(Test_managedBufferCursor, write_past_the_end)
+{
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, 30));
+    managedBufferWriter_putU32BE(&writer, 1);
+    managedBufferWriter_end(&writer);
+    ASSERT_EQ(4u, mb.usedLen);
+
+    // the message does not fit, nothing is reserved and the cursor is empty
+    ASSERT_EQ(-1, managedBufferWriter_begin(&writer, &mb, 29));
+    ASSERT_EQ(writer.pos, writer.end);
+    ASSERT_EQ(&buffer[4], writer.pos);
+    ASSERT_EQ(4u, mb.usedLen);
+    managedBufferWriter_end(&writer);
+    ASSERT_EQ(4u, mb.usedLen);
+
+    // the space left can still be used
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, 28));
+    ASSERT_EQ(32u, mb.usedLen);
+    ASSERT_EQ(-1, managedBufferWriter_begin(&writer, &mb, 1));
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, 0));
+}
+
+TEST_F(Test_managedBufferCursor, read_past_the_end)
+{
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, 6));
+    managedBufferWriter_putU32BE(&writer, 0x01020304);
+    managedBufferWriter_putU16BE(&writer, 0x0506);
+    managedBufferWriter_end(&writer);
+
+    managedBufferReader_init(&reader, &mb);
+    ASSERT_EQ(-1, managedBufferReader_require(&reader, 7));
+    ASSERT_EQ(0, managedBufferReader_require(&reader, 6));
+    ASSERT_EQ(0x01020304u, managedBufferReader_getU32BE(&reader));
+
+    // a failed check does not move the cursor
+    ASSERT_EQ(-1, managedBufferReader_require(&reader, 4));
+    ASSERT_EQ(2u, managedBufferReader_getRemaining(&reader));
+    ASSERT_EQ(0x0506, managedBufferReader_getU16BE(&reader));
+    ASSERT_EQ(-1, managedBufferReader_require(&reader, 1));
+    ASSERT_EQ(0, managedBufferReader_require(&reader, 0));
+}
+
+TEST_F(Test_managedBufferCursor, truncated_varint)
+{
+    uint64_t varint = 42;
+
+    ASSERT_EQ(0, managedBufferWriter_begin(&writer, &mb, 1 + 9));
+    managedBufferWriter_putBytes(&writer, "\x07", 1);
+    managedBufferWriter_putVarint(&writer, UINT64_MAX);
+    managedBufferWriter_end(&writer);
+    ASSERT_EQ(10u, mb.usedLen);
+
+    // the varint is cut off by the end of the used part
+    mb.usedLen = 5;
+    managedBufferReader_init(&reader, &mb);
+    ASSERT_EQ(0, managedBufferReader_getVarint(&reader, &varint));
+    ASSERT_EQ(7u, varint);
+    ASSERT_EQ(-1, managedBufferReader_getVarint(&reader, &varint));
+    ASSERT_EQ(4u, managedBufferReader_getRemaining(&reader));
+    ASSERT_EQ(&buffer[1], reader.pos);
+
+    mb.usedLen = 10;
+    managedBufferReader_init(&reader, &mb);
+    ASSERT_EQ(0, managedBufferReader_getVarint(&reader, &varint));
+    ASSERT_EQ(0, managedBufferReader_getVarint(&reader, &varint));
+    ASSERT_EQ(UINT64_MAX, varint);
+    ASSERT_EQ(0u, managedBufferReader_getRemaining(&reader));
+}